@@ -0,0 +1,132 @@
+/**
+ * Accept-storm benchmark
+ * Opens connections as fast as possible against an enable_multi_accept()
+ * server and reports the sustained accept rate. With "pin", server workers
+ * are pinned to CPUs 0..N-1 and connections are steered to the worker on
+ * the CPU that received them; compare the cross-core rate with and without.
+ *
+ * Usage: accept_storm [port] [server_threads] [client_threads] [seconds] [pin]
+ */
+
+#include <coroute/net/io_context.hpp>
+#include <coroute/coro/task.hpp>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace coroute;
+using namespace coroute::net;
+
+static std::atomic<uint64_t> g_accepted{0};
+static std::atomic<uint64_t> g_connected{0};
+static std::atomic<uint64_t> g_failed{0};
+static std::atomic<bool> g_running{true};
+
+// Server side: write one byte and close, so the client sees EOF immediately
+Task<void> handle_connection(std::unique_ptr<Connection> conn) {
+    g_accepted.fetch_add(1, std::memory_order_relaxed);
+    co_await conn->async_write("x", 1);
+    conn->close();
+}
+
+// Client side: blocking connect / read / close loop
+void client_loop(uint16_t port) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+    char byte;
+    while (g_running.load(std::memory_order_relaxed)) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            g_failed.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+            g_connected.fetch_add(1, std::memory_order_relaxed);
+            (void)::read(fd, &byte, 1);
+        } else {
+            g_failed.fetch_add(1, std::memory_order_relaxed);
+        }
+        ::close(fd);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    uint16_t port = argc > 1 ? static_cast<uint16_t>(std::atoi(argv[1])) : 8090;
+    size_t server_threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 4;
+    size_t client_threads = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 32;
+    int seconds = argc > 4 ? std::atoi(argv[4]) : 10;
+    bool pin = argc > 5 && std::string(argv[5]) == "pin";
+
+    IoContextOptions options;
+    options.threads = server_threads;
+    if (pin) {
+        for (size_t i = 0; i < server_threads; ++i) {
+            options.cpu_affinity.push_back(static_cast<int>(i));
+        }
+    }
+    auto io_ctx = IoContext::create(options);
+    bool ok = io_ctx->enable_multi_accept(port, [](std::unique_ptr<Connection> conn) {
+        handle_connection(std::move(conn)).start_detached();
+    }, 4096);
+
+    if (!ok) {
+        std::cerr << "Failed to enable multi-accept on port " << port << std::endl;
+        return 1;
+    }
+
+    std::thread server([&] { io_ctx->run(); });
+    std::cout << io_ctx->features() << std::endl;
+
+    std::cout << "Accept storm: " << server_threads << " server threads, "
+              << client_threads << " client threads, " << seconds << "s" << std::endl;
+
+    std::vector<std::thread> clients;
+    for (size_t i = 0; i < client_threads; ++i) {
+        clients.emplace_back(client_loop, port);
+    }
+
+    uint64_t last = 0;
+    for (int s = 0; s < seconds; ++s) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        uint64_t now = g_accepted.load(std::memory_order_relaxed);
+        std::cout << "  [" << (s + 1) << "s] " << (now - last) << " accepts/sec" << std::endl;
+        last = now;
+    }
+
+    g_running = false;
+    for (auto& t : clients) {
+        t.join();
+    }
+
+    io_ctx->stop();
+    server.join();
+
+    uint64_t total = g_accepted.load();
+    std::cout << "Total accepted:  " << total << std::endl;
+    std::cout << "Client connects: " << g_connected.load()
+              << " (failed: " << g_failed.load() << ")" << std::endl;
+    std::cout << "Average:         " << (seconds > 0 ? total / seconds : 0) << " accepts/sec" << std::endl;
+
+    auto stats = io_ctx->ring_stats();
+    for (size_t i = 0; i < stats.size(); ++i) {
+        std::cout << "  ring " << i << ": " << stats[i].sqes_per_submit()
+                  << " SQEs/submit, " << (stats[i].cross_core_fraction() * 100.0)
+                  << "% of " << stats[i].accepts << " accepts cross-core" << std::endl;
+    }
+
+    return 0;
+}
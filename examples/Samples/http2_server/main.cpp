@@ -28,7 +28,7 @@ int main() {
         body += "\nHeaders:\n";
         
         for (const auto& [key, value] : req.headers()) {
-            body += "  " + key + ": " + value + "\n";
+            body += "  " + std::string(key) + ": " + std::string(value) + "\n";
         }
         
         co_return Response::ok(body);
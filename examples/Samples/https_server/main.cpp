@@ -32,11 +32,11 @@ int main(int argc, char* argv[]) {
     App app;
     
     // Enable TLS
-    app.enable_tls({
-        .cert_file = cert_file,
-        .key_file = key_file,
-        .alpn_protocols = {"http/1.1"}  // Advertise HTTP/1.1 via ALPN
-    });
+    AppTlsConfig tls_config;
+    tls_config.cert_file = cert_file;
+    tls_config.key_file = key_file;
+    tls_config.alpn_protocols = {"http/1.1"};  // Advertise HTTP/1.1 via ALPN
+    app.enable_tls(tls_config);
     
     // Routes
     app.get("/", [](Request&) -> Task<Response> {
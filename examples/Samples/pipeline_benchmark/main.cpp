@@ -0,0 +1,169 @@
+/**
+ * HTTP/1.1 pipelining benchmark
+ * Runs an App serving /plaintext and drives it from blocking client threads
+ * that each keep one connection open and send `depth` requests per write,
+ * waiting for all responses before the next batch (the shape of
+ * `wrk --pipeline <depth>`). Runs depth 1 first as the baseline, then the
+ * requested depth, and reports requests/sec for both.
+ *
+ * Usage: pipeline_benchmark [port] [server_threads] [client_threads] [seconds] [depth]
+ */
+
+#include <coroute/core/app.hpp>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace coroute;
+
+static std::atomic<uint64_t> g_responses{0};
+static std::atomic<bool> g_running{true};
+
+static int connect_to(uint16_t port) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+// Count complete responses at the front of `data` and drop them
+static size_t consume_responses(std::string& data) {
+    size_t count = 0;
+    size_t pos = 0;
+    while (true) {
+        size_t head_end = data.find("\r\n\r\n", pos);
+        if (head_end == std::string::npos) {
+            break;
+        }
+        std::string_view head(data.data() + pos, head_end - pos);
+        size_t length = 0;
+        if (auto cl = head.find("Content-Length: "); cl != std::string_view::npos) {
+            length = std::strtoul(head.data() + cl + 16, nullptr, 10);
+        }
+        if (data.size() < head_end + 4 + length) {
+            break;
+        }
+        pos = head_end + 4 + length;
+        ++count;
+    }
+    data.erase(0, pos);
+    return count;
+}
+
+// One connection, `depth` requests per write; reconnects when the server
+// closes after its per-connection request limit
+static void client_loop(uint16_t port, size_t depth) {
+    std::string batch;
+    for (size_t i = 0; i < depth; ++i) {
+        batch += "GET /plaintext HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    }
+
+    std::string pending;
+    char buffer[65536];
+    int fd = -1;
+    while (g_running.load(std::memory_order_relaxed)) {
+        if (fd < 0 && (fd = connect_to(port)) < 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        if (::write(fd, batch.data(), batch.size()) != static_cast<ssize_t>(batch.size())) {
+            ::close(fd);
+            fd = -1;
+            continue;
+        }
+
+        pending.clear();
+        size_t received = 0;
+        while (received < depth) {
+            ssize_t n = ::read(fd, buffer, sizeof(buffer));
+            if (n <= 0) {
+                break;
+            }
+            pending.append(buffer, static_cast<size_t>(n));
+            received += consume_responses(pending);
+        }
+        g_responses.fetch_add(received, std::memory_order_relaxed);
+        if (received < depth) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+static double measure(uint16_t port, size_t client_threads, int seconds, size_t depth) {
+    g_responses = 0;
+    g_running = true;
+
+    std::vector<std::thread> clients;
+    for (size_t i = 0; i < client_threads; ++i) {
+        clients.emplace_back(client_loop, port, depth);
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    uint64_t total = g_responses.load();
+    g_running = false;
+    for (auto& t : clients) {
+        t.join();
+    }
+
+    double rate = seconds > 0 ? static_cast<double>(total) / seconds : 0.0;
+    std::cout << "  depth " << depth << ": " << static_cast<uint64_t>(rate) << " req/s" << std::endl;
+    return rate;
+}
+
+int main(int argc, char* argv[]) {
+    uint16_t port = argc > 1 ? static_cast<uint16_t>(std::atoi(argv[1])) : 8091;
+    size_t server_threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2;
+    size_t client_threads = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 16;
+    int seconds = argc > 4 ? std::atoi(argv[4]) : 5;
+    size_t depth = argc > 5 ? std::strtoul(argv[5], nullptr, 10) : 16;
+
+    App app;
+    app.threads(server_threads);
+    app.get("/plaintext", [](Request&) -> Task<Response> {
+        co_return Response::ok("Hello, World!");
+    });
+
+    std::thread server([&] { app.run(port); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    std::cout << "Pipelining: " << server_threads << " server threads, " << client_threads
+              << " connections, " << seconds << "s per run" << std::endl;
+
+    double baseline = measure(port, client_threads, seconds, 1);
+    double pipelined = depth > 1 ? measure(port, client_threads, seconds, depth) : baseline;
+    if (baseline > 0) {
+        std::cout << "Speedup at depth " << depth << ": " << pipelined / baseline << "x" << std::endl;
+    }
+
+    app.stop();
+    server.join();
+    return 0;
+}
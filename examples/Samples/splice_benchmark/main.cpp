@@ -0,0 +1,224 @@
+/**
+ * File transmission benchmark
+ * Streams a mix of page-cached and cold (evicted) large files over
+ * async_transmit_file() while a separate client measures the latency of tiny
+ * requests served by the same ring. With blocking file I/O on the ring
+ * thread, cold reads show up directly in the small-request p99.
+ *
+ * Usage: splice_benchmark [port] [file_mb] [files] [large_clients] [seconds] [dir]
+ */
+
+#include <coroute/net/io_context.hpp>
+#include <coroute/coro/task.hpp>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace coroute;
+using namespace coroute::net;
+
+struct BenchFile {
+    std::string path;
+    int fd = -1;
+    bool cold = false;  // Evicted from the page cache before every send
+};
+
+static std::vector<BenchFile> g_files;
+static size_t g_file_size = 0;
+static std::atomic<size_t> g_next_file{0};
+static std::atomic<uint64_t> g_bytes{0};
+static std::atomic<bool> g_running{true};
+
+// Commands: 'F' = send the next large file, 'S' = send a 16-byte reply
+Task<void> handle_connection(std::unique_ptr<Connection> conn) {
+    char cmd;
+    while (true) {
+        auto r = co_await conn->async_read(&cmd, 1);
+        if (!r || *r == 0) {
+            break;
+        }
+        if (cmd == 'S') {
+            if (!co_await conn->async_write_all("0123456789abcdef", 16)) {
+                break;
+            }
+        } else if (cmd == 'F') {
+            auto& file = g_files[g_next_file.fetch_add(1) % g_files.size()];
+            if (file.cold) {
+                posix_fadvise(file.fd, 0, 0, POSIX_FADV_DONTNEED);
+            }
+            auto sent = co_await conn->async_transmit_file(file.fd, 0, g_file_size);
+            if (!sent) {
+                break;
+            }
+        }
+    }
+    conn->close();
+}
+
+static int connect_to(uint16_t port) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    int opt = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+    return fd;
+}
+
+static bool read_exact(int fd, char* buf, size_t len, size_t buf_size) {
+    size_t got = 0;
+    while (got < len) {
+        ssize_t n = ::read(fd, buf, std::min(buf_size, len - got));
+        if (n <= 0) {
+            return false;
+        }
+        got += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+void large_client(uint16_t port) {
+    int fd = connect_to(port);
+    if (fd < 0) {
+        return;
+    }
+    std::vector<char> buf(1 << 20);
+    while (g_running.load(std::memory_order_relaxed)) {
+        if (::write(fd, "F", 1) != 1 || !read_exact(fd, buf.data(), g_file_size, buf.size())) {
+            break;
+        }
+        g_bytes.fetch_add(g_file_size, std::memory_order_relaxed);
+    }
+    ::close(fd);
+}
+
+void latency_client(uint16_t port, std::vector<double>& samples_us) {
+    int fd = connect_to(port);
+    if (fd < 0) {
+        return;
+    }
+    char buf[16];
+    while (g_running.load(std::memory_order_relaxed)) {
+        auto start = std::chrono::steady_clock::now();
+        if (::write(fd, "S", 1) != 1 || !read_exact(fd, buf, sizeof(buf), sizeof(buf))) {
+            break;
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        samples_us.push_back(std::chrono::duration<double, std::micro>(elapsed).count());
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    ::close(fd);
+}
+
+static double percentile(std::vector<double>& v, double p) {
+    if (v.empty()) {
+        return 0.0;
+    }
+    auto idx = static_cast<size_t>(p * static_cast<double>(v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(idx), v.end());
+    return v[idx];
+}
+
+int main(int argc, char* argv[]) {
+    uint16_t port = argc > 1 ? static_cast<uint16_t>(std::atoi(argv[1])) : 8091;
+    size_t file_mb = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64;
+    size_t file_count = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 4;
+    size_t large_clients = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 4;
+    int seconds = argc > 5 ? std::atoi(argv[5]) : 10;
+    std::string dir = argc > 6 ? argv[6] : "/tmp";
+
+    // Half of the files are evicted before each send, half stay cached
+    g_file_size = file_mb << 20;
+    std::vector<char> block(1 << 20);
+    for (size_t i = 0; i < block.size(); ++i) {
+        block[i] = static_cast<char>('a' + i % 26);
+    }
+    for (size_t i = 0; i < file_count; ++i) {
+        BenchFile file;
+        file.path = dir + "/splice_bench_" + std::to_string(i) + ".bin";
+        file.cold = (i % 2) == 1;
+        int out = ::open(file.path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (out < 0) {
+            std::cerr << "Cannot create " << file.path << std::endl;
+            return 1;
+        }
+        for (size_t mb = 0; mb < file_mb; ++mb) {
+            if (::write(out, block.data(), block.size()) < 0) {
+                break;
+            }
+        }
+        fsync(out);
+        ::close(out);
+        file.fd = ::open(file.path.c_str(), O_RDONLY);
+        g_files.push_back(file);
+    }
+
+    // One ring, so the small requests share it with the file transfers
+    auto io_ctx = IoContext::create(1);
+    bool ok = io_ctx->enable_multi_accept(port, [](std::unique_ptr<Connection> conn) {
+        handle_connection(std::move(conn)).start_detached();
+    });
+    if (!ok) {
+        std::cerr << "Failed to enable multi-accept on port " << port << std::endl;
+        return 1;
+    }
+
+    std::thread server([&] { io_ctx->run(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    std::cout << "File transmission: " << file_count << " x " << file_mb << " MB ("
+              << (file_count / 2) << " cold), " << large_clients << " large clients, "
+              << seconds << "s" << std::endl;
+
+    std::vector<double> samples;
+    std::thread probe(latency_client, port, std::ref(samples));
+    std::vector<std::thread> clients;
+    for (size_t i = 0; i < large_clients; ++i) {
+        clients.emplace_back(large_client, port);
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    g_running = false;
+    for (auto& t : clients) {
+        t.join();
+    }
+    probe.join();
+
+    io_ctx->stop();
+    server.join();
+
+    double mb_per_sec = seconds > 0
+        ? static_cast<double>(g_bytes.load()) / (1 << 20) / seconds : 0.0;
+    std::cout << "Large transfers: " << mb_per_sec << " MB/s" << std::endl;
+    std::cout << "Small requests:  " << samples.size() << " samples, p50 "
+              << percentile(samples, 0.50) << " us, p99 " << percentile(samples, 0.99)
+              << " us, max " << percentile(samples, 1.0) << " us" << std::endl;
+
+    for (auto& file : g_files) {
+        ::close(file.fd);
+        ::unlink(file.path.c_str());
+    }
+    return 0;
+}
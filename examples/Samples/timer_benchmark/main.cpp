@@ -0,0 +1,134 @@
+/**
+ * Timer benchmark
+ * Compares IoContext::schedule() on the per-ring timer wheel against the
+ * previous thread-per-call implementation, and measures raw wheel
+ * insert/cancel throughput.
+ *
+ * Usage: timer_benchmark [timers] [threaded_timers]
+ */
+
+#include <coroute/net/io_context.hpp>
+#include <coroute/util/timer_wheel.hpp>
+#include <coroute/coro/task.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace coroute;
+using namespace coroute::net;
+using Clock = std::chrono::steady_clock;
+
+// How late callbacks ran relative to their deadline
+struct Lateness {
+    std::atomic<uint64_t> fired{0};
+    std::atomic<int64_t> total_us{0};
+    std::atomic<int64_t> max_us{0};
+
+    void record(Clock::time_point deadline) {
+        auto late = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - deadline).count();
+        total_us.fetch_add(late, std::memory_order_relaxed);
+        int64_t prev = max_us.load(std::memory_order_relaxed);
+        while (late > prev && !max_us.compare_exchange_weak(prev, late)) {}
+        fired.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+static void report(const char* name, size_t count, Clock::duration arm_time, Lateness& late) {
+    auto arm_us = std::chrono::duration_cast<std::chrono::microseconds>(arm_time).count();
+    uint64_t fired = late.fired.load();
+    std::cout << name << ": " << count << " timers armed in " << arm_us << " us, "
+              << fired << " fired, avg lateness "
+              << (fired ? late.total_us.load() / static_cast<int64_t>(fired) : 0)
+              << " us, max " << late.max_us.load() << " us" << std::endl;
+}
+
+// Timer wheel path: schedule() from a worker thread
+static void bench_wheel(size_t count) {
+    auto ctx = IoContext::create(1);
+    Lateness late;
+    Clock::duration arm_time{};
+
+    ctx->post([&] {
+        auto start = Clock::now();
+        for (size_t i = 0; i < count; ++i) {
+            auto delay = std::chrono::milliseconds(100 + (i % 900));
+            auto deadline = Clock::now() + delay;
+            ctx->schedule(delay, [&late, deadline] { late.record(deadline); });
+        }
+        arm_time = Clock::now() - start;
+    });
+
+    std::thread runner([&] { ctx->run(); });
+    while (late.fired.load() < count) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ctx->stop();
+    runner.join();
+
+    report("timer wheel   ", count, arm_time, late);
+}
+
+// Previous implementation: one sleeping thread per scheduled callback
+static void bench_thread_per_call(size_t count) {
+    auto ctx = IoContext::create(1);
+    Lateness late;
+    std::thread runner([&] { ctx->run(); });
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        auto delay = std::chrono::milliseconds(100 + (i % 900));
+        auto deadline = Clock::now() + delay;
+        std::thread([&ctx, &late, delay, deadline] {
+            std::this_thread::sleep_for(delay);
+            ctx->post([&late, deadline] { late.record(deadline); });
+        }).detach();
+    }
+    auto arm_time = Clock::now() - start;
+
+    while (late.fired.load() < count) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ctx->stop();
+    runner.join();
+
+    report("thread-per-call", count, arm_time, late);
+}
+
+// Raw data structure cost: insert + cancel
+static void bench_wheel_ops(size_t count) {
+    TimerWheel wheel;
+    auto entries = std::make_unique<TimerEntry[]>(count);
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        wheel.schedule(entries[i], 1 + (i * 7919) % 3600000);
+    }
+    auto armed = Clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        wheel.cancel(entries[i]);
+    }
+    auto cancelled = Clock::now();
+
+    auto ns = [](Clock::duration d, size_t n) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count() / static_cast<double>(n);
+    };
+    std::cout << "wheel ops      : " << count << " timers, "
+              << ns(armed - start, count) << " ns/insert, "
+              << ns(cancelled - armed, count) << " ns/cancel" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t timers = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    size_t threaded = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2000;
+
+    bench_wheel_ops(timers * 10);
+    bench_wheel(timers);
+    bench_thread_per_call(threaded);
+
+    return 0;
+}
@@ -0,0 +1,202 @@
+/**
+ * TLS handshake benchmark
+ * Serves TLS on per-ring SO_REUSEPORT listeners, handshaking each connection
+ * in its own coroutine, and drives it with blocking OpenSSL clients that do
+ * a full (non-resumed) handshake per connection. Reports handshakes per
+ * second at 1, 4 and 16 server threads; the rate should scale with cores
+ * until the clients become the bottleneck.
+ *
+ * Usage: tls_handshake_benchmark [client_threads] [seconds]
+ */
+
+#include <coroute/net/io_context.hpp>
+#include <coroute/net/endpoint.hpp>
+#include <coroute/net/tls.hpp>
+#include <coroute/coro/task.hpp>
+
+#include <openssl/ssl.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace coroute;
+using namespace coroute::net;
+
+static std::atomic<uint64_t> g_handshakes{0};
+static std::atomic<uint64_t> g_failed{0};
+
+// Write a throwaway self-signed P-256 certificate and key
+static bool write_self_signed(const std::filesystem::path& cert_path,
+                              const std::filesystem::path& key_path) {
+    EVP_PKEY* key = nullptr;
+    EVP_PKEY_CTX* kctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+    if (!kctx || EVP_PKEY_keygen_init(kctx) <= 0 ||
+        EVP_PKEY_CTX_set_ec_paramgen_curve_nid(kctx, NID_X9_62_prime256v1) <= 0 ||
+        EVP_PKEY_keygen(kctx, &key) <= 0) {
+        EVP_PKEY_CTX_free(kctx);
+        return false;
+    }
+    EVP_PKEY_CTX_free(kctx);
+    X509* cert = X509_new();
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 24 * 3600);
+    X509_set_pubkey(cert, key);
+    X509_NAME* name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                               reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    bool ok = X509_sign(cert, key, EVP_sha256()) > 0;
+
+    FILE* f = ok ? std::fopen(cert_path.c_str(), "w") : nullptr;
+    ok = f && PEM_write_X509(f, cert) == 1;
+    if (f) {
+        std::fclose(f);
+    }
+    f = ok ? std::fopen(key_path.c_str(), "w") : nullptr;
+    ok = f && PEM_write_PrivateKey(f, key, nullptr, nullptr, 0, nullptr, nullptr) == 1;
+    if (f) {
+        std::fclose(f);
+    }
+
+    X509_free(cert);
+    EVP_PKEY_free(key);
+    return ok;
+}
+
+// Server side: handshake, then close (the client only measures the handshake)
+Task<void> serve(std::unique_ptr<Connection> conn, TlsContext& tls_ctx) {
+    auto tls = TlsConnection::create(std::move(conn), tls_ctx);
+    if (!tls) {
+        g_failed.fetch_add(1, std::memory_order_relaxed);
+        co_return;
+    }
+    auto result = co_await (*tls)->handshake(std::chrono::seconds(5));
+    if (result) {
+        g_handshakes.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        g_failed.fetch_add(1, std::memory_order_relaxed);
+    }
+    (*tls)->close();
+}
+
+// Client side: connect, full handshake, disconnect, repeat
+static void client_loop(uint16_t port, std::atomic<bool>& stop) {
+    SSL_CTX* ctx = SSL_CTX_new(TLS_client_method());
+    SSL_CTX_set_verify(ctx, SSL_VERIFY_NONE, nullptr);
+    // Every connection pays for a full handshake
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+    while (!stop.load(std::memory_order_relaxed)) {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) {
+            continue;
+        }
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+            SSL* ssl = SSL_new(ctx);
+            SSL_set_fd(ssl, fd);
+            if (SSL_connect(ssl) == 1) {
+                SSL_shutdown(ssl);
+            }
+            SSL_free(ssl);
+        }
+        ::close(fd);
+    }
+    SSL_CTX_free(ctx);
+}
+
+static double run(size_t server_threads, size_t client_threads, double seconds,
+                  TlsContext& tls_ctx) {
+    IoContextOptions options;
+    options.threads = server_threads;
+    auto io_ctx = IoContext::create(options);
+    bool ok = io_ctx->enable_multi_accept(Endpoint::ipv4("127.0.0.1", 0),
+        [&tls_ctx](std::unique_ptr<Connection> conn) {
+            serve(std::move(conn), tls_ctx).start_detached();
+        }, 4096);
+    if (!ok) {
+        std::cerr << "Failed to enable multi-accept" << std::endl;
+        return 0;
+    }
+    uint16_t port = io_ctx->multi_accept_endpoint().port();
+    std::thread server([&] { io_ctx->run(); });
+
+    g_handshakes = 0;
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> clients;
+    for (size_t i = 0; i < client_threads; ++i) {
+        clients.emplace_back(client_loop, port, std::ref(stop));
+    }
+
+    // Skip connection setup noise before measuring
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    uint64_t before = g_handshakes.load();
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    uint64_t done = g_handshakes.load() - before;
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    stop = true;
+    for (auto& t : clients) {
+        t.join();
+    }
+    io_ctx->stop();
+    server.join();
+    return static_cast<double>(done) / elapsed;
+}
+
+int main(int argc, char* argv[]) {
+    size_t client_threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 32;
+    double seconds = argc > 2 ? std::atof(argv[2]) : 5.0;
+
+    auto dir = std::filesystem::temp_directory_path();
+    auto cert = dir / ("coroute_bench_" + std::to_string(::getpid()) + ".crt");
+    auto key = dir / ("coroute_bench_" + std::to_string(::getpid()) + ".key");
+    if (!write_self_signed(cert, key)) {
+        std::cerr << "Failed to generate a certificate" << std::endl;
+        return 1;
+    }
+
+    TlsConfig config;
+    config.cert_file = cert;
+    config.key_file = key;
+    auto tls_ctx = TlsContext::create(config);
+    std::filesystem::remove(cert);
+    std::filesystem::remove(key);
+    if (!tls_ctx) {
+        std::cerr << "TLS context: " << tls_ctx.error().to_string() << std::endl;
+        return 1;
+    }
+
+    std::cout << "TLS handshakes, " << client_threads << " client threads, "
+              << seconds << "s per run" << std::endl;
+    for (size_t threads : {1, 4, 16}) {
+        double rate = run(threads, client_threads, seconds, *tls_ctx);
+        std::cout << std::setw(3) << threads << " server threads: " << std::fixed
+                  << std::setprecision(0) << std::setw(8) << rate << " handshakes/s" << std::endl;
+    }
+    std::cout << "Failed handshakes: " << g_failed.load() << std::endl;
+    return 0;
+}
@@ -0,0 +1,247 @@
+/**
+ * TLS throughput benchmark
+ * Streams bulk data over TLS on loopback in both directions and reports
+ * MB/s together with the server thread's CPU time per GB moved, which is
+ * what record buffering and copies cost. Run it on two builds to compare
+ * record I/O changes; "ktls" switches the server to kernel TLS.
+ *
+ * Usage: tls_throughput_benchmark [seconds] [write_size] [ktls]
+ */
+
+#include <coroute/net/io_context.hpp>
+#include <coroute/net/endpoint.hpp>
+#include <coroute/net/tls.hpp>
+#include <coroute/coro/task.hpp>
+
+#include <openssl/ssl.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace coroute;
+using namespace coroute::net;
+
+static std::atomic<uint64_t> g_bytes{0};
+static std::atomic<bool> g_stop{false};
+static size_t g_write_size = 64 * 1024;
+
+// Write a throwaway self-signed P-256 certificate and key
+static bool write_self_signed(const std::filesystem::path& cert_path,
+                              const std::filesystem::path& key_path) {
+    EVP_PKEY* key = nullptr;
+    EVP_PKEY_CTX* kctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+    if (!kctx || EVP_PKEY_keygen_init(kctx) <= 0 ||
+        EVP_PKEY_CTX_set_ec_paramgen_curve_nid(kctx, NID_X9_62_prime256v1) <= 0 ||
+        EVP_PKEY_keygen(kctx, &key) <= 0) {
+        EVP_PKEY_CTX_free(kctx);
+        return false;
+    }
+    EVP_PKEY_CTX_free(kctx);
+    X509* cert = X509_new();
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 24 * 3600);
+    X509_set_pubkey(cert, key);
+    X509_NAME* name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                               reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    bool ok = X509_sign(cert, key, EVP_sha256()) > 0;
+
+    FILE* f = ok ? std::fopen(cert_path.c_str(), "w") : nullptr;
+    ok = f && PEM_write_X509(f, cert) == 1;
+    if (f) {
+        std::fclose(f);
+    }
+    f = ok ? std::fopen(key_path.c_str(), "w") : nullptr;
+    ok = f && PEM_write_PrivateKey(f, key, nullptr, nullptr, 0, nullptr, nullptr) == 1;
+    if (f) {
+        std::fclose(f);
+    }
+
+    X509_free(cert);
+    EVP_PKEY_free(key);
+    return ok;
+}
+
+// Server side. The client's first byte picks the direction: 'd' streams
+// to the client until it disconnects, 'u' reads until EOF.
+Task<void> serve(std::unique_ptr<Connection> conn, TlsContext& tls_ctx) {
+    auto created = TlsConnection::create(std::move(conn), tls_ctx);
+    if (!created) {
+        co_return;
+    }
+    auto& tls = *created;
+    if (!co_await tls->handshake(std::chrono::seconds(5))) {
+        co_return;
+    }
+
+    char mode = 0;
+    auto first = co_await tls->async_read(&mode, 1);
+    if (!first || *first == 0) {
+        co_return;
+    }
+
+    std::vector<char> buf(g_write_size, 'x');
+    if (mode == 'd') {
+        while (true) {
+            auto r = co_await tls->async_write_all(buf.data(), buf.size());
+            if (!r) {
+                break;
+            }
+            g_bytes.fetch_add(*r, std::memory_order_relaxed);
+        }
+    } else {
+        while (true) {
+            auto r = co_await tls->async_read(buf.data(), buf.size());
+            if (!r || *r == 0) {
+                break;
+            }
+            g_bytes.fetch_add(*r, std::memory_order_relaxed);
+        }
+    }
+    tls->close();
+}
+
+// Client side: blocking OpenSSL socket
+static void client(uint16_t port, char mode) {
+    SSL_CTX* ctx = SSL_CTX_new(TLS_client_method());
+    SSL_CTX_set_verify(ctx, SSL_VERIFY_NONE, nullptr);
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        std::cerr << "connect failed" << std::endl;
+        ::close(fd);
+        SSL_CTX_free(ctx);
+        return;
+    }
+
+    SSL* ssl = SSL_new(ctx);
+    SSL_set_fd(ssl, fd);
+    if (SSL_connect(ssl) == 1 && SSL_write(ssl, &mode, 1) == 1) {
+        std::vector<char> buf(g_write_size, 'y');
+        while (!g_stop.load(std::memory_order_relaxed)) {
+            int n = mode == 'd' ? SSL_read(ssl, buf.data(), static_cast<int>(buf.size()))
+                                : SSL_write(ssl, buf.data(), static_cast<int>(buf.size()));
+            if (n <= 0) {
+                break;
+            }
+        }
+    }
+    SSL_free(ssl);
+    ::close(fd);
+    SSL_CTX_free(ctx);
+}
+
+static double thread_cpu_seconds(clockid_t clock) {
+    timespec ts{};
+    clock_gettime(clock, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+}
+
+static void run(const char* label, char mode, double seconds, TlsContext& tls_ctx) {
+    auto io_ctx = IoContext::create(1);
+    auto listener = Listener::create(*io_ctx);
+    if (auto r = listener->listen(Endpoint::ipv4("127.0.0.1", 0)); !r) {
+        std::cerr << "listen failed: " << r.error().to_string() << std::endl;
+        return;
+    }
+    uint16_t port = listener->local_endpoint().port();
+
+    io_ctx->post([&] {
+        [](Listener& l, TlsContext& ctx) -> Task<void> {
+            while (l.is_listening()) {
+                auto conn = co_await l.async_accept();
+                if (!conn) {
+                    break;
+                }
+                serve(std::move(*conn), ctx).start_detached();
+            }
+        }(*listener, tls_ctx).start_detached();
+    });
+    std::thread server([&] { io_ctx->run(); });
+    clockid_t server_clock;
+    pthread_getcpuclockid(server.native_handle(), &server_clock);
+
+    g_bytes = 0;
+    g_stop = false;
+    std::thread peer(client, port, mode);
+
+    // Let the handshake and TCP window settle before measuring
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    uint64_t bytes_before = g_bytes.load();
+    double cpu_before = thread_cpu_seconds(server_clock);
+    auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    uint64_t bytes = g_bytes.load() - bytes_before;
+    double cpu = thread_cpu_seconds(server_clock) - cpu_before;
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    g_stop = true;
+    peer.join();
+    listener->close();
+    io_ctx->stop();
+    server.join();
+
+    double gb = static_cast<double>(bytes) / 1e9;
+    std::cout << std::left << std::setw(10) << label << std::right << std::fixed
+              << std::setprecision(1) << std::setw(9) << (static_cast<double>(bytes) / elapsed / 1e6)
+              << " MB/s  " << std::setprecision(3) << std::setw(7) << (gb > 0 ? cpu / gb : 0.0)
+              << " server CPU s/GB" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    double seconds = argc > 1 ? std::atof(argv[1]) : 5.0;
+    g_write_size = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 64 * 1024;
+    bool ktls = argc > 3 && std::string(argv[3]) == "ktls";
+
+    auto dir = std::filesystem::temp_directory_path();
+    auto cert = dir / ("coroute_bench_" + std::to_string(::getpid()) + ".crt");
+    auto key = dir / ("coroute_bench_" + std::to_string(::getpid()) + ".key");
+    if (!write_self_signed(cert, key)) {
+        std::cerr << "Failed to generate a certificate" << std::endl;
+        return 1;
+    }
+
+    TlsConfig config;
+    config.cert_file = cert;
+    config.key_file = key;
+    config.kernel_tls = ktls;
+    auto tls_ctx = TlsContext::create(config);
+    std::filesystem::remove(cert);
+    std::filesystem::remove(key);
+    if (!tls_ctx) {
+        std::cerr << "TLS context: " << tls_ctx.error().to_string() << std::endl;
+        return 1;
+    }
+
+    std::cout << "TLS " << (ktls ? "(kernel TLS requested), " : "") << g_write_size
+              << "-byte writes, " << seconds << "s per run" << std::endl;
+    run("download", 'd', seconds, *tls_ctx);
+    run("upload", 'u', seconds, *tls_ctx);
+    return 0;
+}
@@ -0,0 +1,199 @@
+/**
+ * Loopback TCP vs Unix domain socket benchmark
+ * Runs the same server over 127.0.0.1 and over a Unix socket and drives it
+ * with blocking clients, reporting small request/response round trips per
+ * second (the local sidecar proxy case) and bulk transfer throughput.
+ *
+ * Usage: uds_benchmark [clients] [seconds] [socket-path]
+ *        Use a path starting with '@' for the abstract namespace.
+ */
+
+#include <coroute/net/io_context.hpp>
+#include <coroute/net/endpoint.hpp>
+#include <coroute/coro/task.hpp>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace coroute;
+using namespace coroute::net;
+
+static constexpr uint32_t SMALL_RESPONSE = 512;
+static constexpr uint32_t BULK_RESPONSE = 1 << 20;
+
+static std::vector<char> g_body(BULK_RESPONSE, 'u');
+
+Task<bool> read_exact(Connection& conn, void* buf, size_t len) {
+    size_t got = 0;
+    while (got < len) {
+        auto r = co_await conn.async_read(static_cast<char*>(buf) + got, len - got);
+        if (!r || *r == 0) {
+            co_return false;
+        }
+        got += *r;
+    }
+    co_return true;
+}
+
+// Request: 4-byte response size. Reply: that many bytes.
+Task<void> serve(std::unique_ptr<Connection> conn) {
+    uint32_t size = 0;
+    while (co_await read_exact(*conn, &size, sizeof(size)) && size > 0 && size <= BULK_RESPONSE) {
+        if (!co_await conn->async_write_all(g_body.data(), size)) {
+            break;
+        }
+    }
+    conn->close();
+}
+
+static bool read_all(int fd, char* buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = ::read(fd, buf, len);
+        if (n <= 0) {
+            return false;
+        }
+        buf += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+static int connect_to(const Endpoint& endpoint) {
+    auto addr = endpoint.to_sockaddr();
+    if (!addr) {
+        return -1;
+    }
+    int fd = ::socket(addr->domain, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (::connect(fd, static_cast<const sockaddr*>(addr->data()), addr->size) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    if (addr->domain != AF_UNIX) {
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    return fd;
+}
+
+struct RunResult {
+    uint64_t requests = 0;
+    uint64_t bytes = 0;
+    double seconds = 0;
+};
+
+static RunResult drive(const Endpoint& endpoint, uint32_t response_size, size_t clients, double seconds) {
+    std::atomic<uint64_t> requests{0};
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < clients; ++i) {
+        threads.emplace_back([&] {
+            int fd = connect_to(endpoint);
+            if (fd < 0) {
+                return;
+            }
+            std::vector<char> buf(response_size);
+            uint64_t done = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (::write(fd, &response_size, sizeof(response_size)) != sizeof(response_size) ||
+                    !read_all(fd, buf.data(), buf.size())) {
+                    break;
+                }
+                ++done;
+            }
+            uint32_t end = 0;
+            (void)::write(fd, &end, sizeof(end));
+            ::close(fd);
+            requests.fetch_add(done, std::memory_order_relaxed);
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop = true;
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    RunResult result;
+    result.requests = requests.load();
+    result.bytes = result.requests * response_size;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+static void report(const char* transport, const char* pattern, const RunResult& r) {
+    std::cout << std::left << std::setw(10) << transport << std::setw(12) << pattern << std::right
+              << std::setw(12) << std::fixed << std::setprecision(0)
+              << (static_cast<double>(r.requests) / r.seconds) << " req/s  " << std::setw(9)
+              << std::setprecision(1) << (static_cast<double>(r.bytes) / r.seconds / 1e6)
+              << " MB/s" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t clients = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 4;
+    double seconds = argc > 2 ? std::atof(argv[2]) : 5.0;
+    std::string path = argc > 3 ? argv[3] : "/tmp/coroute_uds_benchmark.sock";
+
+    Endpoint tcp = Endpoint::ipv4("127.0.0.1", 0);
+    Endpoint uds = path.front() == '@' ? Endpoint::abstract_socket(path.substr(1))
+                                       : Endpoint::unix_socket(path);
+
+    auto ctx = IoContext::create(1);
+    auto tcp_listener = Listener::create(*ctx);
+    auto uds_listener = Listener::create(*ctx);
+    if (auto r = tcp_listener->listen(tcp, 1024); !r) {
+        std::cerr << "TCP listen failed: " << r.error().to_string() << std::endl;
+        return 1;
+    }
+    if (auto r = uds_listener->listen(uds, 1024); !r) {
+        std::cerr << "Unix socket listen failed: " << r.error().to_string() << std::endl;
+        return 1;
+    }
+    tcp = tcp_listener->local_endpoint();
+
+    auto accept_loop = [](Listener& listener) -> Task<void> {
+        while (listener.is_listening()) {
+            auto conn = co_await listener.async_accept();
+            if (!conn) {
+                break;
+            }
+            serve(std::move(*conn)).start_detached();
+        }
+    };
+    ctx->post([&] {
+        accept_loop(*tcp_listener).start_detached();
+        accept_loop(*uds_listener).start_detached();
+    });
+    std::thread server([&] { ctx->run(); });
+
+    std::cout << "Server: " << ctx->features() << std::endl;
+    std::cout << "TCP " << tcp.to_string() << " vs " << uds.to_string() << ", " << clients
+              << " clients, " << seconds << "s per run" << std::endl;
+
+    report("tcp", "512B rr", drive(tcp, SMALL_RESPONSE, clients, seconds));
+    report("unix", "512B rr", drive(uds, SMALL_RESPONSE, clients, seconds));
+    report("tcp", "1MiB bulk", drive(tcp, BULK_RESPONSE, clients, seconds));
+    report("unix", "1MiB bulk", drive(uds, BULK_RESPONSE, clients, seconds));
+
+    tcp_listener->close();
+    uds_listener->close();
+    ctx->stop();
+    server.join();
+    return 0;
+}
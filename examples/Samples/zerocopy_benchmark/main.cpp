@@ -0,0 +1,189 @@
+/**
+ * Zero-copy send benchmark
+ * Sweeps write sizes and compares regular sends against IORING_OP_SEND_ZC,
+ * reporting throughput and the server worker's CPU time per KiB. The size
+ * where zero-copy starts costing less CPU per byte is the crossover to use
+ * for IoContextOptions::zerocopy_send_threshold.
+ *
+ * Loopback traffic is copied by the kernel even with SEND_ZC, so for real
+ * numbers run the server and client on different hosts:
+ *
+ * Usage: zerocopy_benchmark                     (both sides locally)
+ *        zerocopy_benchmark server [port]       (copy on port, zero-copy on port+1)
+ *        zerocopy_benchmark client <host> [port]
+ */
+
+#include <coroute/net/io_context.hpp>
+#include <coroute/coro/task.hpp>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace coroute;
+using namespace coroute::net;
+
+static constexpr size_t SIZES[] = {4096, 16384, 65536, 262144, 1048576, 4194304};
+static constexpr size_t BYTES_PER_RUN = size_t(1) << 30;
+
+static std::vector<char> g_body;
+
+static uint64_t thread_cpu_ns() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+Task<bool> read_exact(Connection& conn, void* buf, size_t len) {
+    size_t got = 0;
+    while (got < len) {
+        auto r = co_await conn.async_read(static_cast<char*>(buf) + got, len - got);
+        if (!r || *r == 0) {
+            co_return false;
+        }
+        got += *r;
+    }
+    co_return true;
+}
+
+// Request: {size, reps}. Reply: reps writes of `size` bytes, then the client
+// acknowledges with one byte so the timing covers delivery.
+Task<void> serve(std::unique_ptr<Connection> conn, const char* mode) {
+    uint32_t request[2];
+    while (co_await read_exact(*conn, request, sizeof(request)) && request[0] > 0) {
+        size_t size = request[0];
+        size_t reps = request[1];
+
+        auto wall_start = std::chrono::steady_clock::now();
+        uint64_t cpu_start = thread_cpu_ns();
+        bool ok = true;
+        for (size_t i = 0; i < reps && ok; ++i) {
+            ok = static_cast<bool>(co_await conn->async_write_all(g_body.data(), size));
+        }
+        char ack;
+        ok = ok && co_await read_exact(*conn, &ack, 1);
+        uint64_t cpu_ns = thread_cpu_ns() - cpu_start;
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+        if (!ok) {
+            break;
+        }
+
+        double kib = static_cast<double>(size * reps) / 1024.0;
+        std::cout << std::setw(9) << size << "  " << std::setw(9) << mode << "  "
+                  << std::setw(10) << std::fixed << std::setprecision(1)
+                  << (kib / 1024.0 / secs) << " MB/s  " << std::setw(8) << std::setprecision(1)
+                  << (static_cast<double>(cpu_ns) / kib) << " ns/KiB" << std::endl;
+    }
+    conn->close();
+}
+
+static std::unique_ptr<IoContext> start_server(uint16_t port, size_t zc_threshold, const char* mode) {
+    IoContextOptions options;
+    options.zerocopy_send_threshold = zc_threshold;
+    auto ctx = IoContext::create(options);
+    bool ok = ctx->enable_multi_accept(port, [mode](std::unique_ptr<Connection> conn) {
+        serve(std::move(conn), mode).start_detached();
+    });
+    if (!ok) {
+        std::cerr << "Failed to listen on port " << port << std::endl;
+        return nullptr;
+    }
+    return ctx;
+}
+
+static bool drain(int fd, size_t len) {
+    static std::vector<char> sink(1 << 20);
+    while (len > 0) {
+        ssize_t n = ::read(fd, sink.data(), std::min(len, sink.size()));
+        if (n <= 0) {
+            return false;
+        }
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+static void run_client(const std::string& host, uint16_t port) {
+    for (uint16_t p : {port, static_cast<uint16_t>(port + 1)}) {
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(p);
+        inet_pton(AF_INET, host.c_str(), &addr.sin_addr);
+
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            std::cerr << "Cannot connect to " << host << ":" << p << std::endl;
+            if (fd >= 0) ::close(fd);
+            continue;
+        }
+        for (size_t size : SIZES) {
+            uint32_t request[2] = {static_cast<uint32_t>(size),
+                                   static_cast<uint32_t>(BYTES_PER_RUN / size)};
+            if (::write(fd, request, sizeof(request)) != sizeof(request) ||
+                !drain(fd, size_t(request[0]) * request[1]) || ::write(fd, "k", 1) != 1) {
+                break;
+            }
+        }
+        uint32_t done[2] = {0, 0};
+        (void)::write(fd, done, sizeof(done));
+        ::close(fd);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string role = argc > 1 ? argv[1] : "local";
+
+    if (role == "client") {
+        if (argc < 3) {
+            std::cerr << "Usage: zerocopy_benchmark client <host> [port]" << std::endl;
+            return 1;
+        }
+        uint16_t port = argc > 3 ? static_cast<uint16_t>(std::atoi(argv[3])) : 8092;
+        run_client(argv[2], port);
+        return 0;
+    }
+
+    uint16_t port = role == "server" && argc > 2 ? static_cast<uint16_t>(std::atoi(argv[2])) : 8092;
+    g_body.assign(SIZES[std::size(SIZES) - 1], 'z');
+
+    auto copy_ctx = start_server(port, 0, "copy");
+    auto zc_ctx = start_server(static_cast<uint16_t>(port + 1), 1, "zerocopy");
+    if (!copy_ctx || !zc_ctx) {
+        return 1;
+    }
+    std::cout << zc_ctx->features() << std::endl;
+    std::cout << "     size       mode    throughput       server CPU" << std::endl;
+
+    std::thread copy_server([&] { copy_ctx->run(); });
+    std::thread zc_server([&] { zc_ctx->run(); });
+
+    if (role == "server") {
+        std::cout << "Waiting for clients (Ctrl+C to quit)" << std::endl;
+        copy_server.join();
+        zc_server.join();
+        return 0;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    run_client("127.0.0.1", port);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    copy_ctx->stop();
+    zc_ctx->stop();
+    copy_server.join();
+    zc_server.join();
+    return 0;
+}
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "coroute/core/auth_state.hpp"
+#include "coroute/core/body_stream.hpp"
 #include "coroute/core/request.hpp"
 #include "coroute/core/response.hpp"
 #include "coroute/core/router.hpp"
@@ -48,6 +49,12 @@ using Next = std::function<Task<Response>(Request &)>;
 // Middleware function type - receives request and next function
 using Middleware = std::function<Task<Response>(Request &, Next)>;
 
+// Pre-body middleware - runs on the request head once the route is known,
+// before any of the body is read or 100 Continue is sent. Return a response
+// to answer the request without its body, or std::nullopt to go on.
+using PreBodyMiddleware =
+    std::function<Task<std::optional<Response>>(Request &)>;
+
 // ============================================================================
 // App - Main application class
 // ============================================================================
@@ -60,6 +67,37 @@ struct ShutdownOptions {
       true; // Force close remaining connections after timeout
 };
 
+// Per-phase connection deadlines (zero disables a deadline)
+struct ServerTimeouts {
+  // From the first byte of a request until its headers are complete
+  std::chrono::milliseconds header_read{10000};
+  // For each read while receiving a request body
+  std::chrono::milliseconds body_read{30000};
+  // Waiting for the next request on a kept-alive (or new) connection
+  std::chrono::milliseconds keep_alive_idle{30000};
+  // For each write of a response
+  std::chrono::milliseconds write{30000};
+  // For the whole TLS handshake of a new HTTPS connection
+  std::chrono::milliseconds tls_handshake{10000};
+};
+
+// Connection and load limits (0 = unlimited). How long an idle kept-alive
+// connection stays open is ServerTimeouts::keep_alive_idle.
+struct ServerLimits {
+  // Requests served on one connection before it is closed
+  size_t max_requests_per_connection = 1000;
+  // Open HTTP connections. At the limit the listeners stop accepting, so new
+  // clients wait in the kernel backlog; any accepted past it (backends
+  // without multi-accept) are answered with 503 and closed.
+  size_t max_connections = 0;
+  // Requests being handled at once across all connections. Past it a
+  // request is answered with 503 and its connection closed, instead of
+  // queueing behind the others.
+  size_t max_inflight_requests = 0;
+  // Sent as Retry-After with those 503s
+  std::chrono::seconds retry_after{1};
+};
+
 // Pre-compiled middleware chain - built once, executed many times
 class CompiledMiddlewareChain {
   std::vector<Middleware> middleware_;
@@ -139,6 +177,14 @@ struct AppTlsConfig {
   std::filesystem::path chain_file; // Optional: certificate chain
   bool verify_client = false;
   std::vector<std::string> alpn_protocols; // e.g., {"h2", "http/1.1"}
+  bool kernel_tls = false; // Linux kTLS after the handshake (see TlsConfig)
+  bool session_tickets = true;
+  // Shared ticket keys, current first (see TlsConfig::ticket_key_files)
+  std::vector<std::filesystem::path> ticket_key_files;
+#ifdef COROUTE_HAS_TLS
+  // External session cache shared between App instances
+  std::shared_ptr<net::SessionCache> session_cache;
+#endif
 };
 
 class App {
@@ -148,18 +194,38 @@ class App {
   CancellationSource cancel_source_;
   size_t thread_count_ = 1;
   CompiledMiddlewareChain middleware_chain_;
+  std::vector<PreBodyMiddleware> pre_body_middleware_;
 
   // Connection tracking for graceful shutdown
   std::atomic<size_t> active_connections_{0};
   std::atomic<bool> shutting_down_{false};
 
+  // Connection and load limits
+  ServerLimits limits_;
+  std::string overload_response_ = make_overload_response(limits_.retry_after);
+  std::atomic<size_t> inflight_requests_{0};
+  std::atomic<uint64_t> shed_requests_{0};
+  std::atomic<bool> accept_paused_{false};
+
   // Object pools for reduced allocations
   mutable BufferPool buffer_pool_{8192, 256};
 
+  // Connection deadlines
+  ServerTimeouts timeouts_;
+
+  // Request body limit for routes without their own
+  size_t max_body_size_ = 10 * 1024 * 1024;
+
+  // Kernel-provided read buffers (0 = disabled)
+  size_t provided_buffer_size_ = 0;
+  unsigned provided_buffer_count_ = 0;
+
+  // I/O backend settings (threads come from threads())
+  net::IoContextOptions io_options_;
+
   // TLS support
 #ifdef COROUTE_HAS_TLS
   std::unique_ptr<net::TlsContext> tls_ctx_;
-  std::unique_ptr<net::TlsListener> tls_listener_;
 #endif
   bool tls_enabled_ = false;
 
@@ -208,11 +274,61 @@ public:
     return *this;
   }
 
-  // Route registration (simple form)
-  App &route(HttpMethod method, std::string pattern, Handler handler) {
-    router_.add(method, std::move(pattern), std::move(handler));
+  // Connection deadlines (header read, body read, keep-alive idle, write)
+  App &timeouts(const ServerTimeouts &timeouts) {
+    timeouts_ = timeouts;
+    return *this;
+  }
+  const ServerTimeouts &timeouts() const noexcept { return timeouts_; }
+
+  // Requests per connection, connection cap with accept backpressure, and
+  // in-flight request shedding
+  App &limits(const ServerLimits &limits);
+  const ServerLimits &limits() const noexcept { return limits_; }
+
+  // Read into a shared per-thread buffer pool (io_uring provided buffers)
+  // instead of pinning a buffer per connection while a read is pending
+  App &provided_buffers(size_t buffer_size = 4096,
+                        unsigned buffer_count = 4096) {
+    provided_buffer_size_ = buffer_size;
+    provided_buffer_count_ = buffer_count;
+    return *this;
+  }
+
+  // How idle I/O workers wait: Block saves CPU, BusyPoll minimizes latency,
+  // SpinThenBlock (default) spins up to max_spin while traffic is steady
+  App &wait_policy(net::WaitPolicy policy,
+                   std::chrono::microseconds max_spin =
+                       std::chrono::microseconds(50)) {
+    io_options_.wait_policy = policy;
+    io_options_.max_spin = max_spin;
+    return *this;
+  }
+
+  // I/O backend tuning (ring sizes, io_uring setup flags, wait policy).
+  // The worker count is still set by threads().
+  App &io_options(const net::IoContextOptions &options) {
+    io_options_ = options;
     return *this;
   }
+  const net::IoContextOptions &io_options() const noexcept {
+    return io_options_;
+  }
+
+  // Route registration (simple form). Options set the route's body limit
+  // and whether its handler streams the body.
+  App &route(HttpMethod method, std::string pattern, Handler handler,
+             RouteOptions options = {}) {
+    router_.add(method, std::move(pattern), std::move(handler), options);
+    return *this;
+  }
+
+  // Largest request body for routes that set no max_body_size (413 past it)
+  App &max_body_size(size_t bytes) {
+    max_body_size_ = bytes;
+    return *this;
+  }
+  size_t max_body_size() const noexcept { return max_body_size_; }
 
   // Convenience methods
   App &get(std::string pattern, Handler handler) {
@@ -524,16 +640,35 @@ public:
     return *this;
   }
 
-  // Run the server (blocking)
+  // Pre-body middleware, in registration order; the first response wins.
+  // Authentication and quota checks here turn away uploads, including those
+  // sent with Expect: 100-continue, before their bodies are transferred.
+  App &use_before_body(PreBodyMiddleware middleware) {
+    pre_body_middleware_.push_back(std::move(middleware));
+    return *this;
+  }
+
+  // Run the server (blocking) on all interfaces, dual-stack where available
   void run(uint16_t port);
 
+  // Run the server (blocking) on a specific address or Unix domain socket,
+  // e.g. net::Endpoint::parse("127.0.0.1:8080") or "unix:/run/app.sock"
+  void run(const net::Endpoint &endpoint);
+
   // Run the server (async)
   Task<void> run_async(uint16_t port);
+  Task<void> run_async(net::Endpoint endpoint);
 
   // Enable TLS/HTTPS
 #ifdef COROUTE_HAS_TLS
   App &enable_tls(const AppTlsConfig &config);
   bool tls_enabled() const noexcept { return tls_enabled_; }
+
+  // Handshake and resumption counters (all zero before enable_tls)
+  net::TlsStats tls_stats() const;
+
+  // Re-read the ticket key files, e.g. after a rotation job replaced them
+  expected<void, Error> reload_tls_ticket_keys();
 #endif
 
   // HTTP/2 configuration
@@ -659,17 +794,93 @@ public:
     return active_connections_.load(std::memory_order_relaxed);
   }
 
+  // Requests currently being handled
+  size_t inflight_requests() const {
+    return inflight_requests_.load(std::memory_order_relaxed);
+  }
+
+  // Requests and connections answered with 503 because of limits()
+  uint64_t shed_requests() const {
+    return shed_requests_.load(std::memory_order_relaxed);
+  }
+
   // Get cancellation token for graceful shutdown
   CancellationToken cancellation_token() const {
     return cancel_source_.token();
   }
 
+  // Access the I/O context (null until run() is called)
+  net::IoContext *io_context() noexcept { return io_ctx_.get(); }
+  const net::IoContext *io_context() const noexcept { return io_ctx_.get(); }
+
 private:
-  // Handle a single connection
-  Task<void> handle_connection(std::unique_ptr<net::Connection> conn);
+  // Apply I/O options to a freshly created context
+  void configure_io_context();
+
+  // Handle a single connection. `counted` means the caller already holds a
+  // ConnectionGuard for it (the TLS path counts the handshake too).
+  Task<void> handle_connection(std::unique_ptr<net::Connection> conn,
+                               bool counted = false);
+
+  // Answer with the pre-serialized 503 and close
+  Task<void> shed_connection(std::unique_ptr<net::Connection> conn);
+
+  // Pause or resume accepting as the connection count crosses the limit
+  void update_accept_backpressure();
+
+  // Counts a connection in active_connections_ for its lifetime, updating
+  // accept backpressure as it opens and closes
+  struct ConnectionGuard;
+
+  // "503 Service Unavailable" with Retry-After and Connection: close
+  static std::string make_overload_response(std::chrono::seconds retry_after);
+
+#ifdef COROUTE_HAS_TLS
+  // Handshake (bounded by timeouts_.tls_handshake), then serve over
+  // HTTP/1.1 or, if negotiated through ALPN, HTTP/2
+  Task<void> handle_tls_connection(std::unique_ptr<net::Connection> conn);
+#endif
+
+  // Bytes read from an HTTP/1.1 connection and not yet consumed. It
+  // persists across requests so pipelined ones are not lost. Requests parsed
+  // from it hold views into the buffer, so while one is alive the buffer is
+  // replaced rather than compacted.
+  struct InputBuffer {
+    std::shared_ptr<BufferPool::Buffer> data;
+    size_t begin = 0;   // First unconsumed byte
+    size_t scanned = 0; // Bytes from begin already searched for a head end
+
+    size_t size() const noexcept { return data ? data->size() - begin : 0; }
+    std::string_view pending() const noexcept {
+      return data ? std::string_view(data->data() + begin, size())
+                  : std::string_view{};
+    }
+  };
+
+  // Pooled connection buffer (input, shared by the requests parsed from
+  // it, or serialized output)
+  std::shared_ptr<BufferPool::Buffer> acquire_buffer();
+
+  // Make room at the end of the input for the next read
+  void compact_input(InputBuffer &input);
+
+  // True when another complete request head is already buffered
+  static bool has_buffered_request(InputBuffer &input);
+
+  // Decide on a request from its head alone: an unsupported Expect, a body
+  // over the route's limit, or a pre-body middleware's answer
+  Task<std::optional<Response>> screen_request(Request &req,
+                                               const RouteOptions *options);
+
+  // Read the body into Request::body() unless the route streams it
+  Task<expected<void, Error>> read_request_body(Request &req,
+                                                const RouteOptions *options);
 
-  // Parse HTTP request from connection
-  Task<expected<Request, Error>> parse_request(net::Connection &conn);
+  // Parse the next HTTP request, reading only when the input holds no
+  // complete head; idle_timeout bounds the wait for the first byte
+  Task<expected<Request, Error>>
+  parse_request(net::Connection &conn, InputBuffer &input,
+                std::chrono::milliseconds idle_timeout);
 
   // Check if request is a WebSocket upgrade and handle it
   // Returns true if handled as WebSocket, false if should continue as HTTP
@@ -682,9 +893,10 @@ private:
   Task<bool> try_http2_upgrade(std::unique_ptr<net::Connection> &conn,
                                Request &req);
 
-  // Handle HTTP/2 connection
+  // Handle HTTP/2 connection (`counted` as for handle_connection)
   Task<void>
-  handle_http2_connection(std::shared_ptr<http2::Http2Connection> h2_conn);
+  handle_http2_connection(std::shared_ptr<http2::Http2Connection> h2_conn,
+                          bool counted = false);
 #endif
 };
 
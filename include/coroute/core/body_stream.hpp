@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "coroute/core/chunked.hpp"
+#include "coroute/core/error.hpp"
+#include "coroute/core/headers.hpp"
+#include "coroute/coro/task.hpp"
+#include "coroute/net/io_context.hpp"
+#include "coroute/util/expected.hpp"
+
+namespace coroute {
+
+// ============================================================================
+// BodyStream - A request body read as it arrives
+// ============================================================================
+
+// Reads a Content-Length or chunked body from the connection a piece at a
+// time. Nothing is read until the handler asks, and each piece lands in one
+// fixed-size buffer, so a slow consumer holds at most that much memory while
+// TCP flow control holds the client back.
+//
+//   app.route(HttpMethod::POST, "/upload", handler, {.stream_body = true});
+//
+//   while (true) {
+//       auto piece = co_await req.body_stream().next();
+//       if (!piece) co_return Response::bad_request(piece.error().to_string());
+//       if (piece->empty()) break;   // End of body
+//       sink.write(*piece);
+//   }
+class BodyStream {
+public:
+    enum class Framing : uint8_t {
+        None,           // No body
+        ContentLength,
+        Chunked
+    };
+
+    // Size of the buffer next() reads into
+    static constexpr size_t PIECE_SIZE = 16 * 1024;
+
+    struct FramingInfo {
+        Framing framing = Framing::None;
+        size_t content_length = 0;
+    };
+
+    // How a request's body is framed (RFC 9112 section 6.3). A message that
+    // could be read two ways is refused rather than resolved, since anything
+    // in front of the server may have resolved it the other way:
+    // - Transfer-Encoding more than once, or with Content-Length: 400
+    // - Content-Length values that differ or are not a number: 400
+    // - A transfer coding other than "chunked": 501
+    static expected<FramingInfo, Error> framing_of(const BasicHeaderMap<std::string_view>& headers);
+
+    // A request without a body
+    BodyStream() = default;
+
+    // `buffered` holds body bytes read along with the head. For a chunked
+    // body it may run past the end; see take_unread().
+    BodyStream(net::Connection& conn, Framing framing, size_t content_length,
+               std::string_view buffered);
+
+    BodyStream(const BodyStream&) = delete;
+    BodyStream& operator=(const BodyStream&) = delete;
+
+    Framing framing() const noexcept { return framing_; }
+
+    // Declared size; none for a chunked body
+    std::optional<size_t> content_length() const noexcept {
+        if (framing_ != Framing::ContentLength) {
+            return std::nullopt;
+        }
+        return content_length_;
+    }
+
+    // All of the body has been read (always true without one)
+    bool finished() const noexcept { return finished_; }
+
+    // Body bytes handed out so far
+    size_t bytes_read() const noexcept { return received_; }
+
+    // Largest body accepted (0 = no limit). Reading past it fails with
+    // HttpError::PayloadTooLarge; a larger Content-Length fails at once.
+    void set_limit(size_t max_bytes) noexcept { limit_ = max_bytes; }
+    size_t limit() const noexcept { return limit_; }
+
+    // Next piece of the body, at most PIECE_SIZE bytes and valid until the
+    // next call. Empty at the end of the body.
+    Task<expected<std::string_view, Error>> next();
+
+    // Read up to `max` body bytes into `out`; 0 at the end of the body
+    Task<expected<size_t, Error>> read(char* out, size_t max);
+
+    // The rest of the body in memory, grown as it arrives
+    Task<expected<std::string, Error>> read_all();
+
+    // Read and drop the rest of the body so the connection can serve the
+    // next request. Fails if more than `max_bytes` remain, in which case
+    // the connection should be closed instead.
+    Task<expected<void, Error>> discard(size_t max_bytes);
+
+    // Trailers of a chunked body (available once finished)
+    const std::vector<std::pair<std::string, std::string>>& trailers() const noexcept;
+
+    // Bytes read from the connection past the end of a chunked body, which
+    // belong to the next request
+    std::string take_unread();
+
+private:
+    net::Connection* conn_ = nullptr;
+    Framing framing_ = Framing::None;
+    bool finished_ = true;
+    size_t content_length_ = 0;
+    size_t received_ = 0;
+    size_t limit_ = 0;
+    std::string_view buffered_;                  // Content-Length only
+    std::unique_ptr<ChunkedBodyReader> chunked_; // Chunked only
+    std::unique_ptr<char[]> piece_;              // next()'s buffer
+
+    expected<void, Error> check_limit(size_t total) const;
+};
+
+} // namespace coroute
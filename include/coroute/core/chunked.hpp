@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -100,8 +101,12 @@ public:
     bool finished() const noexcept { return finished_; }
 
 private:
-    // Send HTTP headers with Transfer-Encoding: chunked
-    Task<expected<void, Error>> send_headers();
+    // HTTP headers with Transfer-Encoding: chunked
+    std::string serialize_headers() const;
+    
+    // Send the headers (if not yet sent) followed by `parts` in one
+    // gathered write
+    Task<expected<void, Error>> send(std::span<const net::IoVec> parts);
     
     // Get status text
     static std::string_view status_text(int status) noexcept;
@@ -113,8 +118,17 @@ private:
 
 class ChunkedBodyReader {
 public:
+    // Largest total size of the trailers, the same bound as a request head.
+    // More fails with HttpError::RequestHeaderFieldsTooLarge.
+    static constexpr size_t MAX_TRAILER_SIZE = 8 * 1024;
+    
     explicit ChunkedBodyReader(net::Connection* conn) : conn_(conn) {}
     
+    // Start with bytes already read from the connection (those after the
+    // request head)
+    ChunkedBodyReader(net::Connection* conn, std::string_view buffered)
+        : conn_(conn), buffer_(buffered) {}
+    
     // Read the entire chunked body into a string
     // Use this for small bodies where you want all data at once
     Task<expected<std::string, Error>> read_all(size_t max_size = 10 * 1024 * 1024);
@@ -123,9 +137,18 @@ public:
     // Returns empty string when all chunks have been read
     Task<expected<std::string, Error>> read_chunk();
     
+    // Read up to `max` bytes of chunk data into `out`, without holding a
+    // whole chunk in memory. Returns 0 once the last chunk and trailers have
+    // been read. Do not mix with read_chunk().
+    Task<expected<size_t, Error>> read_some(char* out, size_t max);
+    
     // Check if all chunks have been read
     bool finished() const noexcept { return finished_; }
     
+    // Bytes read from the connection past the end of the body (the start of
+    // a pipelined request). Valid once finished.
+    std::string take_buffered() noexcept { return std::move(buffer_); }
+    
     // Get trailers (available after finished)
     const std::vector<std::pair<std::string, std::string>>& trailers() const noexcept {
         return trailers_;
@@ -136,6 +159,11 @@ private:
     bool finished_ = false;
     std::vector<std::pair<std::string, std::string>> trailers_;
     std::string buffer_;  // Leftover data from previous reads
+    size_t chunk_remaining_ = 0;  // Data bytes of the current chunk (read_some)
+    bool chunk_open_ = false;     // A chunk's data was read, its CRLF not yet
+    
+    // Read a chunk size line; for the last chunk also the trailers
+    Task<expected<size_t, Error>> read_chunk_size();
     
     // Read a line (up to \r\n)
     Task<expected<std::string, Error>> read_line();
@@ -44,7 +44,9 @@ enum class HttpError {
     PayloadTooLarge = 413,
     UriTooLong = 414,
     UnsupportedMediaType = 415,
+    ExpectationFailed = 417,
     TooManyRequests = 429,
+    RequestHeaderFieldsTooLarge = 431,
     
     // 5xx Server Errors
     Internal = 500,
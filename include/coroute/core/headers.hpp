@@ -0,0 +1,205 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace coroute {
+
+// ============================================================================
+// Header Names
+// ============================================================================
+
+// Headers the server and middleware consult on (almost) every message. Each
+// has a fixed slot in a HeaderMap, filled as headers are added, so looking
+// one up never scans or compares names.
+enum class KnownHeader : uint8_t {
+    Host,
+    Connection,
+    ContentLength,
+    ContentType,
+    TransferEncoding,
+    Cookie,
+    AcceptEncoding,
+    Upgrade,
+    Expect,
+    Range,
+    IfNoneMatch,
+    IfModifiedSince,
+    ContentEncoding,
+    Date,
+    Count  // Not a known header
+};
+
+// ASCII case-insensitive comparison, as header names require
+bool iequals(std::string_view a, std::string_view b) noexcept;
+
+// Slot for a header name in any case, or KnownHeader::Count
+KnownHeader known_header(std::string_view name) noexcept;
+
+// Canonical spelling ("Content-Length"); empty for Count
+std::string_view known_header_name(KnownHeader header) noexcept;
+
+// ============================================================================
+// HeaderMap
+// ============================================================================
+
+// Headers in arrival order in one flat vector, with names compared
+// case-insensitively. Repeated headers are kept (Set-Cookie, or a request
+// that sends one twice); lookups return the last occurrence. `String` is
+// std::string_view for parsed requests, whose bytes live in the read buffer,
+// and std::string for responses.
+template <typename String>
+class BasicHeaderMap {
+public:
+    using value_type = std::pair<String, String>;
+    using container_type = std::vector<value_type>;
+    using const_iterator = typename container_type::const_iterator;
+    using size_type = typename container_type::size_type;
+
+private:
+    static constexpr size_t SLOT_COUNT = static_cast<size_t>(KnownHeader::Count);
+
+    container_type entries_;
+    // Index + 1 of the last entry for each known header, 0 when absent
+    std::array<uint32_t, SLOT_COUNT> slots_{};
+
+public:
+    BasicHeaderMap() = default;
+
+    BasicHeaderMap(std::initializer_list<value_type> headers) {
+        entries_.reserve(headers.size());
+        for (const auto& [name, value] : headers) {
+            append(name, value);
+        }
+    }
+
+    // Iteration (arrival order)
+    const_iterator begin() const noexcept { return entries_.begin(); }
+    const_iterator end() const noexcept { return entries_.end(); }
+    size_type size() const noexcept { return entries_.size(); }
+    bool empty() const noexcept { return entries_.empty(); }
+    const value_type& operator[](size_type i) const noexcept { return entries_[i]; }
+
+    void reserve(size_type n) { entries_.reserve(n); }
+
+    void clear() noexcept {
+        entries_.clear();
+        slots_ = {};
+    }
+
+    // Add a header, keeping earlier ones of the same name
+    void append(String name, String value) {
+        KnownHeader known = known_header(name);
+        entries_.emplace_back(std::move(name), std::move(value));
+        if (known != KnownHeader::Count) {
+            slots_[static_cast<size_t>(known)] = static_cast<uint32_t>(entries_.size());
+        }
+    }
+
+    // Replace the first header of this name and drop any repeats, or append
+    void set(String name, String value) {
+        size_t first = find_first(name);
+        if (first == npos) {
+            append(std::move(name), std::move(value));
+            return;
+        }
+        entries_[first].second = std::move(value);
+        if (remove_from(first + 1, entries_[first].first)) {
+            reindex();
+        } else if (KnownHeader known = known_header(entries_[first].first);
+                   known != KnownHeader::Count) {
+            slots_[static_cast<size_t>(known)] = static_cast<uint32_t>(first + 1);
+        }
+    }
+
+    // Remove every header of this name; returns whether any was present
+    bool remove(std::string_view name) {
+        if (!remove_from(0, name)) {
+            return false;
+        }
+        reindex();
+        return true;
+    }
+
+    // Value of the last header of this name
+    std::optional<std::string_view> get(KnownHeader header) const noexcept {
+        uint32_t slot = slots_[static_cast<size_t>(header)];
+        if (slot == 0) {
+            return std::nullopt;
+        }
+        return std::string_view(entries_[slot - 1].second);
+    }
+
+    std::optional<std::string_view> get(std::string_view name) const noexcept {
+        KnownHeader known = known_header(name);
+        if (known != KnownHeader::Count) {
+            return get(known);
+        }
+        for (auto it = entries_.rbegin(); it != entries_.rend(); ++it) {
+            if (iequals(it->first, name)) {
+                return std::string_view(it->second);
+            }
+        }
+        return std::nullopt;
+    }
+
+    bool contains(KnownHeader header) const noexcept {
+        return slots_[static_cast<size_t>(header)] != 0;
+    }
+
+    bool contains(std::string_view name) const noexcept { return get(name).has_value(); }
+
+private:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    size_t find_first(std::string_view name) const noexcept {
+        KnownHeader known = known_header(name);
+        if (known != KnownHeader::Count && slots_[static_cast<size_t>(known)] == 0) {
+            return npos;
+        }
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            if (iequals(entries_[i].first, name)) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    // Erase matching entries at or after `from`, keeping order
+    bool remove_from(size_t from, std::string_view name) {
+        size_t out = from;
+        for (size_t i = from; i < entries_.size(); ++i) {
+            if (iequals(entries_[i].first, name)) {
+                continue;
+            }
+            if (out != i) {
+                entries_[out] = std::move(entries_[i]);
+            }
+            ++out;
+        }
+        if (out == entries_.size()) {
+            return false;
+        }
+        entries_.erase(entries_.begin() + static_cast<std::ptrdiff_t>(out), entries_.end());
+        return true;
+    }
+
+    void reindex() noexcept {
+        slots_ = {};
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            KnownHeader known = known_header(entries_[i].first);
+            if (known != KnownHeader::Count) {
+                slots_[static_cast<size_t>(known)] = static_cast<uint32_t>(i + 1);
+            }
+        }
+    }
+};
+
+} // namespace coroute
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "coroute/core/request.hpp"
+#include "coroute/core/error.hpp"
+#include "coroute/util/expected.hpp"
+
+namespace coroute {
+
+// ============================================================================
+// HTTP/1.1 Request Parser
+// ============================================================================
+
+namespace http1 {
+
+// Byte-scanning kernels. The best one the CPU supports is picked on first
+// use; SSE4.2 and AVX2 are x86-64 only, every other target runs Scalar.
+enum class Isa : uint8_t {
+    Scalar,
+    SSE42,
+    AVX2
+};
+
+Isa active_isa() noexcept;
+std::string_view isa_name(Isa isa) noexcept;
+
+// Switch kernels (benchmarks, tests). Unsupported choices fall back to the
+// best supported one below them; returns the kernel now in use.
+Isa set_isa(Isa isa) noexcept;
+
+// Offset just past the blank line ending a request head, or npos if it has
+// not arrived yet. Pass the previous size as `from` after each read so only
+// new bytes are scanned.
+size_t find_head_end(std::string_view data, size_t from = 0) noexcept;
+
+// Parse a complete request head (request line, headers, blank line) into
+// `req`. Method tokens, header names and values are validated per RFC 9110;
+// path, query string, version and headers become views into `head`, so its
+// bytes must outlive the request (see Request::hold_buffer). Only a path or
+// query parameters with escapes are decoded into owned strings.
+expected<void, Error> parse_head(std::string_view head, Request& req);
+
+} // namespace http1
+
+} // namespace coroute
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "coroute/core/response.hpp"
+
+namespace coroute {
+
+// ============================================================================
+// HTTP/1.1 Response Serializer
+// ============================================================================
+
+namespace http1 {
+
+// "HTTP/1.1 200 OK\r\n". Built once for every status from 100 to 599;
+// empty outside that range.
+std::string_view status_line(int status) noexcept;
+
+// "Date: Sun, 06 Nov 1994 08:49:37 GMT\r\n" (RFC 7231 IMF-fixdate) for the
+// current second. Each thread, so each ring, formats it at most once per
+// second and hands out the cached copy in between.
+std::string_view date_header() noexcept;
+
+// What the server adds to a response's own headers
+struct HeadOptions {
+    enum class Connection : uint8_t {
+        None,       // Leave connection management to the response
+        Close,      // Connection: close
+        KeepAlive   // Connection: keep-alive, plus Keep-Alive parameters
+    };
+
+    Connection connection = Connection::None;
+    std::string_view keep_alive;  // "timeout=5"; Keep-Alive is omitted when empty
+    size_t max_requests = 0;      // Appended to keep_alive as ", max=N"
+    bool date = false;            // Add date_header() unless the response sets Date
+};
+
+// Exact number of bytes write_head() produces
+size_t head_size(const Response& resp, const HeadOptions& options = {}) noexcept;
+
+// Write the status line, headers and blank line to `out`, which must hold
+// head_size() bytes. Returns the end of what was written. Never allocates.
+char* write_head(char* out, const Response& resp, const HeadOptions& options = {}) noexcept;
+
+// Append the same bytes to `out`. Allocates only if out lacks the capacity
+// for head_size() more bytes.
+void append_head(std::vector<char>& out, const Response& resp, const HeadOptions& options = {});
+
+} // namespace http1
+
+} // namespace coroute
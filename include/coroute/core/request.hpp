@@ -1,20 +1,27 @@
 #pragma once
 
 #include <any>
+#include <deque>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 
 #include "coroute/core/error.hpp"
+#include "coroute/core/headers.hpp"
 #include "coroute/util/expected.hpp"
 #include "coroute/util/from_string.hpp"
+#include "coroute/util/object_pool.hpp"
 
 
 namespace coroute {
 
+class BodyStream;
+
 // ============================================================================
 // HTTP Method
 // ============================================================================
@@ -39,19 +46,33 @@ std::string_view method_to_string(HttpMethod method) noexcept;
 // Request
 // ============================================================================
 
+// Path, query string, version and headers are views. The HTTP/1.1 parser
+// points them into the connection's read buffer, which the request keeps
+// alive; values set through the std::string setters are copied into storage
+// owned by the request. Copies share that storage, so views taken from any
+// copy stay valid while one of them lives.
 class Request {
 public:
-  using Headers = std::unordered_map<std::string, std::string>;
+  using Header = std::pair<std::string_view, std::string_view>;
+  using Headers = BasicHeaderMap<std::string_view>;
   using QueryParams = std::unordered_map<std::string, std::string>;
 
 private:
+  // Backing memory for the views
+  struct Storage {
+    std::shared_ptr<const BufferPool::Buffer> buffer;
+    std::deque<std::string> strings; // Stable addresses as it grows
+  };
+
   HttpMethod method_ = HttpMethod::GET;
-  std::string path_;
-  std::string query_string_;
-  std::string http_version_ = "HTTP/1.1";
+  std::string_view path_;
+  std::string_view query_string_;
+  std::string_view http_version_ = "HTTP/1.1";
   Headers headers_;
+  std::shared_ptr<Storage> storage_;
   QueryParams query_params_;
   std::string body_;
+  std::shared_ptr<BodyStream> body_stream_; // Shared by copies
 
   // Route parameters (filled by router after matching)
   std::vector<std::string> route_params_;
@@ -70,16 +91,44 @@ public:
   const Headers &headers() const noexcept { return headers_; }
   std::string_view body() const noexcept { return body_; }
 
-  // Setters (for parser)
+  // Setters (copy into the request's storage)
   void set_method(HttpMethod m) { method_ = m; }
   void set_method(std::string_view m) { method_ = parse_method(m); }
-  void set_path(std::string p) { path_ = std::move(p); }
-  void set_query_string(std::string qs) { query_string_ = std::move(qs); }
-  void set_http_version(std::string v) { http_version_ = std::move(v); }
+  void set_path(std::string p) { path_ = own(std::move(p)); }
+  void set_query_string(std::string qs) { query_string_ = own(std::move(qs)); }
+  void set_http_version(std::string v) { http_version_ = own(std::move(v)); }
   void set_body(std::string b) { body_ = std::move(b); }
 
+  // The body as it arrives from the connection (see BodyStream). Unless the
+  // route streams its body, the server reads it into body() before the
+  // handler runs and this is left finished.
+  BodyStream &body_stream();
+  void set_body_stream(std::shared_ptr<BodyStream> stream) {
+    body_stream_ = std::move(stream);
+  }
+
+  // Body bytes still to be read from the connection
+  bool body_pending() const noexcept;
+
+  // Replaces an existing header of the same name (in any case)
   void add_header(std::string key, std::string value) {
-    headers_[std::move(key)] = std::move(value);
+    std::string_view name = own(std::move(key));
+    headers_.set(name, own(std::move(value)));
+  }
+
+  // Zero-copy setters for the parser. The bytes must outlive the request,
+  // normally by living in the buffer handed to hold_buffer().
+  void set_path_view(std::string_view p) noexcept { path_ = p; }
+  void set_query_string_view(std::string_view qs) noexcept { query_string_ = qs; }
+  void set_http_version_view(std::string_view v) noexcept { http_version_ = v; }
+  void append_header_view(std::string_view key, std::string_view value) {
+    headers_.append(key, value);
+  }
+
+  // Keep the read buffer alive for as long as the request and its copies.
+  // Pipelined requests parsed from one buffer all share it.
+  void hold_buffer(std::shared_ptr<const BufferPool::Buffer> buffer) {
+    ensure_storage().buffer = std::move(buffer);
   }
 
   void add_query_param(std::string key, std::string value) {
@@ -108,14 +157,13 @@ public:
     return from_string<T>(route_params_[index]);
   }
 
-  // Get header value
-  std::optional<std::string_view> header(std::string_view key) const {
-    // Case-insensitive lookup would be better, but keeping simple for now
-    auto it = headers_.find(std::string(key));
-    if (it != headers_.end()) {
-      return it->second;
-    }
-    return std::nullopt;
+  // Get header value by name in any case (the last one when repeated)
+  std::optional<std::string_view> header(std::string_view key) const noexcept {
+    return headers_.get(key);
+  }
+
+  std::optional<std::string_view> header(KnownHeader key) const noexcept {
+    return headers_.get(key);
   }
 
   // Get query parameter
@@ -146,12 +194,11 @@ public:
 
   // Check if connection should be kept alive
   bool keep_alive() const noexcept {
-    auto conn = header("Connection");
+    auto conn = header(KnownHeader::Connection);
     if (conn) {
-      // Case-insensitive comparison would be better
-      if (*conn == "close")
+      if (iequals(*conn, "close"))
         return false;
-      if (*conn == "keep-alive")
+      if (iequals(*conn, "keep-alive"))
         return true;
     }
     // HTTP/1.1 defaults to keep-alive
@@ -160,7 +207,7 @@ public:
 
   // Content length
   std::optional<size_t> content_length() const {
-    auto cl = header("Content-Length");
+    auto cl = header(KnownHeader::ContentLength);
     if (cl) {
       auto result = from_string<size_t>(*cl);
       if (result)
@@ -171,7 +218,7 @@ public:
 
   // Content type
   std::optional<std::string_view> content_type() const {
-    return header("Content-Type");
+    return header(KnownHeader::ContentType);
   }
 
   // Context storage (for middleware)
@@ -199,14 +246,28 @@ public:
   // Reset for object pooling
   void reset() {
     method_ = HttpMethod::GET;
-    path_.clear();
-    query_string_.clear();
+    path_ = {};
+    query_string_ = {};
     http_version_ = "HTTP/1.1";
     headers_.clear();
     query_params_.clear();
     body_.clear();
+    body_stream_.reset();
     route_params_.clear();
     context_.clear();
+    storage_.reset();
+  }
+
+private:
+  Storage &ensure_storage() {
+    if (!storage_) {
+      storage_ = std::make_shared<Storage>();
+    }
+    return *storage_;
+  }
+
+  std::string_view own(std::string s) {
+    return ensure_storage().strings.emplace_back(std::move(s));
   }
 };
 
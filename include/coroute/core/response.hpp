@@ -8,6 +8,8 @@
 #include <optional>
 #include <filesystem>
 
+#include "coroute/core/headers.hpp"
+
 namespace coroute {
 
 // ============================================================================
@@ -27,11 +29,11 @@ struct FileResponseInfo {
 class Response {
 public:
     using Header = std::pair<std::string, std::string>;
-    using Headers = std::vector<Header>;
+    using Headers = BasicHeaderMap<std::string>;
 
 private:
     int status_ = 200;
-    std::string status_text_ = "OK";
+    std::string_view status_text_ = "OK";  // Always a static reason phrase
     Headers headers_;
     std::string body_;
     std::optional<FileResponseInfo> file_info_;  // For zero-copy file serving
@@ -49,23 +51,31 @@ public:
     int status() const noexcept { return status_; }
     std::string_view status_text() const noexcept { return status_text_; }
     const Headers& headers() const noexcept { return headers_; }
+
+    // Header value by name in any case (the last one when repeated)
+    std::optional<std::string_view> header(std::string_view key) const noexcept {
+        return headers_.get(key);
+    }
+
+    std::optional<std::string_view> header(KnownHeader key) const noexcept {
+        return headers_.get(key);
+    }
     std::string_view body() const noexcept { return body_; }
 
     // Mutators
+    // Replaces an existing header of the same name (in any case)
     void set_header(std::string key, std::string value) {
-        // Check if header already exists, update if so
-        for (auto& [k, v] : headers_) {
-            if (k == key) {
-                v = std::move(value);
-                return;
-            }
-        }
-        headers_.emplace_back(std::move(key), std::move(value));
+        headers_.set(std::move(key), std::move(value));
     }
     
     // Add header (allows duplicates, needed for Set-Cookie)
     void add_header(std::string key, std::string value) {
-        headers_.emplace_back(std::move(key), std::move(value));
+        headers_.append(std::move(key), std::move(value));
+    }
+
+    // Remove every header of this name (in any case)
+    bool remove_header(std::string_view key) {
+        return headers_.remove(key);
     }
     
     void set_status(int status) {
@@ -77,7 +87,8 @@ public:
         body_ = std::move(body);
     }
 
-    // Serialize to HTTP response string
+    // Serialize to HTTP response string (http1::write_head writes the head
+    // into a caller's buffer instead)
     std::string serialize() const;
     
     // Serialize headers only (for zero-copy file responses)
@@ -90,8 +101,8 @@ public:
         r.status_text_ = "OK";
         r.body_ = std::move(body);
         if (!r.body_.empty()) {
-            r.headers_.emplace_back("Content-Type", std::move(content_type));
-            r.headers_.emplace_back("Content-Length", std::to_string(r.body_.size()));
+            r.headers_.append("Content-Type", std::move(content_type));
+            r.headers_.append("Content-Length", std::to_string(r.body_.size()));
         }
         return r;
     }
@@ -109,8 +120,8 @@ public:
         r.status_ = 404;
         r.status_text_ = "Not Found";
         r.body_ = std::move(body);
-        r.headers_.emplace_back("Content-Type", "text/plain");
-        r.headers_.emplace_back("Content-Length", std::to_string(r.body_.size()));
+        r.headers_.append("Content-Type", "text/plain");
+        r.headers_.append("Content-Length", std::to_string(r.body_.size()));
         return r;
     }
 
@@ -119,8 +130,8 @@ public:
         r.status_ = 400;
         r.status_text_ = "Bad Request";
         r.body_ = std::move(body);
-        r.headers_.emplace_back("Content-Type", "text/plain");
-        r.headers_.emplace_back("Content-Length", std::to_string(r.body_.size()));
+        r.headers_.append("Content-Type", "text/plain");
+        r.headers_.append("Content-Length", std::to_string(r.body_.size()));
         return r;
     }
 
@@ -129,8 +140,18 @@ public:
         r.status_ = 500;
         r.status_text_ = "Internal Server Error";
         r.body_ = std::move(body);
-        r.headers_.emplace_back("Content-Type", "text/plain");
-        r.headers_.emplace_back("Content-Length", std::to_string(r.body_.size()));
+        r.headers_.append("Content-Type", "text/plain");
+        r.headers_.append("Content-Length", std::to_string(r.body_.size()));
+        return r;
+    }
+
+    static Response service_unavailable(std::string body = "Service Unavailable") {
+        Response r;
+        r.status_ = 503;
+        r.status_text_ = "Service Unavailable";
+        r.body_ = std::move(body);
+        r.headers_.append("Content-Type", "text/plain");
+        r.headers_.append("Content-Length", std::to_string(r.body_.size()));
         return r;
     }
 
@@ -138,8 +159,8 @@ public:
         Response r;
         r.status_ = status;
         r.status_text_ = default_status_text(status);
-        r.headers_.emplace_back("Location", std::move(location));
-        r.headers_.emplace_back("Content-Length", "0");
+        r.headers_.append("Location", std::move(location));
+        r.headers_.append("Content-Length", "0");
         return r;
     }
 
@@ -169,14 +190,14 @@ public:
                          size_t length = 0) {
         Response r;
         r.status_ = 200;
-        r.headers_.emplace_back("Content-Type", std::string(content_type));
+        r.headers_.append("Content-Type", std::string(content_type));
         size_t actual_length = (length == 0) ? (file_size - offset) : length;
-        r.headers_.emplace_back("Content-Length", std::to_string(actual_length));
+        r.headers_.append("Content-Length", std::to_string(actual_length));
         r.set_file(path, offset, actual_length);
         return r;
     }
 
-private:
+    // Reason phrase for a status code ("Unknown" when not listed)
     static std::string_view default_status_text(int status) noexcept;
 };
 
@@ -199,7 +220,7 @@ public:
     }
 
     ResponseBuilder& header(std::string key, std::string value) {
-        headers_.emplace_back(std::move(key), std::move(value));
+        headers_.append(std::move(key), std::move(value));
         return *this;
     }
 
@@ -225,15 +246,8 @@ public:
     // Build final response
     Response build() {
         // Add Content-Length if body is set and not already present
-        bool has_content_length = false;
-        for (const auto& [k, v] : headers_) {
-            if (k == "Content-Length") {
-                has_content_length = true;
-                break;
-            }
-        }
-        if (!has_content_length && !body_.empty()) {
-            headers_.emplace_back("Content-Length", std::to_string(body_.size()));
+        if (!headers_.contains(KnownHeader::ContentLength) && !body_.empty()) {
+            headers_.append("Content-Length", std::to_string(body_.size()));
         }
         
         return Response(status_, std::move(headers_), std::move(body_));
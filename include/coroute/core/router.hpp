@@ -36,6 +36,20 @@ using HandlerWithBuilder =
 // View handler: takes Request, returns Task<ViewResultAny>
 using ViewHandler = std::function<Task<ViewResultAny>(Request &)>;
 
+// ============================================================================
+// RouteOptions - Per-route request handling
+// ============================================================================
+
+struct RouteOptions {
+  // Largest request body accepted, answered with 413 past it
+  // (0 = the app's max_body_size())
+  size_t max_body_size = 0;
+
+  // Hand the body to the handler as it arrives through
+  // Request::body_stream() instead of reading it into Request::body() first
+  bool stream_body = false;
+};
+
 // ============================================================================
 // RouteInfo - Stored route information
 // ============================================================================
@@ -45,6 +59,7 @@ struct RouteInfo {
   Handler handler;
   HttpMethod method = HttpMethod::GET;
   std::vector<std::string> param_names; // Parameter names in order
+  RouteOptions options;
 };
 
 // ============================================================================
@@ -86,7 +101,8 @@ public:
   Router() = default;
 
   // Add route with explicit method
-  void add(HttpMethod method, std::string pattern, Handler handler);
+  void add(HttpMethod method, std::string pattern, Handler handler,
+           RouteOptions options = {});
 
   // Convenience methods
   void get(std::string pattern, Handler handler) {
@@ -112,6 +128,7 @@ public:
   // Match a request and return handler + extracted params
   struct MatchResult {
     const Handler *handler = nullptr;
+    const RouteOptions *options = nullptr;
     std::vector<std::string> params;
 
     explicit operator bool() const noexcept { return handler != nullptr; }
@@ -116,6 +116,11 @@ public:
     // Send frame (for streams)
     Task<expected<void, Error>> send_frame(std::span<const uint8_t> frame_data);
     
+    // Send a frame header and its payload in one gathered write, without
+    // copying the payload
+    Task<expected<void, Error>> send_frame(const FrameHeader& header,
+                                           std::span<const uint8_t> payload);
+    
     // Get underlying connection (for streams)
     net::Connection& connection() { return *conn_; }
     
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "coroute/util/expected.hpp"
+#include "coroute/core/error.hpp"
+
+namespace coroute::net {
+
+// ============================================================================
+// SocketAddress - Raw sockaddr produced from an Endpoint
+// ============================================================================
+
+// Sized and aligned like sockaddr_storage, so the public headers need no
+// platform socket includes. `domain` is the AF_* value to pass to socket().
+struct SocketAddress {
+    alignas(8) unsigned char storage[128]{};
+    uint32_t size = 0;
+    int domain = 0;
+
+    const void* data() const noexcept { return storage; }
+    void* data() noexcept { return storage; }
+};
+
+// ============================================================================
+// Endpoint - Where a listener binds
+// ============================================================================
+
+// A TCP address (wildcard, IPv4 or IPv6 literal) or a Unix domain socket
+// path. The wildcard binds dual-stack [::] and falls back to 0.0.0.0 on hosts
+// without IPv6. Text form, as accepted by parse() and produced by to_string():
+//
+//   8080  *:8080  0.0.0.0:8080  127.0.0.1:8080  [::]:8080  [::1]:8080
+//   unix:/run/app.sock  unix:@app  (abstract namespace, Linux only)
+class Endpoint {
+public:
+    enum class Family : uint8_t {
+        Any,    // All interfaces, dual-stack where available
+        IPv4,
+        IPv6,
+        Unix
+    };
+
+    // Wildcard, port 0 (ephemeral)
+    Endpoint() = default;
+
+    static Endpoint any(uint16_t port);
+    static Endpoint ipv4(std::string_view address, uint16_t port);
+    // v6_only = false also accepts IPv4 clients when bound to [::]
+    static Endpoint ipv6(std::string_view address, uint16_t port, bool v6_only = false);
+    static Endpoint unix_socket(std::string_view path);
+    static Endpoint abstract_socket(std::string_view name);
+
+    static expected<Endpoint, Error> parse(std::string_view text);
+
+    // Build from a platform sockaddr (accepted peers, getsockname())
+    static Endpoint from_sockaddr(const void* addr, size_t size);
+
+    // Convert for bind(); fails on malformed literals or over-long paths
+    expected<SocketAddress, Error> to_sockaddr() const;
+
+    Family family() const noexcept { return family_; }
+    bool is_unix() const noexcept { return family_ == Family::Unix; }
+    bool is_abstract() const noexcept { return abstract_; }
+    bool v6_only() const noexcept { return v6_only_; }
+
+    // IP literal (empty for Any) or socket path / abstract name
+    const std::string& address() const noexcept { return address_; }
+    uint16_t port() const noexcept { return port_; }
+
+    // Same address with another port (used once an ephemeral port is bound)
+    Endpoint with_port(uint16_t port) const;
+
+    std::string to_string() const;
+
+    bool operator==(const Endpoint&) const = default;
+
+private:
+    Family family_ = Family::Any;
+    bool abstract_ = false;
+    bool v6_only_ = false;
+    uint16_t port_ = 0;
+    std::string address_;
+};
+
+#ifndef _WIN32
+namespace detail {
+
+// Create, bind and listen a non-blocking, close-on-exec stream socket.
+// Stale Unix socket files left by a dead process are replaced; a live one
+// fails with AddressInUse. Returns the listening fd.
+expected<int, Error> open_listen_socket(const Endpoint& endpoint, int backlog,
+                                        bool reuse_port = false);
+
+// Bound address of a socket (resolves ephemeral ports)
+Endpoint local_endpoint(int fd);
+
+} // namespace detail
+#endif
+
+} // namespace coroute::net
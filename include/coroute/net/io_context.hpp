@@ -1,11 +1,19 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <functional>
 #include <chrono>
+#include <string>
+#include <span>
+#include <string_view>
+#include <vector>
 
 #include "coroute/util/expected.hpp"
+#include "coroute/util/mpsc_queue.hpp"
+#include "coroute/net/endpoint.hpp"
+#include "coroute/util/timer_wheel.hpp"
 #include "coroute/core/error.hpp"
 #include "coroute/coro/task.hpp"
 #include "coroute/coro/cancellation.hpp"
@@ -23,6 +31,102 @@ class Connection;
 // Connection handler callback for multi-accept
 using ConnectionHandler = std::function<void(std::unique_ptr<Connection>)>;
 
+class ResumeOnAwaiter;
+
+// Intrusive unit of work for IoContext::post_task(). The poster owns the
+// node, which must stay alive until `run` has been invoked on the target ring.
+struct PostedTask : MpscNode {
+    void (*run)(PostedTask& task) = nullptr;
+    void (*discard)(PostedTask& task) = nullptr;  // If the context dies first
+};
+
+// Per-ring submission counters (io_uring backend)
+struct RingStats {
+    uint64_t submit_calls = 0;      // io_uring_enter calls that submitted work
+    uint64_t sqes_submitted = 0;    // Total SQEs handed to the kernel
+    uint64_t sq_full_flushes = 0;   // Forced flushes because the SQ was full
+    uint64_t cq_overflows = 0;      // Passes that found completions in the kernel's overflow list
+    
+    // Worker time split, in nanoseconds
+    uint64_t busy_ns = 0;           // Handling completions, timers and posts
+    uint64_t spin_ns = 0;           // Polling the CQ without sleeping
+    uint64_t idle_ns = 0;           // Blocked in the kernel waiting for work
+    
+    // Multi-accept locality (TCP): connections whose packets the kernel
+    // processed on a different CPU than the accepting worker's
+    uint64_t accepts = 0;
+    uint64_t cross_core_accepts = 0;
+    
+    // Connections currently assigned to the ring
+    uint64_t connections = 0;
+
+    // Average batching factor (SQEs per submit call)
+    double sqes_per_submit() const noexcept {
+        return submit_calls ? static_cast<double>(sqes_submitted) / submit_calls : 0.0;
+    }
+    
+    double cross_core_fraction() const noexcept {
+        return accepts ? static_cast<double>(cross_core_accepts) / accepts : 0.0;
+    }
+    
+    // Fraction of wall time the worker held its core (busy + spinning)
+    double cpu_fraction() const noexcept {
+        uint64_t total = busy_ns + spin_ns + idle_ns;
+        return total ? static_cast<double>(busy_ns + spin_ns) / total : 0.0;
+    }
+};
+
+// How an idle worker waits for completions
+enum class WaitPolicy {
+    Block,          // Sleep in the kernel until a completion arrives
+    SpinThenBlock,  // Poll briefly (budget adapts to arrival rate), then sleep
+    BusyPoll        // Never sleep; lowest latency, one core per worker
+};
+
+// Settings for IoContext::create(). Backends ignore what they do not support;
+// io_uring setup flags the kernel rejects are dropped one at a time until the
+// ring can be created (see IoContext::features() for the outcome).
+struct IoContextOptions {
+    size_t threads = 1;
+
+    // Ring sizing (io_uring)
+    unsigned sq_entries = 8192;
+    unsigned cq_entries = 0;        // 0 = kernel default (2 x sq_entries)
+
+    // Kernel submission-polling thread per ring (IORING_SETUP_SQPOLL).
+    // With sqpoll_cpu >= 0, ring i's poller is pinned to CPU sqpoll_cpu + i.
+    bool sqpoll = false;
+    int sqpoll_cpu = -1;
+    std::chrono::milliseconds sqpoll_idle{1000};
+
+    // Run completion work only when the worker asks for it
+    // (IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN). All
+    // submissions for a ring must then come from its worker thread.
+    bool single_issuer = false;
+
+    // Don't interrupt a busy worker to run completion work (COOP_TASKRUN)
+    bool coop_taskrun = false;
+
+    // Send writes of at least this many bytes with IORING_OP_SEND_ZC
+    // (0 = never). The write completes once the kernel has released the
+    // buffer, which on TCP can take until the data is acknowledged; see the
+    // zerocopy_benchmark sample for picking a crossover on your hardware.
+    size_t zerocopy_send_threshold = 0;
+
+    WaitPolicy wait_policy = WaitPolicy::SpinThenBlock;
+    std::chrono::microseconds max_spin{50};
+
+    // Pin ring i's worker to CPU cpu_affinity[i % size()] (empty = unpinned).
+    // Each ring and its provided buffers are then allocated from a thread on
+    // that CPU, so first-touch places them on the worker's NUMA node.
+    std::vector<int> cpu_affinity;
+
+    // With pinned workers and TCP multi-accept, give each new connection to
+    // the ring pinned to the CPU that received its packets (SO_INCOMING_CPU,
+    // via SO_ATTACH_REUSEPORT_CBPF) rather than to the kernel's hash pick
+    bool steer_connections = true;
+};
+
 class IoContext {
 public:
     virtual ~IoContext() = default;
@@ -42,24 +146,184 @@ public:
     // Post a callback to be executed in the event loop
     virtual void post(std::function<void()> callback) = 0;
 
+    // Post a callback to a specific worker ring (io_uring). Backends with a
+    // single shared queue ignore the index.
+    virtual void post(size_t ring_index, std::function<void()> callback) {
+        (void)ring_index;
+        post(std::move(callback));
+    }
+
+    // Allocation-free variant of post(ring_index, fn) for intrusive tasks
+    virtual void post_task(size_t ring_index, PostedTask& task) {
+        post(ring_index, [&task] { task.run(task); });
+    }
+
+    // Number of independently driven worker rings
+    virtual size_t ring_count() const noexcept { return 1; }
+
+    // True if the calling thread is the worker that drives `ring_index`
+    virtual bool is_current_ring(size_t ring_index) const noexcept {
+        (void)ring_index;
+        return false;
+    }
+
+    // Hop the awaiting coroutine onto another ring's worker thread:
+    //   co_await ctx.resume_on(2);
+    ResumeOnAwaiter resume_on(size_t ring_index) noexcept;
+
     // Schedule a callback after a delay
     virtual void schedule(std::chrono::milliseconds delay, std::function<void()> callback) = 0;
 
     // Enable multi-accept mode (SO_REUSEPORT on Linux)
     // Each worker thread accepts on its own listener for better scalability
     // Returns false if not supported or failed
-    virtual bool enable_multi_accept(uint16_t port, ConnectionHandler handler, int backlog = 1024) {
-        (void)port; (void)handler; (void)backlog;
+    virtual bool enable_multi_accept(const Endpoint& endpoint, ConnectionHandler handler,
+                                     int backlog = 1024) {
+        (void)endpoint; (void)handler; (void)backlog;
         return false;  // Default: not supported
     }
     
+    // Multi-accept on all interfaces
+    bool enable_multi_accept(uint16_t port, ConnectionHandler handler, int backlog = 1024) {
+        return enable_multi_accept(Endpoint::any(port), std::move(handler), backlog);
+    }
+    
+    // Address the multi-accept listeners are bound to (ephemeral port resolved)
+    virtual Endpoint multi_accept_endpoint() const { return Endpoint{}; }
+    
     // Check if multi-accept is enabled
     virtual bool is_multi_accept_enabled() const noexcept { return false; }
 
-    // Factory method - creates platform-appropriate context
+    // Stop taking connections off the multi-accept listeners while paused.
+    // New clients then wait in the kernel's listen backlog, which is how a
+    // server at its connection limit pushes back. Safe from any thread.
+    virtual void set_accept_paused(bool paused) { (void)paused; }
+
+    // Stop the multi-accept listeners for good, as a graceful shutdown does.
+    // New clients are refused; connections already accepted carry on.
+    // Safe from any thread.
+    virtual void close_multi_accept() {}
+
+    // Deferred submission: queue SQEs during a completion pass and flush them
+    // with a single syscall at the top of the worker loop (io_uring only).
+    // Enabled by default; disable to submit every operation immediately.
+    // Either way a ring's SQ is only written by its own worker: I/O started
+    // from another thread is handed to that worker (connections resume
+    // there), so the setting never leaves an SQE unflushed off the worker.
+    virtual void set_deferred_submit(bool enabled) { (void)enabled; }
+
+    // Idle wait strategy for worker threads (io_uring). SpinThenBlock, the
+    // default, spins for at most max_spin, less when completions have been
+    // arriving further apart than that.
+    virtual void set_wait_policy(WaitPolicy policy,
+                                 std::chrono::microseconds max_spin = std::chrono::microseconds(50)) {
+        (void)policy; (void)max_spin;
+    }
+
+    // Submission statistics, one entry per ring (empty if not supported)
+    virtual std::vector<RingStats> ring_stats() const { return {}; }
+
+    // Enable kernel-provided read buffers (io_uring buffer rings + multishot
+    // recv). Each ring shares buffer_count buffers of buffer_size bytes, and a
+    // buffer is only taken when data arrives. Read deadlines run on the
+    // ring's timer wheel, so the multishot stays armed across reads.
+    // Must be called before run(). Returns false if not supported or
+    // registration failed.
+    virtual bool enable_provided_buffers(size_t buffer_size = 4096, unsigned buffer_count = 4096) {
+        (void)buffer_size; (void)buffer_count;
+        return false;  // Default: not supported
+    }
+
+    // Human-readable summary of the backend and the features actually in use
+    virtual std::string features() const { return {}; }
+
+    // Factory methods - create the platform-appropriate context
     static std::unique_ptr<IoContext> create(size_t thread_count = 1);
+    static std::unique_ptr<IoContext> create(const IoContextOptions& options);
+};
+
+inline std::unique_ptr<IoContext> IoContext::create(size_t thread_count) {
+    IoContextOptions options;
+    options.threads = thread_count;
+    return create(options);
+}
+
+// Awaitable returned by IoContext::resume_on(). The awaiter itself is the
+// posted node, so the hop lives in the coroutine frame and never allocates.
+class ResumeOnAwaiter : public PostedTask {
+public:
+    ResumeOnAwaiter(IoContext& ctx, size_t ring_index) noexcept
+        : ctx_(ctx), ring_index_(ring_index) {}
+
+    bool await_ready() const noexcept {
+        return ctx_.is_current_ring(ring_index_);
+    }
+
+    void await_suspend(std::coroutine_handle<> h) {
+        handle_ = h;
+        run = [](PostedTask& task) {
+            static_cast<ResumeOnAwaiter&>(task).handle_.resume();
+        };
+        ctx_.post_task(ring_index_, *this);
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    IoContext& ctx_;
+    size_t ring_index_;
+    std::coroutine_handle<> handle_;
 };
 
+inline ResumeOnAwaiter IoContext::resume_on(size_t ring_index) noexcept {
+    return ResumeOnAwaiter(*this, ring_index);
+}
+
+// ============================================================================
+// Timers - Awaitable sleeps on the worker's timer wheel
+// ============================================================================
+
+namespace detail {
+
+// Installed by a backend on each of its worker threads: arms `entry` on that
+// thread's timer wheel. Returns false if the timer could not be armed.
+using TimerArmFn = bool (*)(TimerEntry& entry, std::chrono::steady_clock::time_point deadline);
+void set_thread_timer_hook(TimerArmFn fn) noexcept;
+
+} // namespace detail
+
+// Suspends the awaiting coroutine until a deadline. On an I/O worker thread
+// this arms an intrusive timer (no allocation, no thread); elsewhere the
+// calling thread blocks until the deadline.
+class SleepAwaiter {
+public:
+    explicit SleepAwaiter(std::chrono::steady_clock::time_point deadline) noexcept
+        : deadline_(deadline) {}
+    
+    bool await_ready() const noexcept {
+        return deadline_ <= std::chrono::steady_clock::now();
+    }
+    
+    bool await_suspend(std::coroutine_handle<> h);
+    
+    void await_resume() const noexcept {}
+
+private:
+    std::chrono::steady_clock::time_point deadline_;
+    std::coroutine_handle<> handle_;
+    TimerEntry entry_;  // Unlinks itself if the frame is destroyed while armed
+};
+
+// co_await sleep_for(100ms);
+inline SleepAwaiter sleep_for(std::chrono::milliseconds duration) noexcept {
+    return SleepAwaiter(std::chrono::steady_clock::now() + duration);
+}
+
+// co_await deadline(start + 5s);
+inline SleepAwaiter deadline(std::chrono::steady_clock::time_point when) noexcept {
+    return SleepAwaiter(when);
+}
+
 // ============================================================================
 // Async Operations - Awaitables for coroutines
 // ============================================================================
@@ -68,9 +332,98 @@ public:
 using AcceptResult = expected<std::unique_ptr<Connection>, Error>;
 using ReadResult = expected<size_t, Error>;
 using WriteResult = expected<size_t, Error>;
+
+// One buffer of a gathered write. Same layout as POSIX struct iovec, so
+// backends can hand a span of these straight to sendmsg/writev.
+struct IoVec {
+    const void* data = nullptr;
+    size_t size = 0;
+
+    IoVec() = default;
+    IoVec(const void* d, size_t n) noexcept : data(d), size(n) {}
+    IoVec(std::string_view sv) noexcept : data(sv.data()), size(sv.size()) {}
+};
 using ConnectResult = expected<void, Error>;
 using TransmitResult = expected<size_t, Error>;
 
+// ============================================================================
+// BufferLease - Received data borrowed from a buffer pool
+// ============================================================================
+
+// A chunk of received data that is handed out without copying it into
+// caller memory. The buffer returns to its owner when the lease is reset or
+// destroyed. Leases from the io_uring provided-buffer pool must be released
+// on the worker thread that owns the connection.
+class BufferLease {
+public:
+    using ReleaseFn = void (*)(void* owner, uint32_t id) noexcept;
+
+    BufferLease() = default;
+    
+    BufferLease(const char* data, size_t size, ReleaseFn release, void* owner, uint32_t id) noexcept
+        : data_(data), size_(size), release_(release), owner_(owner), id_(id) {}
+    
+    // Lease over heap storage (used when no shared pool is available)
+    static BufferLease owning(std::unique_ptr<char[]> storage, size_t size) noexcept {
+        char* data = storage.release();
+        return BufferLease(data, size, [](void* owner, uint32_t) noexcept {
+            delete[] static_cast<char*>(owner);
+        }, data, 0);
+    }
+    
+    ~BufferLease() { reset(); }
+    
+    BufferLease(BufferLease&& other) noexcept
+        : data_(other.data_), size_(other.size_), release_(other.release_)
+        , owner_(other.owner_), id_(other.id_) {
+        other.release_ = nullptr;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    
+    BufferLease& operator=(BufferLease&& other) noexcept {
+        if (this != &other) {
+            reset();
+            data_ = other.data_;
+            size_ = other.size_;
+            release_ = other.release_;
+            owner_ = other.owner_;
+            id_ = other.id_;
+            other.release_ = nullptr;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+    
+    BufferLease(const BufferLease&) = delete;
+    BufferLease& operator=(const BufferLease&) = delete;
+    
+    const char* data() const noexcept { return data_; }
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    std::string_view view() const noexcept { return {data_, size_}; }
+    
+    // Return the buffer to its owner early
+    void reset() noexcept {
+        if (release_) {
+            release_(owner_, id_);
+            release_ = nullptr;
+        }
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    ReleaseFn release_ = nullptr;
+    void* owner_ = nullptr;
+    uint32_t id_ = 0;
+};
+
+using LeaseResult = expected<BufferLease, Error>;
+
 // Platform-specific file handle type
 #ifdef _WIN32
 using FileHandle = void*;  // HANDLE
@@ -86,10 +439,17 @@ class Listener {
 public:
     virtual ~Listener() = default;
 
-    // Start listening on the specified port
-    virtual expected<void, Error> listen(uint16_t port, int backlog = 128) = 0;
+    // Start listening on an address or Unix domain socket
+    virtual expected<void, Error> listen(const Endpoint& endpoint, int backlog = 128) = 0;
     
-    // Accept a connection (coroutine)
+    // Start listening on the specified port on all interfaces
+    expected<void, Error> listen(uint16_t port, int backlog = 128) {
+        return listen(Endpoint::any(port), backlog);
+    }
+    
+    // Accept a connection (coroutine). Backends with several rings assign
+    // the connection to the least-loaded ring and resume the caller there,
+    // so the connection's coroutine should be started right after.
     virtual Task<AcceptResult> async_accept() = 0;
     
     // Close the listener
@@ -98,8 +458,11 @@ public:
     // Check if listening
     virtual bool is_listening() const noexcept = 0;
 
-    // Get local port
+    // Get local port (0 for Unix domain sockets)
     virtual uint16_t local_port() const noexcept = 0;
+    
+    // Get the bound address
+    virtual Endpoint local_endpoint() const { return Endpoint::any(local_port()); }
 
     // Factory method
     static std::unique_ptr<Listener> create(IoContext& ctx);
@@ -122,9 +485,43 @@ public:
     // Async write from buffer
     virtual Task<WriteResult> async_write(const void* buffer, size_t len) = 0;
     
+    // Read the next chunk of received data as a lease, without the caller
+    // holding a buffer while the read is pending. Returns at most max_len
+    // bytes. The default implementation reads into a heap buffer.
+    virtual Task<LeaseResult> async_read_lease(size_t max_len = 16384) {
+        auto storage = std::make_unique<char[]>(max_len);
+        auto result = co_await async_read(storage.get(), max_len);
+        if (!result) {
+            co_return unexpected(result.error());
+        }
+        co_return BufferLease::owning(std::move(storage), *result);
+    }
+    
+    // True when async_read_lease() draws from a shared pool, so idle
+    // connections hold no read memory
+    virtual bool supports_read_lease() const noexcept { return false; }
+    
     // Async write all data (loops until complete)
     virtual Task<WriteResult> async_write_all(const void* buffer, size_t len) = 0;
     
+    // Write all buffers in order, as if concatenated (loops until complete).
+    // Backends send them with a single gathered write where they can; the
+    // default writes each buffer in turn. Returns the total bytes written.
+    virtual Task<WriteResult> async_writev(std::span<const IoVec> buffers) {
+        size_t total = 0;
+        for (const auto& buf : buffers) {
+            if (buf.size == 0) {
+                continue;
+            }
+            auto result = co_await async_write_all(buf.data, buf.size);
+            if (!result) {
+                co_return unexpected(result.error());
+            }
+            total += *result;
+        }
+        co_return total;
+    }
+    
     // Zero-copy file transfer (TransmitFile on Windows, sendfile on Linux)
     // Returns bytes transmitted
     virtual Task<TransmitResult> async_transmit_file(FileHandle file, 
@@ -140,14 +537,25 @@ public:
     // Set read/write timeout
     virtual void set_timeout(std::chrono::milliseconds timeout) = 0;
 
-    // Get remote address (as string for now)
+    // Per-direction deadline applied to each subsequent read or write; an
+    // operation that misses it fails with Error::timeout(). Zero disables.
+    // Backends without separate deadlines apply both through set_timeout().
+    virtual void set_read_timeout(std::chrono::milliseconds timeout) { set_timeout(timeout); }
+    virtual void set_write_timeout(std::chrono::milliseconds timeout) { set_timeout(timeout); }
+
+    // Get remote address (as string for now); IP literal, or the peer's
+    // socket path for Unix domain sockets (usually empty)
     virtual std::string remote_address() const = 0;
     
-    // Get remote port
+    // Get remote port (0 for Unix domain sockets)
     virtual uint16_t remote_port() const noexcept = 0;
 
     // Set cancellation token for this connection
     virtual void set_cancellation_token(CancellationToken token) = 0;
+
+    // Socket descriptor, for layers that hand work to the kernel (kTLS), or
+    // -1 when there is none (wrapping connections, Windows)
+    virtual int native_socket() const noexcept { return -1; }
 };
 
 } // namespace coroute::net
@@ -2,12 +2,19 @@
 
 #ifdef COROUTE_HAS_TLS
 
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <filesystem>
 #include <functional>
+#include <list>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 
 #include "coroute/net/io_context.hpp"
 #include "coroute/coro/task.hpp"
@@ -20,6 +27,86 @@ typedef struct ssl_ctx_st SSL_CTX;
 
 namespace coroute::net {
 
+// ============================================================================
+// Session Resumption
+// ============================================================================
+
+// Session ticket encryption key, in the file format nginx uses for
+// ssl_session_ticket_key: 80 bytes (16 name, 32 HMAC secret, 32 AES-256
+// key) or 48 bytes (16 name, 16 HMAC secret, 16 AES-128 key)
+struct TicketKey {
+    std::array<uint8_t, 16> name{};
+    std::vector<uint8_t> hmac_secret;
+    std::vector<uint8_t> aes_key;
+    
+    // New random 80-byte key
+    static TicketKey generate();
+    static expected<TicketKey, Error> load(const std::filesystem::path& path);
+    expected<void, Error> save(const std::filesystem::path& path) const;
+};
+
+// Server-side session store, keyed by session ID, for stateful resumption
+// by any worker, process or node that shares it. Sessions are opaque DER
+// blobs. Called from worker threads concurrently, so implementations must
+// be thread-safe.
+class SessionCache {
+public:
+    virtual ~SessionCache() = default;
+    
+    virtual void store(std::string_view id, std::string session) = 0;
+    virtual std::optional<std::string> load(std::string_view id) = 0;
+    virtual void remove(std::string_view id) = 0;
+};
+
+// In-memory SessionCache split into independently locked stripes (chosen by
+// ID hash), so concurrent handshakes rarely contend. Each stripe drops its
+// oldest entry when full; entries expire after `ttl`.
+class StripedMemorySessionCache : public SessionCache {
+public:
+    explicit StripedMemorySessionCache(size_t capacity = 20480, size_t stripes = 16,
+                                       std::chrono::seconds ttl = std::chrono::hours(2));
+    
+    void store(std::string_view id, std::string session) override;
+    std::optional<std::string> load(std::string_view id) override;
+    void remove(std::string_view id) override;
+    
+    size_t size() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    
+    struct Entry {
+        std::string session;
+        Clock::time_point expires;
+        std::list<std::string>::iterator order;
+    };
+    
+    struct Stripe {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, Entry> entries;
+        std::list<std::string> order;  // Oldest first
+    };
+    
+    Stripe& stripe_for(std::string_view id);
+    
+    std::vector<std::unique_ptr<Stripe>> stripes_;
+    size_t stripe_capacity_;
+    std::chrono::seconds ttl_;
+};
+
+// Handshake counters of a TlsContext
+struct TlsStats {
+    uint64_t handshakes = 0;        // Completed handshakes
+    uint64_t resumed = 0;           // ... of which resumed a session
+    uint64_t tickets_renewed = 0;   // Tickets under a previous key, reissued
+    uint64_t cache_hits = 0;        // SessionCache lookups that found a session
+    uint64_t cache_misses = 0;
+    
+    double resumption_rate() const noexcept {
+        return handshakes > 0 ? static_cast<double>(resumed) / static_cast<double>(handshakes) : 0.0;
+    }
+};
+
 // ============================================================================
 // TLS Configuration
 // ============================================================================
@@ -52,6 +139,24 @@ struct TlsConfig {
     
     // Session cache size (0 = disabled)
     size_t session_cache_size = 20480;
+    
+    // Ticket keys shared by every process that should resume the others'
+    // sessions. The first file encrypts new tickets; the rest are previous
+    // keys that still decrypt, and their tickets are reissued under the
+    // current one. Empty = a random key per process.
+    std::vector<std::filesystem::path> ticket_key_files;
+    
+    // External session cache, replacing OpenSSL's internal one. With TLS 1.3
+    // it serves resumption when session_tickets is false.
+    std::shared_ptr<SessionCache> session_cache;
+    
+    // Hand encryption of sent records to the kernel after the handshake
+    // (Linux kTLS), so writes skip OpenSSL and files go out with
+    // sendfile/splice. Applies to TLS 1.3 with AES-GCM or ChaCha20-Poly1305;
+    // other connections, and kernels without the tls module, silently stay
+    // on OpenSSL. Received records are still decrypted by OpenSSL, and a
+    // peer KeyUpdate that asks for ours ends the connection.
+    bool kernel_tls = false;
 };
 
 // ============================================================================
@@ -84,11 +189,27 @@ public:
     
     // Set SNI callback for virtual hosting
     void set_sni_callback(SniCallback callback);
+    
+    // Whether connections try to switch to kernel TLS after the handshake
+    bool kernel_tls() const noexcept { return kernel_tls_; }
+    
+    // Replace the ticket keys (rotation); keys[0] encrypts new tickets
+    void set_ticket_keys(std::vector<TicketKey> keys);
+    
+    // Re-read TlsConfig::ticket_key_files, keeping the old keys on failure
+    expected<void, Error> reload_ticket_keys();
+    
+    TlsStats stats() const;
 
 private:
+    friend class TlsConnection;
+    struct State;
+    
     TlsContext() = default;
     SSL_CTX* ctx_ = nullptr;
+    bool kernel_tls_ = false;
     SniCallback sni_callback_;
+    std::unique_ptr<State> state_;  // Stable address for OpenSSL callbacks
 };
 
 // ============================================================================
@@ -106,19 +227,24 @@ public:
         bool is_server = true
     );
     
-    // Perform TLS handshake
-    Task<expected<void, Error>> handshake();
+    // Perform TLS handshake. A non-zero timeout bounds the whole exchange
+    // (not each read), failing with Error::timeout() once it runs out.
+    Task<expected<void, Error>> handshake(
+        std::chrono::milliseconds timeout = std::chrono::milliseconds::zero());
     
     // Connection interface
     Task<ReadResult> async_read(void* buffer, size_t len) override;
     Task<ReadResult> async_read_until(void* buffer, size_t len, char delimiter) override;
     Task<WriteResult> async_write(const void* data, size_t len) override;
     Task<WriteResult> async_write_all(const void* data, size_t len) override;
+    Task<WriteResult> async_writev(std::span<const IoVec> buffers) override;
     Task<TransmitResult> async_transmit_file(
         FileHandle file, size_t offset, size_t length) override;
     void close() override;
     bool is_open() const noexcept override;
     void set_timeout(std::chrono::milliseconds timeout) override;
+    void set_read_timeout(std::chrono::milliseconds timeout) override;
+    void set_write_timeout(std::chrono::milliseconds timeout) override;
     std::string remote_address() const override;
     uint16_t remote_port() const noexcept override;
     void set_cancellation_token(CancellationToken token) override;
@@ -136,21 +262,34 @@ public:
     
     // Get TLS version string
     std::string_view tls_version() const;
+    
+    // Whether the kernel encrypts sent records (kTLS). Received records are
+    // always decrypted by OpenSSL.
+    bool kernel_tls_tx() const noexcept;
 
 private:
+    struct KernelTls;
+    friend struct RecordBio;
+    
     TlsConnection() = default;
     
     std::unique_ptr<Connection> inner_;
     SSL* ssl_ = nullptr;
     TlsContext* ctx_ = nullptr;
+    std::unique_ptr<KernelTls> ktls_;  // Only when TlsContext::kernel_tls()
     
-    // BIO pair for async I/O (using void* to avoid including OpenSSL headers)
-    void* rbio_ = nullptr;  // Read BIO (network -> SSL)
-    void* wbio_ = nullptr;  // Write BIO (SSL -> network)
+    // Ciphertext buffers behind the connection's BIO: OpenSSL reads
+    // received records straight out of the inner connection's buffers and
+    // appends outgoing records to one pooled buffer, sent in a single write
+    // per flush
+    struct RecordBuffers;
+    std::unique_ptr<RecordBuffers> records_;
     
     // Internal helpers
     Task<expected<void, Error>> flush_write_bio();
     Task<expected<void, Error>> fill_read_bio();
+    void enable_kernel_tls(size_t tx_records);
+    Task<TransmitResult> transmit_file_buffered(FileHandle file, size_t offset, size_t length);
 };
 
 // ============================================================================
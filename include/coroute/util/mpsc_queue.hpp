@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+
+namespace coroute {
+
+// ============================================================================
+// MpscNode - Intrusive link for MpscQueue
+// ============================================================================
+
+struct MpscNode {
+    std::atomic<MpscNode*> mpsc_next{nullptr};
+
+    MpscNode() = default;
+    MpscNode(const MpscNode&) = delete;
+    MpscNode& operator=(const MpscNode&) = delete;
+};
+
+// ============================================================================
+// MpscQueue - Intrusive lock-free multi-producer / single-consumer queue
+// ============================================================================
+
+// Vyukov-style queue: push() is wait-free (one atomic exchange) and never
+// allocates, pop() is lock-free and must only be called by one consumer.
+// pop() may briefly return nullptr while a producer is between its exchange
+// and link steps; that producer's item becomes visible right after.
+// T must derive from MpscNode; nodes must outlive their time in the queue.
+template<typename T>
+class MpscQueue {
+    alignas(64) std::atomic<MpscNode*> head_;  // Producers append here
+    alignas(64) MpscNode* tail_;               // Consumer reads here
+    MpscNode stub_;
+
+public:
+    MpscQueue() noexcept : head_(&stub_), tail_(&stub_) {}
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Enqueue a node (any thread)
+    void push(T& item) noexcept {
+        push_node(static_cast<MpscNode*>(&item));
+    }
+
+    // Dequeue a node (consumer thread only); nullptr if nothing is ready
+    T* pop() noexcept {
+        MpscNode* tail = tail_;
+        MpscNode* next = tail->mpsc_next.load(std::memory_order_acquire);
+
+        if (tail == &stub_) {
+            if (!next) {
+                return nullptr;
+            }
+            tail_ = next;
+            tail = next;
+            next = next->mpsc_next.load(std::memory_order_acquire);
+        }
+
+        if (next) {
+            tail_ = next;
+            return static_cast<T*>(tail);
+        }
+
+        // `tail` is the last linked node; unless a producer is mid-push,
+        // re-insert the stub behind it so it can be handed out
+        if (tail != head_.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        push_node(&stub_);
+
+        next = tail->mpsc_next.load(std::memory_order_acquire);
+        if (next) {
+            tail_ = next;
+            return static_cast<T*>(tail);
+        }
+        return nullptr;
+    }
+
+    // Consumer-side check; may report empty while a push is in progress
+    bool empty() const noexcept {
+        return tail_ == &stub_ && stub_.mpsc_next.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    void push_node(MpscNode* node) noexcept {
+        node->mpsc_next.store(nullptr, std::memory_order_relaxed);
+        MpscNode* prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->mpsc_next.store(node, std::memory_order_release);
+    }
+};
+
+} // namespace coroute
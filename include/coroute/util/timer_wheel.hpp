@@ -0,0 +1,291 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace coroute {
+
+class TimerWheel;
+
+// ============================================================================
+// TimerEntry - Intrusive node for TimerWheel
+// ============================================================================
+
+// Embedded in the object that owns the timer; the wheel never allocates.
+// An entry must stay alive (or be cancelled) while it is armed.
+struct TimerEntry {
+    using Callback = void (*)(TimerEntry& entry);
+
+    Callback on_expire = nullptr;
+    void* user_data = nullptr;
+
+    TimerEntry() = default;
+    ~TimerEntry() { unlink(); }
+
+    TimerEntry(const TimerEntry&) = delete;
+    TimerEntry& operator=(const TimerEntry&) = delete;
+
+    bool armed() const noexcept { return next_ != nullptr; }
+    uint64_t expiry() const noexcept { return expiry_; }
+
+private:
+    friend class TimerWheel;
+
+    TimerWheel* wheel_ = nullptr;    // Wheel counting us while armed
+    TimerEntry* prev_ = nullptr;
+    TimerEntry* next_ = nullptr;
+    uint64_t expiry_ = 0;
+    uint64_t* slot_bits_ = nullptr;  // Occupancy word of the slot holding us
+    uint64_t slot_mask_ = 0;
+
+    // Disarm, keeping the owning wheel's size() in step
+    inline void unlink() noexcept;
+
+    // Take the entry off its slot list without touching the wheel's count
+    void detach() noexcept {
+        if (!next_) return;
+        prev_->next_ = next_;
+        next_->prev_ = prev_;
+        // The slot's sentinel points to itself once the last entry is gone
+        if (next_ == prev_ && next_->next_ == next_ && slot_bits_) {
+            *slot_bits_ &= ~slot_mask_;
+        }
+        prev_ = next_ = nullptr;
+        slot_bits_ = nullptr;
+    }
+};
+
+// ============================================================================
+// TimerWheel - Hierarchical timing wheel (4 levels x 256 slots)
+// ============================================================================
+
+// Time is measured in abstract ticks (the io_uring backend uses 1 ms).
+// schedule() and cancel() are O(1); advance() fires everything that has
+// expired, cascading entries from coarser levels as their slot comes due.
+// Deadlines further out than 2^32 ticks are parked in the last level and
+// re-filed as they approach. Not thread-safe: one wheel per worker thread.
+class TimerWheel {
+public:
+    static constexpr unsigned LEVELS = 4;
+    static constexpr unsigned SLOT_BITS = 8;
+    static constexpr unsigned SLOTS = 1u << SLOT_BITS;
+    static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+
+    explicit TimerWheel(uint64_t now = 0) noexcept : now_(now) {
+        for (auto& level : slots_) {
+            for (auto& head : level) {
+                head.prev_ = head.next_ = &head;
+            }
+        }
+        for (auto& level : occupied_) {
+            level.fill(0);
+        }
+    }
+
+    // Entries still armed are detached, not fired
+    ~TimerWheel() {
+        for (auto& level : slots_) {
+            for (auto& head : level) {
+                TimerEntry* e = head.next_;
+                while (e != &head) {
+                    TimerEntry* next = e->next_;
+                    e->prev_ = e->next_ = nullptr;
+                    e->slot_bits_ = nullptr;
+                    e->wheel_ = nullptr;
+                    e = next;
+                }
+                head.prev_ = head.next_ = nullptr;
+            }
+        }
+    }
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // Arm (or re-arm) an entry to fire at the given tick. Deadlines at or
+    // before now() fire on the next advance().
+    void schedule(TimerEntry& entry, uint64_t expiry) noexcept {
+        if (entry.armed()) {
+            cancel(entry);
+        }
+        entry.expiry_ = expiry;
+        entry.wheel_ = this;
+        insert(entry, now_ + 1);
+        ++size_;
+    }
+
+    // Disarm an entry; no-op if it is not armed
+    void cancel(TimerEntry& entry) noexcept {
+        entry.unlink();
+    }
+
+    // Move time forward to `now`, firing expired entries in deadline order
+    // (per tick). Callbacks may schedule or cancel other entries.
+    // Returns the number of entries fired.
+    size_t advance(uint64_t now) {
+        size_t fired = 0;
+        while (now_ < now) {
+            if (size_ == 0) {
+                now_ = now;
+                break;
+            }
+            ++now_;
+
+            // Cascade coarser levels whose slot starts at this tick
+            if ((now_ & SLOT_MASK) == 0) {
+                for (unsigned level = LEVELS - 1; level > 0; --level) {
+                    if ((now_ & ((uint64_t(1) << (level * SLOT_BITS)) - 1)) == 0) {
+                        cascade(level, (now_ >> (level * SLOT_BITS)) & SLOT_MASK);
+                    }
+                }
+            }
+
+            fired += fire_slot(now_ & SLOT_MASK);
+        }
+        return fired;
+    }
+
+    // Earliest tick at which advance() has work to do (a level-0 expiry or a
+    // cascade), or nullopt if the wheel is empty
+    std::optional<uint64_t> next_expiry() const noexcept {
+        if (size_ == 0) {
+            return std::nullopt;
+        }
+
+        std::optional<uint64_t> best;
+        for (unsigned level = 0; level < LEVELS; ++level) {
+            unsigned shift = level * SLOT_BITS;
+            uint64_t current = now_ >> shift;
+            auto distance = next_occupied(level, static_cast<unsigned>((current + 1) & SLOT_MASK));
+            if (!distance) {
+                continue;
+            }
+            uint64_t tick = (current + 1 + *distance) << shift;
+            if (!best || tick < *best) {
+                best = tick;
+            }
+        }
+        return best;
+    }
+
+    uint64_t now() const noexcept { return now_; }
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+private:
+    friend struct TimerEntry;
+
+    std::array<std::array<TimerEntry, SLOTS>, LEVELS> slots_;
+    std::array<std::array<uint64_t, SLOTS / 64>, LEVELS> occupied_;
+    uint64_t now_;
+    size_t size_ = 0;
+
+    // File an entry by distance to its deadline; deadlines before
+    // `earliest` are treated as due at `earliest`
+    void insert(TimerEntry& entry, uint64_t earliest) noexcept {
+        uint64_t expiry = entry.expiry_ > earliest ? entry.expiry_ : earliest;
+        uint64_t delta = expiry - now_;
+
+        unsigned level = 0;
+        while (level < LEVELS - 1 && delta >= (uint64_t(1) << ((level + 1) * SLOT_BITS))) {
+            ++level;
+        }
+        if (level == LEVELS - 1) {
+            // Clamp beyond-range deadlines to the wheel's horizon
+            uint64_t horizon = now_ + (uint64_t(1) << (LEVELS * SLOT_BITS)) - 1;
+            if (expiry > horizon) {
+                expiry = horizon;
+            }
+        }
+
+        auto slot = static_cast<unsigned>((expiry >> (level * SLOT_BITS)) & SLOT_MASK);
+        TimerEntry& head = slots_[level][slot];
+        entry.prev_ = head.prev_;
+        entry.next_ = &head;
+        head.prev_->next_ = &entry;
+        head.prev_ = &entry;
+
+        entry.slot_bits_ = &occupied_[level][slot / 64];
+        entry.slot_mask_ = uint64_t(1) << (slot % 64);
+        *entry.slot_bits_ |= entry.slot_mask_;
+    }
+
+    // Detach a slot's entries onto a local sentinel so callbacks can freely
+    // modify the wheel (including cancelling entries still on the list)
+    static void take(TimerEntry& head, TimerEntry& local) noexcept {
+        local.prev_ = local.next_ = &local;
+        if (head.next_ == &head) {
+            return;
+        }
+        local.next_ = head.next_;
+        local.prev_ = head.prev_;
+        local.next_->prev_ = &local;
+        local.prev_->next_ = &local;
+        head.prev_ = head.next_ = &head;
+        for (TimerEntry* e = local.next_; e != &local; e = e->next_) {
+            e->slot_bits_ = nullptr;
+        }
+    }
+
+    void cascade(unsigned level, uint64_t slot) noexcept {
+        occupied_[level][slot / 64] &= ~(uint64_t(1) << (slot % 64));
+        TimerEntry local;
+        take(slots_[level][slot], local);
+        while (local.next_ != &local) {
+            TimerEntry* e = local.next_;
+            e->detach();
+            insert(*e, now_);
+        }
+        local.prev_ = local.next_ = nullptr;
+    }
+
+    size_t fire_slot(uint64_t slot) {
+        occupied_[0][slot / 64] &= ~(uint64_t(1) << (slot % 64));
+        TimerEntry local;
+        take(slots_[0][slot], local);
+        size_t fired = 0;
+        while (local.next_ != &local) {
+            TimerEntry* e = local.next_;
+            e->unlink();
+            ++fired;
+            if (e->on_expire) {
+                e->on_expire(*e);
+            }
+        }
+        local.prev_ = local.next_ = nullptr;
+        return fired;
+    }
+
+    // Distance (0-based, in slots) from `start` to the next occupied slot of
+    // a level, scanning circularly
+    std::optional<unsigned> next_occupied(unsigned level, unsigned start) const noexcept {
+        const auto& bits = occupied_[level];
+        for (unsigned scanned = 0; scanned < SLOTS;) {
+            unsigned index = (start + scanned) & SLOT_MASK;
+            uint64_t word = bits[index / 64] >> (index % 64);
+            if (word) {
+                unsigned found = scanned + static_cast<unsigned>(std::countr_zero(word));
+                if (found < SLOTS) {
+                    return found;
+                }
+                return std::nullopt;
+            }
+            scanned += 64 - (index % 64);
+        }
+        return std::nullopt;
+    }
+};
+
+inline void TimerEntry::unlink() noexcept {
+    if (!next_) return;
+    detach();
+    if (wheel_) {
+        --wheel_->size_;
+        wheel_ = nullptr;
+    }
+}
+
+} // namespace coroute
@@ -1,133 +1,140 @@
 #include "coroute/core/app.hpp"
+#include "coroute/core/form.hpp"
+#include "coroute/core/http_parser.hpp"
+#include "coroute/core/http_writer.hpp"
 #include "coroute/util/zero_copy.hpp"
 #include <cstring>
 #include <iostream>
+#include <optional>
 #include <sstream>
 #include <thread>
 
 namespace coroute {
 
-void App::run(uint16_t port) {
-  io_ctx_ = net::IoContext::create(thread_count_);
-
+// How often a paused accept loop looks again
+static constexpr std::chrono::milliseconds ACCEPT_PAUSE_POLL{5};
+
+void App::run(uint16_t port) { run(net::Endpoint::any(port)); }
+
+void App::run(const net::Endpoint &endpoint) {
+  auto io_options = io_options_;
+  io_options.threads = thread_count_;
+  io_ctx_ = net::IoContext::create(io_options);
+  configure_io_context();
+
+  // Each accepted socket is served by its own coroutine; for HTTPS that
+  // includes the handshake, so a slow client never holds up accepting
+  auto serve = [this](std::unique_ptr<net::Connection> conn) {
+    // Accepted past the connection limit (a race with pausing, or a backend
+    // that cannot pause): plain HTTP gets the 503, TLS is just closed
+    if (limits_.max_connections > 0 &&
+        active_connections_.load(std::memory_order_relaxed) >=
+            limits_.max_connections) {
+#ifdef COROUTE_HAS_TLS
+      if (tls_enabled_ && tls_ctx_) {
+        shed_requests_.fetch_add(1, std::memory_order_relaxed);
+        conn->close();
+        return;
+      }
+#endif
+      shed_connection(std::move(conn)).start_detached();
+      return;
+    }
+#ifdef COROUTE_HAS_TLS
+    if (tls_enabled_ && tls_ctx_) {
+      handle_tls_connection(std::move(conn)).start_detached();
+      return;
+    }
+#endif
+    handle_connection(std::move(conn)).start_detached();
+  };
+  const char *mode = "";
 #ifdef COROUTE_HAS_TLS
   if (tls_enabled_ && tls_ctx_) {
-    // TLS mode - use single listener
+    mode = " (HTTPS)";
+  }
+#endif
+
+  // Try to enable multi-accept (SO_REUSEPORT) for better scalability
+  // This must be done BEFORE creating a regular listener
+  bool multi_accept = io_ctx_->enable_multi_accept(endpoint, serve);
+
+  if (multi_accept) {
+    std::cout << "Server listening on "
+              << io_ctx_->multi_accept_endpoint().to_string() << mode
+              << " (multi-accept enabled)" << std::endl;
+  } else {
+    // Fall back to single-listener accept loop
     listener_ = net::Listener::create(*io_ctx_);
-    auto result = listener_->listen(port);
+    auto result = listener_->listen(endpoint);
     if (!result) {
       throw std::runtime_error("Failed to listen: " +
                                result.error().to_string());
     }
 
-    std::cout << "Server listening on port " << listener_->local_port()
-              << " (HTTPS)" << std::endl;
-    tls_listener_ =
-        std::make_unique<net::TlsListener>(std::move(listener_), *tls_ctx_);
+    std::cout << "Server listening on "
+              << listener_->local_endpoint().to_string() << mode << std::endl;
 
-    // TLS accept loop - use start_detached to keep it alive
-    [this]() -> Task<void> {
+    // Accept loop - use start_detached to keep it alive
+    [this, serve]() -> Task<void> {
       while (!cancel_source_.is_cancelled()) {
-        auto conn_result = co_await tls_listener_->accept();
+        if (accept_paused_.load(std::memory_order_relaxed)) {
+          co_await net::sleep_for(ACCEPT_PAUSE_POLL);
+          continue;
+        }
+        auto conn_result = co_await listener_->async_accept();
         if (!conn_result) {
           if (cancel_source_.is_cancelled())
             break;
-          std::cerr << "TLS Accept error: " << conn_result.error().to_string()
+          std::cerr << "Accept error: " << conn_result.error().to_string()
                     << std::endl;
           continue;
         }
 
-#ifdef COROUTE_HAS_HTTP2
-        // Check ALPN negotiated protocol
-        if (http2_enabled_) {
-          auto *tls_conn =
-              dynamic_cast<net::TlsConnection *>(conn_result->get());
-          if (tls_conn) {
-            auto proto = tls_conn->negotiated_protocol();
-            if (proto && *proto == "h2") {
-              // HTTP/2 over TLS - create HTTP/2 connection
-              auto h2_conn = std::make_shared<http2::Http2Connection>(
-                  std::move(*conn_result));
-              h2_conn->set_handler([this](Request &r) -> Task<Response> {
-                auto match = router_.match(r.method(), r.path());
-                if (match) {
-                  r.set_route_params(std::move(match.params));
-                }
-                co_return co_await middleware_chain_.execute_or_not_found(
-                    r, match.handler);
-              });
-              handle_http2_connection(h2_conn).start_detached();
-              continue;
-            }
-          }
-        }
-#endif
-
-        handle_connection(std::move(*conn_result)).start_detached();
+        serve(std::move(*conn_result));
       }
     }()
                     .start_detached();
-  } else
-#endif
-  {
-    // Try to enable multi-accept (SO_REUSEPORT) for better scalability
-    // This must be done BEFORE creating a regular listener
-    bool multi_accept = io_ctx_->enable_multi_accept(
-        port, [this](std::unique_ptr<net::Connection> conn) {
-          handle_connection(std::move(conn)).start_detached();
-        });
-
-    if (multi_accept) {
-      std::cout << "Server listening on port " << port
-                << " (multi-accept enabled)" << std::endl;
-    } else {
-      // Fall back to single-listener accept loop
-      listener_ = net::Listener::create(*io_ctx_);
-      auto result = listener_->listen(port);
-      if (!result) {
-        throw std::runtime_error("Failed to listen: " +
-                                 result.error().to_string());
-      }
-
-      std::cout << "Server listening on port " << listener_->local_port()
-                << std::endl;
-
-      // Plain HTTP accept loop - use start_detached to keep it alive
-      [this]() -> Task<void> {
-        while (!cancel_source_.is_cancelled()) {
-          auto conn_result = co_await listener_->async_accept();
-          if (!conn_result) {
-            if (cancel_source_.is_cancelled())
-              break;
-            std::cerr << "Accept error: " << conn_result.error().to_string()
-                      << std::endl;
-            continue;
-          }
-
-          handle_connection(std::move(*conn_result)).start_detached();
-        }
-      }()
-                      .start_detached();
-    }
   }
 
   // Run the event loop
   io_ctx_->run();
 }
 
+void App::configure_io_context() {
+  std::cout << "I/O backend: " << io_ctx_->features() << std::endl;
+  if (provided_buffer_count_ > 0 &&
+      !io_ctx_->enable_provided_buffers(provided_buffer_size_,
+                                        provided_buffer_count_)) {
+    std::cerr << "Provided buffers unavailable, using per-connection reads"
+              << std::endl;
+  }
+}
+
 Task<void> App::run_async(uint16_t port) {
-  io_ctx_ = net::IoContext::create(thread_count_);
+  return run_async(net::Endpoint::any(port));
+}
+
+Task<void> App::run_async(net::Endpoint endpoint) {
+  auto io_options = io_options_;
+  io_options.threads = thread_count_;
+  io_ctx_ = net::IoContext::create(io_options);
+  configure_io_context();
   listener_ = net::Listener::create(*io_ctx_);
 
-  auto result = listener_->listen(port);
+  auto result = listener_->listen(endpoint);
   if (!result) {
     throw std::runtime_error("Failed to listen: " + result.error().to_string());
   }
 
-  std::cout << "Server listening on port " << listener_->local_port()
-            << std::endl;
+  std::cout << "Server listening on "
+            << listener_->local_endpoint().to_string() << std::endl;
 
   while (!cancel_source_.is_cancelled()) {
+    if (accept_paused_.load(std::memory_order_relaxed)) {
+      co_await net::sleep_for(ACCEPT_PAUSE_POLL);
+      continue;
+    }
     auto conn_result = co_await listener_->async_accept();
     if (!conn_result) {
       if (cancel_source_.is_cancelled()) {
@@ -139,6 +146,12 @@ Task<void> App::run_async(uint16_t port) {
     }
 
     // Handle connection (fire and forget - self-destroys on completion)
+    if (limits_.max_connections > 0 &&
+        active_connections_.load(std::memory_order_relaxed) >=
+            limits_.max_connections) {
+      shed_connection(std::move(*conn_result)).start_detached();
+      continue;
+    }
     handle_connection(std::move(*conn_result)).start_detached();
   }
 }
@@ -150,6 +163,7 @@ void App::stop() {
     listener_->close();
   }
   if (io_ctx_) {
+    io_ctx_->close_multi_accept();
     io_ctx_->stop();
   }
 }
@@ -164,11 +178,9 @@ void App::shutdown(ShutdownOptions options) {
   if (listener_) {
     listener_->close();
   }
-#ifdef COROUTE_HAS_TLS
-  if (tls_listener_) {
-    tls_listener_->close();
+  if (io_ctx_) {
+    io_ctx_->close_multi_accept();
   }
-#endif
 
   // Wait for existing connections to drain
   auto start = std::chrono::steady_clock::now();
@@ -208,6 +220,10 @@ App &App::enable_tls(const AppTlsConfig &config) {
   tls_config.ca_file = config.ca_file;
   tls_config.chain_file = config.chain_file;
   tls_config.verify_client = config.verify_client;
+  tls_config.kernel_tls = config.kernel_tls;
+  tls_config.session_tickets = config.session_tickets;
+  tls_config.ticket_key_files = config.ticket_key_files;
+  tls_config.session_cache = config.session_cache;
 
   // Set ALPN protocols - if not specified, use defaults based on HTTP/2 support
   if (config.alpn_protocols.empty()) {
@@ -235,41 +251,251 @@ App &App::enable_tls(const AppTlsConfig &config) {
 
   return *this;
 }
+
+net::TlsStats App::tls_stats() const {
+  return tls_ctx_ ? tls_ctx_->stats() : net::TlsStats{};
+}
+
+expected<void, Error> App::reload_tls_ticket_keys() {
+  if (!tls_ctx_) {
+    return unexpected(Error::io(IoError::InvalidArgument, "TLS is not enabled"));
+  }
+  return tls_ctx_->reload_ticket_keys();
+}
 #endif
 
-Task<void> App::handle_connection(std::unique_ptr<net::Connection> conn) {
-  // Track active connection
-  active_connections_.fetch_add(1, std::memory_order_relaxed);
+struct App::ConnectionGuard {
+  App &app;
+
+  explicit ConnectionGuard(App &owner) : app(owner) {
+    app.active_connections_.fetch_add(1, std::memory_order_relaxed);
+    app.update_accept_backpressure();
+  }
+
+  ~ConnectionGuard() {
+    app.active_connections_.fetch_sub(1, std::memory_order_relaxed);
+    app.update_accept_backpressure();
+  }
+
+  ConnectionGuard(const ConnectionGuard &) = delete;
+  ConnectionGuard &operator=(const ConnectionGuard &) = delete;
+};
+
+#ifdef COROUTE_HAS_TLS
+Task<void> App::handle_tls_connection(std::unique_ptr<net::Connection> conn) {
+  // Counted from before the handshake, so connections still handshaking
+  // hold a slot against max_connections and are waited for on shutdown
+  ConnectionGuard guard{*this};
+
+  auto tls_conn = net::TlsConnection::create(std::move(conn), *tls_ctx_);
+  if (!tls_conn) {
+    std::cerr << "TLS error: " << tls_conn.error().to_string() << std::endl;
+    co_return;
+  }
 
-  // RAII guard to decrement on exit
-  struct ConnectionGuard {
+  auto handshake = co_await (*tls_conn)->handshake(timeouts_.tls_handshake);
+  if (!handshake) {
+    if (!cancel_source_.is_cancelled()) {
+      std::cerr << "TLS handshake error: " << handshake.error().to_string()
+                << std::endl;
+    }
+    co_return;
+  }
+
+#ifdef COROUTE_HAS_HTTP2
+  // Check ALPN negotiated protocol
+  if (http2_enabled_) {
+    auto proto = (*tls_conn)->negotiated_protocol();
+    if (proto && *proto == "h2") {
+      // HTTP/2 over TLS - create HTTP/2 connection
+      auto h2_conn =
+          std::make_shared<http2::Http2Connection>(std::move(*tls_conn));
+      h2_conn->set_handler([this](Request &r) -> Task<Response> {
+        auto match = router_.match(r.method(), r.path());
+        if (match) {
+          r.set_route_params(std::move(match.params));
+        }
+        co_return co_await middleware_chain_.execute_or_not_found(
+            r, match.handler);
+      });
+      co_await handle_http2_connection(h2_conn, true);
+      co_return;
+    }
+  }
+#endif
+
+  co_await handle_connection(std::move(*tls_conn), true);
+}
+#endif
+
+// Plain-text answer for a request the server rejects, with the error's
+// status
+static Response error_response(const Error &error) {
+  Response resp = Response::bad_request(error.to_string());
+  resp.set_status(error.http_status());
+  return resp;
+}
+
+// Interim answer to Expect: 100-continue, once the request may send its body
+static constexpr std::string_view CONTINUE_RESPONSE =
+    "HTTP/1.1 100 Continue\r\n\r\n";
+
+// Body left unread by a handler that is still read and dropped to keep the
+// connection; past this the connection is closed instead
+static constexpr size_t MAX_BODY_DRAIN = 64 * 1024;
+
+// A response waiting in the pipeline, with the headers the server adds
+// when it is written
+struct OutgoingResponse {
+  Response response;
+  http1::HeadOptions head;
+};
+
+// Largest body copied in after its head rather than written from the
+// response's own storage
+static constexpr size_t INLINE_BODY_MAX = 1024;
+
+// Write queued responses in order with one gathered write. Heads and small
+// bodies are serialized back to back into `out`, a pooled buffer kept for
+// the connection, so a batch of small responses is one contiguous run.
+static Task<net::WriteResult>
+write_responses(net::Connection &conn, std::vector<OutgoingResponse> &responses,
+                BufferPool::Buffer &out, std::vector<net::IoVec> &parts) {
+  size_t total = 0;
+  for (const auto &[resp, head] : responses) {
+    total += http1::head_size(resp, head);
+    if (resp.body().size() <= INLINE_BODY_MAX) {
+      total += resp.body().size();
+    }
+  }
+  // Reserved rather than resized, so the bytes are written once instead of
+  // zero-filled first. `total` is exact, so appending never reallocates and
+  // `base` stays valid.
+  out.clear();
+  out.reserve(total);
+  const char *base = out.data();
+
+  parts.clear();
+  size_t run = 0;
+  for (const auto &[resp, head] : responses) {
+    http1::append_head(out, resp, head);
+    auto body = resp.body();
+    if (body.size() <= INLINE_BODY_MAX) {
+      out.insert(out.end(), body.begin(), body.end());
+    } else {
+      parts.push_back({base + run, out.size() - run});
+      parts.push_back({body.data(), body.size()});
+      run = out.size();
+    }
+  }
+  if (out.size() != run) {
+    parts.push_back({base + run, out.size() - run});
+  }
+
+  auto result = co_await conn.async_writev(parts);
+  responses.clear();
+  out.clear();
+  co_return result;
+}
+
+App &App::limits(const ServerLimits &limits) {
+  limits_ = limits;
+  overload_response_ = make_overload_response(limits_.retry_after);
+  return *this;
+}
+
+std::string App::make_overload_response(std::chrono::seconds retry_after) {
+  Response resp = Response::service_unavailable();
+  resp.set_header("Retry-After", std::to_string(retry_after.count()));
+  http1::HeadOptions head;
+  head.connection = http1::HeadOptions::Connection::Close;
+  std::string out(http1::head_size(resp, head), '\0');
+  http1::write_head(out.data(), resp, head);
+  out += resp.body();
+  return out;
+}
+
+void App::update_accept_backpressure() {
+  if (limits_.max_connections == 0) {
+    return;
+  }
+  // Whoever stores last re-reads the count, so racing opens and closes
+  // settle on the state matching it
+  for (;;) {
+    bool pause = active_connections_.load(std::memory_order_relaxed) >=
+                 limits_.max_connections;
+    accept_paused_.store(pause, std::memory_order_relaxed);
+    if (io_ctx_) {
+      io_ctx_->set_accept_paused(pause);
+    }
+    if ((active_connections_.load(std::memory_order_relaxed) >=
+         limits_.max_connections) == pause) {
+      break;
+    }
+  }
+}
+
+Task<void> App::shed_connection(std::unique_ptr<net::Connection> conn) {
+  shed_requests_.fetch_add(1, std::memory_order_relaxed);
+  conn->set_write_timeout(timeouts_.write);
+  co_await conn->async_write_all(overload_response_.data(),
+                                 overload_response_.size());
+  conn->close();
+}
+
+Task<void> App::handle_connection(std::unique_ptr<net::Connection> conn,
+                                   bool counted) {
+  // Track the active connection until exit, unless the caller already does
+  std::optional<ConnectionGuard> guard;
+  if (!counted) {
+    guard.emplace(*this);
+  }
+
+  // Releases an in-flight slot once the handler is done
+  struct InflightGuard {
     std::atomic<size_t> &counter;
-    ~ConnectionGuard() { counter.fetch_sub(1, std::memory_order_relaxed); }
-  } guard{active_connections_};
+    ~InflightGuard() { counter.fetch_sub(1, std::memory_order_relaxed); }
+  };
 
   conn->set_cancellation_token(cancel_source_.token());
 
-  // Keep-alive configuration
-  constexpr size_t MAX_REQUESTS_PER_CONNECTION = 100;
-  constexpr auto KEEP_ALIVE_TIMEOUT = std::chrono::seconds(30);
+  // Keep-alive configuration (0 = unlimited requests per connection)
+  const size_t max_requests = limits_.max_requests_per_connection;
+  const std::string keep_alive_timeout =
+      "timeout=" +
+      std::to_string(std::chrono::duration_cast<std::chrono::seconds>(
+                         timeouts_.keep_alive_idle)
+                         .count());
+
+  // Pipelined requests are answered in order; their responses are queued
+  // and go out in one write once no further request is buffered
+  constexpr size_t MAX_PIPELINE_BATCH = 64;
+  InputBuffer input;
+  std::vector<OutgoingResponse> pending;
+  auto output = acquire_buffer();
+  std::vector<net::IoVec> parts;
 
   size_t request_count = 0;
   bool keep_alive = true;
 
-  // Set connection timeout
-  conn->set_timeout(KEEP_ALIVE_TIMEOUT);
+  // Read deadlines are armed per phase by parse_request
+  conn->set_write_timeout(timeouts_.write);
 
   // HTTP/1.1 keep-alive loop
   while (conn->is_open() && !cancel_source_.is_cancelled() && keep_alive) {
     ++request_count;
 
     // Check max requests limit
-    if (request_count > MAX_REQUESTS_PER_CONNECTION) {
+    if (max_requests > 0 && request_count > max_requests) {
       break;
     }
 
-    // Parse request
-    auto req_result = co_await parse_request(*conn);
+    // Parse request (a new connection gets the header deadline for its first
+    // byte, kept-alive connections the idle deadline). Responses are always
+    // flushed before this has to wait for the network.
+    auto req_result = co_await parse_request(
+        *conn, input,
+        request_count == 1 ? timeouts_.header_read : timeouts_.keep_alive_idle);
     if (!req_result) {
       if (req_result.error().is_cancelled() ||
           req_result.error().io_error() == IoError::EndOfStream ||
@@ -277,15 +503,24 @@ Task<void> App::handle_connection(std::unique_ptr<net::Connection> conn) {
         break; // Clean disconnect or timeout
       }
 
-      // Send error response
-      auto resp = Response::bad_request(req_result.error().to_string());
-      auto data = resp.serialize();
-      co_await conn->async_write_all(data.data(), data.size());
+      // Send error response after those already queued
+      http1::HeadOptions head;
+      head.connection = http1::HeadOptions::Connection::Close;
+      head.date = true;
+      pending.push_back({error_response(req_result.error()), head});
+      co_await write_responses(*conn, pending, *output, parts);
       break;
     }
 
     Request &req = *req_result;
 
+    // Upgrades take over the connection, so earlier answers go first
+    if (!pending.empty() && req.header(KnownHeader::Upgrade)) {
+      if (!co_await write_responses(*conn, pending, *output, parts)) {
+        break;
+      }
+    }
+
     // Check for WebSocket upgrade
     if (co_await try_websocket_upgrade(conn, req)) {
       // WebSocket upgrade handled - connection is now owned by WS handler
@@ -302,107 +537,175 @@ Task<void> App::handle_connection(std::unique_ptr<net::Connection> conn) {
     }
 #endif
 
+    // Shed load past the in-flight limit rather than queue behind it:
+    // answers already queued go first, then the 503 closes the connection
+    size_t inflight_before =
+        inflight_requests_.fetch_add(1, std::memory_order_relaxed);
+    InflightGuard inflight{inflight_requests_};
+    if (limits_.max_inflight_requests > 0 &&
+        inflight_before >= limits_.max_inflight_requests) {
+      shed_requests_.fetch_add(1, std::memory_order_relaxed);
+      if (!pending.empty() &&
+          !co_await write_responses(*conn, pending, *output, parts)) {
+        break;
+      }
+      co_await conn->async_write_all(overload_response_.data(),
+                                     overload_response_.size());
+      break;
+    }
+
     // Determine keep-alive based on request
     keep_alive = req.keep_alive();
 
+    // Route first: the route decides how the body is read, and checks made
+    // before the body see the route parameters
+    Router::MatchResult match;
 #ifdef COROUTE_HAS_TEMPLATES
-    // Check for view routes first (GET-only)
+    Router::ViewMatchResult view_match;
     if (req.method() == HttpMethod::GET) {
-      auto view_match = router_.match_view(req.path());
-      if (view_match.handler) {
-        // Set route parameters
-        req.set_route_params(std::move(view_match.params));
-
-        // Execute view handler
-        Response resp;
-        try {
-          ViewResultAny view_result = co_await (*view_match.handler)(req);
-
-          // Render the view using the web template
-          nlohmann::json data = view_result.to_json();
-          std::string template_name = view_result.templates.web;
-          if (template_name.find('.') == std::string::npos) {
-            template_name += ".html";
-          }
-          resp = render_html(template_name, data);
-        } catch (const std::exception &e) {
-          resp = Response::internal_error(e.what());
-        } catch (...) {
-          resp = Response::internal_error("Unknown error");
-        }
+      view_match = router_.match_view(req.path());
+    }
+    if (view_match.handler) {
+      req.set_route_params(std::move(view_match.params));
+    } else
+#endif
+    {
+      match = router_.match(req.method(), req.path());
+      if (match) {
+        req.set_route_params(std::move(match.params));
+      }
+    }
 
-        // Add Connection header based on keep-alive status
-        bool should_close =
-            !keep_alive || request_count >= MAX_REQUESTS_PER_CONNECTION;
-        if (should_close) {
-          resp.set_header("Connection", "close");
-          keep_alive = false;
-        } else {
-          resp.set_header("Connection", "keep-alive");
-          resp.set_header(
-              "Keep-Alive",
-              "timeout=30, max=" +
-                  std::to_string(MAX_REQUESTS_PER_CONNECTION - request_count));
+    Response resp;
+    bool handled = false;
+
+    // Requests turned away on their head never have their body read. A
+    // client waiting for 100 Continue may not send it at all, so that
+    // connection closes; otherwise a small body is skipped after the
+    // response and a larger one closes the connection.
+    bool expects_continue = req.header(KnownHeader::Expect) &&
+                            req.http_version() != "HTTP/1.0" &&
+                            req.body_pending();
+    if (auto early = co_await screen_request(req, match.options)) {
+      resp = std::move(*early);
+      handled = true;
+      if (expects_continue) {
+        keep_alive = false;
+      }
+    } else if (req.body_pending()) {
+      if (expects_continue) {
+        // Answers to earlier requests go first
+        if (!pending.empty() &&
+            !co_await write_responses(*conn, pending, *output, parts)) {
+          break;
         }
-
-        // Send response
-        auto data = resp.serialize();
-        auto write_result =
-            co_await conn->async_write_all(data.data(), data.size());
-        if (!write_result) {
+        if (!co_await conn->async_write_all(CONTINUE_RESPONSE.data(),
+                                            CONTINUE_RESPONSE.size())) {
           break;
         }
+      }
 
-        continue; // Go to next request in keep-alive loop
+      conn->set_read_timeout(timeouts_.body_read);
+      auto body = co_await read_request_body(req, match.options);
+      if (!body) {
+        if (!body.error().is_http()) {
+          break; // Timed out or disconnected mid-body
+        }
+        http1::HeadOptions head;
+        head.connection = http1::HeadOptions::Connection::Close;
+        head.date = true;
+        pending.push_back({error_response(body.error()), head});
+        co_await write_responses(*conn, pending, *output, parts);
+        break;
       }
     }
-#endif
 
-    // Route the request
-    auto match = router_.match(req.method(), req.path());
+#ifdef COROUTE_HAS_TEMPLATES
+    // View routes (GET-only) take precedence
+    if (!handled && view_match.handler) {
+      // Execute view handler
+      try {
+        ViewResultAny view_result = co_await (*view_match.handler)(req);
+
+        // Render the view using the web template
+        nlohmann::json data = view_result.to_json();
+        std::string template_name = view_result.templates.web;
+        if (template_name.find('.') == std::string::npos) {
+          template_name += ".html";
+        }
+        resp = render_html(template_name, data);
+      } catch (const std::exception &e) {
+        resp = Response::internal_error(e.what());
+      } catch (...) {
+        resp = Response::internal_error("Unknown error");
+      }
+      handled = true;
+    }
+#endif
 
-    // Set route parameters if matched
-    if (match) {
-      req.set_route_params(std::move(match.params));
+    if (!handled) {
+      // Execute handler with pre-compiled middleware chain
+      try {
+        resp =
+            co_await middleware_chain_.execute_or_not_found(req, match.handler);
+      } catch (const std::exception &e) {
+        resp = Response::internal_error(e.what());
+      } catch (...) {
+        resp = Response::internal_error("Unknown error");
+      }
     }
 
-    // Execute handler with pre-compiled middleware chain
-    Response resp;
-    try {
-      resp =
-          co_await middleware_chain_.execute_or_not_found(req, match.handler);
-    } catch (const std::exception &e) {
-      resp = Response::internal_error(e.what());
-    } catch (...) {
-      resp = Response::internal_error("Unknown error");
+    // Whatever the handler left of the body is skipped so the next request
+    // can be read, unless there is too much of it
+    if (req.body_pending() && keep_alive) {
+      if (!co_await req.body_stream().discard(MAX_BODY_DRAIN)) {
+        keep_alive = false;
+      }
+    }
+    if (keep_alive && req.header(KnownHeader::TransferEncoding)) {
+      // A chunked body may have been read together with what follows it
+      auto unread = req.body_stream().take_unread();
+      if (!unread.empty()) {
+        compact_input(input);
+        input.data->insert(input.data->end(), unread.begin(), unread.end());
+      }
     }
 
-    // Add Connection header based on keep-alive status
+    // Connection, Keep-Alive and Date are written with the head. A handler
+    // asking to close is honoured; otherwise the server's headers replace
+    // the handler's.
+    http1::HeadOptions head;
+    head.date = true;
+    if (auto connection = resp.header(KnownHeader::Connection)) {
+      if (iequals(*connection, "close")) {
+        keep_alive = false;
+      }
+      resp.remove_header("Connection");
+      resp.remove_header("Keep-Alive");
+    }
     bool should_close =
-        !keep_alive || request_count >= MAX_REQUESTS_PER_CONNECTION;
+        !keep_alive || (max_requests > 0 && request_count >= max_requests);
     if (should_close) {
-      resp.set_header("Connection", "close");
+      head.connection = http1::HeadOptions::Connection::Close;
       keep_alive = false;
     } else {
-      resp.set_header("Connection", "keep-alive");
-      resp.set_header(
-          "Keep-Alive",
-          "timeout=30, max=" +
-              std::to_string(MAX_REQUESTS_PER_CONNECTION - request_count));
+      head.connection = http1::HeadOptions::Connection::KeepAlive;
+      head.keep_alive = keep_alive_timeout;
+      head.max_requests = max_requests > 0 ? max_requests - request_count : 0;
     }
 
     // Send response
     if (resp.has_file() && req.method() != HttpMethod::HEAD) {
-      // Zero-copy file response: send headers then file
-      auto headers_data = resp.serialize_headers();
-      auto write_result = co_await conn->async_write_all(headers_data.data(),
-                                                         headers_data.size());
+      // Zero-copy file response: earlier responses and these headers go out
+      // together, then the file
+      auto file_info = resp.file_info();
+      pending.push_back({std::move(resp), head});
+      auto write_result = co_await write_responses(*conn, pending, *output, parts);
       if (!write_result) {
         break;
       }
 
       // Send file body via zero-copy
-      const auto &file_info = resp.file_info();
       auto transmit_result = co_await send_file_zero_copy(
           *conn, file_info.path, file_info.offset, file_info.length);
 
@@ -411,263 +714,312 @@ Task<void> App::handle_connection(std::unique_ptr<net::Connection> conn) {
       if (!transmit_result) {
         break;
       }
-    } else {
-      // Normal response with body in memory
-      auto data = resp.serialize();
-      auto write_result =
-          co_await conn->async_write_all(data.data(), data.size());
+      continue;
+    }
+
+    // Normal response with body in memory, batched with the pipeline
+    pending.push_back({std::move(resp), head});
+    if (!keep_alive || pending.size() >= MAX_PIPELINE_BATCH ||
+        !has_buffered_request(input)) {
+      auto write_result = co_await write_responses(*conn, pending, *output, parts);
       if (!write_result) {
         break;
       }
     }
   }
 
+  if (!pending.empty()) {
+    co_await write_responses(*conn, pending, *output, parts);
+  }
   conn->close();
 }
 
-// URL decode helper
-static std::string url_decode(std::string_view str) {
-  std::string result;
-  result.reserve(str.size());
-
-  for (size_t i = 0; i < str.size(); ++i) {
-    if (str[i] == '%' && i + 2 < str.size()) {
-      // Decode %XX
-      char hex[3] = {str[i + 1], str[i + 2], '\0'};
-      char *end;
-      long val = std::strtol(hex, &end, 16);
-      if (end == hex + 2) {
-        result += static_cast<char>(val);
-        i += 2;
-        continue;
-      }
-    } else if (str[i] == '+') {
-      result += ' ';
-      continue;
-    }
-    result += str[i];
+// Arm what is left of a phase deadline as the next read timeout.
+// Returns false once the deadline has passed.
+static bool arm_read_deadline(net::Connection &conn,
+                              std::chrono::steady_clock::time_point deadline) {
+  auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+      deadline - std::chrono::steady_clock::now());
+  if (remaining.count() <= 0) {
+    return false;
   }
+  conn.set_read_timeout(remaining);
+  return true;
+}
 
-  return result;
+// Largest request head, and so the most input buffered at once
+static constexpr size_t MAX_HEADER_SIZE = 8192;
+
+std::shared_ptr<BufferPool::Buffer> App::acquire_buffer() {
+  // Returned to the pool when the last reference goes. Capacity is reserved
+  // up front so the views requests hold into input never move.
+  return std::shared_ptr<BufferPool::Buffer>(
+      buffer_pool_.acquire(MAX_HEADER_SIZE).release(),
+      [this](BufferPool::Buffer *buf) {
+        buffer_pool_.release(std::unique_ptr<BufferPool::Buffer>(buf));
+      });
 }
 
-Task<expected<Request, Error>> App::parse_request(net::Connection &conn) {
-  // HTTP request parser with improved efficiency and validation
+void App::compact_input(InputBuffer &input) {
+  if (!input.data) {
+    input.data = acquire_buffer();
+    input.begin = 0;
+    return;
+  }
+  if (input.begin == 0) {
+    return;
+  }
+  auto &buf = *input.data;
+  if (input.data.use_count() == 1) {
+    buf.erase(buf.begin(), buf.begin() + static_cast<ptrdiff_t>(input.begin));
+  } else {
+    // A request still points into this buffer: move the rest to a new one
+    auto fresh = acquire_buffer();
+    fresh->assign(buf.begin() + static_cast<ptrdiff_t>(input.begin), buf.end());
+    input.data = std::move(fresh);
+  }
+  input.begin = 0;
+}
 
-  constexpr size_t MAX_HEADER_SIZE = 8192;
-  constexpr size_t MAX_BODY_SIZE = 10 * 1024 * 1024; // 10MB default max
-  constexpr size_t READ_CHUNK_SIZE = 1024;
-
-  // Use pooled buffer for reduced allocations
-  auto buffer_ptr = buffer_pool_.acquire(MAX_HEADER_SIZE);
-  auto &buffer = *buffer_ptr;
-  buffer.resize(MAX_HEADER_SIZE);
-
-  // RAII guard to return buffer to pool
-  struct BufferGuard {
-    BufferPool &pool;
-    std::unique_ptr<std::vector<char>> buf;
-    ~BufferGuard() {
-      if (buf)
-        pool.release(std::move(buf));
-    }
-  } buffer_guard{buffer_pool_, std::move(buffer_ptr)};
-  size_t total_read = 0;
-  size_t header_end_pos = std::string::npos;
-
-  // Read headers in chunks for better efficiency
-  while (total_read < MAX_HEADER_SIZE) {
-    size_t to_read = std::min(READ_CHUNK_SIZE, MAX_HEADER_SIZE - total_read);
-    auto result = co_await conn.async_read(buffer.data() + total_read, to_read);
-    if (!result) {
-      co_return unexpected(result.error());
-    }
+bool App::has_buffered_request(InputBuffer &input) {
+  auto data = input.pending();
+  size_t head_end = http1::find_head_end(data, input.scanned);
+  if (head_end == std::string_view::npos) {
+    input.scanned = data.size();
+    return false;
+  }
 
-    size_t bytes_read = *result;
-    if (bytes_read == 0) {
-      co_return unexpected(
-          Error::io(IoError::EndOfStream, "Connection closed"));
+  // A body still on its way means a read, and the client may be waiting
+  // for earlier responses before sending it, so it ends the batch
+  std::string_view head = data.substr(0, head_end);
+  size_t body = 0;
+  for (size_t pos = head.find("\r\n"); pos + 2 < head.size();) {
+    size_t eol = head.find("\r\n", pos + 2);
+    std::string_view line = head.substr(pos + 2, eol - pos - 2);
+    size_t colon = line.find(':');
+    KnownHeader name = colon == std::string_view::npos
+                           ? KnownHeader::Count
+                           : known_header(line.substr(0, colon));
+    if (name == KnownHeader::TransferEncoding) {
+      return false;
     }
-
-    // Search for end of headers in newly read data
-    size_t search_start = (total_read >= 3) ? total_read - 3 : 0;
-    total_read += bytes_read;
-
-    for (size_t i = search_start; i + 3 < total_read; ++i) {
-      if (buffer[i] == '\r' && buffer[i + 1] == '\n' && buffer[i + 2] == '\r' &&
-          buffer[i + 3] == '\n') {
-        header_end_pos = i + 4;
-        break;
+    if (name == KnownHeader::ContentLength) {
+      auto value = line.substr(colon + 1);
+      while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+        value.remove_prefix(1);
+      }
+      while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+        value.remove_suffix(1);
       }
+      auto parsed = from_string<size_t>(value);
+      if (!parsed) {
+        return true; // Rejected when parsed, without reading
+      }
+      body = *parsed;
     }
+    pos = eol;
+  }
+  return data.size() - head_end >= body;
+}
 
-    if (header_end_pos != std::string::npos) {
-      break;
+// Form fields in an urlencoded body become query parameters
+static void parse_form_body(Request &req) {
+  auto ct = req.content_type();
+  if (!ct || ct->find("application/x-www-form-urlencoded") ==
+                 std::string_view::npos) {
+    return;
+  }
+  std::string_view form_body = req.body();
+  while (!form_body.empty()) {
+    auto amp = form_body.find('&');
+    std::string_view param =
+        (amp != std::string_view::npos) ? form_body.substr(0, amp) : form_body;
+
+    auto eq = param.find('=');
+    if (eq != std::string_view::npos) {
+      req.add_query_param(form::url_decode(param.substr(0, eq)),
+                          form::url_decode(param.substr(eq + 1)));
+    } else if (!param.empty()) {
+      // Parameter without value
+      req.add_query_param(form::url_decode(param), "");
     }
+
+    if (amp == std::string_view::npos)
+      break;
+    form_body = form_body.substr(amp + 1);
   }
+}
 
-  if (header_end_pos == std::string::npos) {
-    co_return unexpected(
-        Error::http(HttpError::PayloadTooLarge, "Headers too large"));
+Task<std::optional<Response>>
+App::screen_request(Request &req, const RouteOptions *options) {
+  if (auto expect = req.header(KnownHeader::Expect);
+      expect && req.http_version() != "HTTP/1.0" &&
+      !iequals(*expect, "100-continue")) {
+    co_return error_response(
+        Error::http(HttpError::ExpectationFailed, "Unsupported expectation"));
   }
 
-  // Parse the request
-  std::string_view data(buffer.data(), total_read);
-  Request req;
+  if (req.body_pending()) {
+    // A declared size past the limit is refused before anything is read;
+    // a chunked body is held to it as it arrives
+    auto &stream = req.body_stream();
+    stream.set_limit(options && options->max_body_size > 0
+                         ? options->max_body_size
+                         : max_body_size_);
+    auto length = stream.content_length();
+    if (length && stream.limit() > 0 && *length > stream.limit()) {
+      co_return error_response(Error::http(
+          HttpError::PayloadTooLarge, "Request body too large (max " +
+                                          std::to_string(stream.limit()) +
+                                          " bytes)"));
+    }
+  }
 
-  // Find request line
-  auto line_end = data.find("\r\n");
-  if (line_end == std::string_view::npos) {
-    co_return unexpected(
-        Error::http(HttpError::BadRequest, "Invalid request line"));
-  }
-
-  std::string_view request_line = data.substr(0, line_end);
-
-  // Parse method
-  auto method_end = request_line.find(' ');
-  if (method_end == std::string_view::npos) {
-    co_return unexpected(
-        Error::http(HttpError::BadRequest, "Invalid request line"));
-  }
-  req.set_method(request_line.substr(0, method_end));
-
-  // Parse path
-  auto path_start = method_end + 1;
-  auto path_end = request_line.find(' ', path_start);
-  if (path_end == std::string_view::npos) {
-    co_return unexpected(
-        Error::http(HttpError::BadRequest, "Invalid request line"));
-  }
-
-  std::string_view path_with_query =
-      request_line.substr(path_start, path_end - path_start);
-
-  // Split path and query string
-  auto query_start = path_with_query.find('?');
-  if (query_start != std::string_view::npos) {
-    // URL decode the path
-    req.set_path(url_decode(path_with_query.substr(0, query_start)));
-    req.set_query_string(std::string(path_with_query.substr(query_start + 1)));
-
-    // Parse query parameters with URL decoding
-    std::string_view qs = path_with_query.substr(query_start + 1);
-    while (!qs.empty()) {
-      auto amp = qs.find('&');
-      std::string_view param =
-          (amp != std::string_view::npos) ? qs.substr(0, amp) : qs;
-
-      auto eq = param.find('=');
-      if (eq != std::string_view::npos) {
-        req.add_query_param(url_decode(param.substr(0, eq)),
-                            url_decode(param.substr(eq + 1)));
-      } else if (!param.empty()) {
-        // Parameter without value
-        req.add_query_param(url_decode(param), "");
+  for (auto &middleware : pre_body_middleware_) {
+    try {
+      if (auto resp = co_await middleware(req)) {
+        co_return resp;
       }
-
-      if (amp == std::string_view::npos)
-        break;
-      qs = qs.substr(amp + 1);
+    } catch (const std::exception &e) {
+      co_return Response::internal_error(e.what());
+    } catch (...) {
+      co_return Response::internal_error("Unknown error");
     }
-  } else {
-    req.set_path(url_decode(path_with_query));
   }
+  co_return std::nullopt;
+}
 
-  // Parse HTTP version
-  auto version_start = path_end + 1;
-  req.set_http_version(std::string(request_line.substr(version_start)));
+Task<expected<void, Error>>
+App::read_request_body(Request &req, const RouteOptions *options) {
+  if (options && options->stream_body) {
+    co_return expected<void, Error>{};
+  }
 
-  // Parse headers
-  size_t pos = line_end + 2;
-  while (pos < data.size()) {
-    auto header_end = data.find("\r\n", pos);
-    if (header_end == std::string_view::npos || header_end == pos) {
-      break; // End of headers
-    }
+  auto body = co_await req.body_stream().read_all();
+  if (!body) {
+    co_return unexpected(body.error());
+  }
+  req.set_body(std::move(*body));
+  parse_form_body(req);
+  co_return expected<void, Error>{};
+}
 
-    std::string_view header_line = data.substr(pos, header_end - pos);
-    auto colon = header_line.find(':');
-    if (colon != std::string_view::npos) {
-      std::string_view key = header_line.substr(0, colon);
-      std::string_view value = header_line.substr(colon + 1);
+Task<expected<Request, Error>>
+App::parse_request(net::Connection &conn, InputBuffer &input,
+                   std::chrono::milliseconds idle_timeout) {
+  // HTTP request parser with improved efficiency and validation
 
-      // Trim leading whitespace from value
-      while (!value.empty() && value[0] == ' ') {
-        value = value.substr(1);
+  constexpr size_t READ_CHUNK_SIZE = 2048;
+
+  size_t head_end = input.size() > 0
+                        ? http1::find_head_end(input.pending(), input.scanned)
+                        : std::string_view::npos;
+
+  // Waiting for a new request: the first read waits up to idle_timeout for
+  // it to start; once bytes arrive the remaining header budget bounds every
+  // further header read. Part of a pipelined request already buffered
+  // starts the header budget right away.
+  std::chrono::steady_clock::time_point header_deadline =
+      std::chrono::steady_clock::now() + timeouts_.header_read;
+  if (head_end == std::string_view::npos) {
+    if (input.size() == 0) {
+      conn.set_read_timeout(idle_timeout);
+    } else if (timeouts_.header_read.count() > 0) {
+      if (!arm_read_deadline(conn, header_deadline)) {
+        co_return unexpected(Error::timeout());
       }
-
-      req.add_header(std::string(key), std::string(value));
+    } else {
+      conn.set_read_timeout(std::chrono::milliseconds::zero());
     }
-
-    pos = header_end + 2;
   }
 
-  // Read body if Content-Length is present
-  auto content_length = req.content_length();
-  if (content_length && *content_length > 0) {
-    // Validate body size
-    if (*content_length > MAX_BODY_SIZE) {
-      co_return unexpected(Error::http(HttpError::PayloadTooLarge,
-                                       "Request body too large (max " +
-                                           std::to_string(MAX_BODY_SIZE) +
-                                           " bytes)"));
-    }
-
-    std::string body(*content_length, '\0');
-    size_t body_read = 0;
-
-    // Check if we already read some body data while reading headers
-    size_t body_in_buffer = total_read - header_end_pos;
-    if (body_in_buffer > 0) {
-      size_t to_copy = std::min(body_in_buffer, *content_length);
-      std::memcpy(body.data(), buffer.data() + header_end_pos, to_copy);
-      body_read = to_copy;
+  while (head_end == std::string_view::npos) {
+    if (input.size() >= MAX_HEADER_SIZE) {
+      co_return unexpected(
+          Error::http(HttpError::PayloadTooLarge, "Headers too large"));
     }
 
-    // Read remaining body
-    while (body_read < *content_length) {
-      auto result = co_await conn.async_read(body.data() + body_read,
-                                             *content_length - body_read);
+    size_t before = input.size();
+    if (before == 0 && conn.supports_read_lease()) {
+      // With provided buffers, wait for the first bytes without holding a
+      // pool buffer so idle keep-alive connections pin no read memory
+      input.data.reset();
+      auto lease = co_await conn.async_read_lease(MAX_HEADER_SIZE);
+      if (!lease) {
+        co_return unexpected(lease.error());
+      }
+      compact_input(input);
+      input.data->assign(lease->data(), lease->data() + lease->size());
+    } else {
+      if (before > 0 && timeouts_.header_read.count() > 0 &&
+          !arm_read_deadline(conn, header_deadline)) {
+        co_return unexpected(Error::timeout());
+      }
+      compact_input(input);
+      // The size only grows by what each read asks for, so nothing is
+      // zero-filled ahead of the data
+      auto &buf = *input.data;
+      size_t to_read =
+          std::min(std::max(READ_CHUNK_SIZE, before), MAX_HEADER_SIZE - before);
+      buf.resize(before + to_read);
+      auto result = co_await conn.async_read(buf.data() + before, to_read);
+      buf.resize(before + (result ? *result : 0));
       if (!result) {
         co_return unexpected(result.error());
       }
-      if (*result == 0) {
-        co_return unexpected(
-            Error::http(HttpError::BadRequest, "Incomplete request body"));
-      }
-      body_read += *result;
-    }
-
-    req.set_body(std::move(body));
-
-    // Parse form body as query parameters if content type is form-urlencoded
-    auto ct = req.content_type();
-    if (ct && ct->find("application/x-www-form-urlencoded") !=
-                  std::string_view::npos) {
-      std::string_view form_body = req.body();
-      while (!form_body.empty()) {
-        auto amp = form_body.find('&');
-        std::string_view param = (amp != std::string_view::npos)
-                                     ? form_body.substr(0, amp)
-                                     : form_body;
-
-        auto eq = param.find('=');
-        if (eq != std::string_view::npos) {
-          req.add_query_param(url_decode(param.substr(0, eq)),
-                              url_decode(param.substr(eq + 1)));
-        } else if (!param.empty()) {
-          // Parameter without value
-          req.add_query_param(url_decode(param), "");
-        }
+    }
 
-        if (amp == std::string_view::npos)
-          break;
-        form_body = form_body.substr(amp + 1);
+    if (input.size() == before) {
+      co_return unexpected(
+          Error::io(IoError::EndOfStream, "Connection closed"));
+    }
+
+    if (before == 0) {
+      header_deadline = std::chrono::steady_clock::now() + timeouts_.header_read;
+      if (timeouts_.header_read.count() <= 0) {
+        conn.set_read_timeout(std::chrono::milliseconds::zero());
       }
     }
+
+    // Only the new bytes (and a possibly split terminator) are scanned
+    head_end = http1::find_head_end(input.pending(), before);
   }
 
+  // Parse the request line and headers in place
+  std::string_view data = input.pending();
+  Request req;
+  auto parsed = http1::parse_head(data.substr(0, head_end), req);
+  if (!parsed) {
+    co_return unexpected(parsed.error());
+  }
+  // The views into the buffer live as long as the request
+  req.hold_buffer(input.data);
+  size_t consumed = head_end;
+
+  // The body stays on the connection: read_request_body() reads it once
+  // the route is known, or the handler streams it
+  auto framing_info = BodyStream::framing_of(req.headers());
+  if (!framing_info) {
+    co_return unexpected(framing_info.error());
+  }
+  auto [framing, content_length] = *framing_info;
+
+  if (framing != BodyStream::Framing::None) {
+    // Body bytes that arrived with the head. Past a Content-Length body is
+    // the next pipelined request, which stays buffered; a chunked body's
+    // end is only found by decoding, so it takes everything and hands back
+    // the rest (BodyStream::take_unread).
+    std::string_view buffered = data.substr(head_end);
+    if (framing == BodyStream::Framing::ContentLength) {
+      buffered = buffered.substr(0, content_length);
+    }
+    consumed += buffered.size();
+    req.set_body_stream(std::make_shared<BodyStream>(conn, framing,
+                                                     content_length, buffered));
+  }
+
+  input.begin += consumed;
+  input.scanned = 0;
   co_return req;
 }
 
@@ -684,6 +1036,9 @@ Task<bool> App::try_websocket_upgrade(std::unique_ptr<net::Connection> &conn,
     co_return false;
   }
 
+  // WebSocket connections are long-lived; reads wait without a deadline
+  conn->set_read_timeout(std::chrono::milliseconds::zero());
+
   // Upgrade the connection
   auto ws_conn = co_await net::upgrade_to_websocket(std::move(conn), req);
   if (!ws_conn) {
@@ -737,8 +1092,16 @@ Task<bool> App::try_http2_upgrade(std::unique_ptr<net::Connection> &conn,
 }
 
 Task<void>
-App::handle_http2_connection(std::shared_ptr<http2::Http2Connection> h2_conn) {
-  active_connections_.fetch_add(1, std::memory_order_relaxed);
+App::handle_http2_connection(std::shared_ptr<http2::Http2Connection> h2_conn,
+                             bool counted) {
+  std::optional<ConnectionGuard> guard;
+  if (!counted) {
+    guard.emplace(*this);
+  }
+
+  // Frame reads may idle between streams as long as a keep-alive would
+  h2_conn->connection().set_read_timeout(timeouts_.keep_alive_idle);
+  h2_conn->connection().set_write_timeout(timeouts_.write);
 
   try {
     co_await h2_conn->run();
@@ -747,8 +1110,6 @@ App::handle_http2_connection(std::shared_ptr<http2::Http2Connection> h2_conn) {
   } catch (...) {
     std::cerr << "HTTP/2 connection error: unknown" << std::endl;
   }
-
-  active_connections_.fetch_sub(1, std::memory_order_relaxed);
 }
 #endif
 
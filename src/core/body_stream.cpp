@@ -0,0 +1,246 @@
+#include "coroute/core/body_stream.hpp"
+#include "coroute/util/from_string.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace coroute {
+
+namespace {
+
+// read_all() grows the body by at most this much per read, so memory
+// follows what has arrived rather than what the client announced
+constexpr size_t READ_ALL_STEP = 64 * 1024;
+
+const std::vector<std::pair<std::string, std::string>> NO_TRAILERS;
+
+} // namespace
+
+expected<BodyStream::FramingInfo, Error>
+BodyStream::framing_of(const BasicHeaderMap<std::string_view>& headers) {
+    FramingInfo info;
+    if (!headers.contains(KnownHeader::TransferEncoding) &&
+        !headers.contains(KnownHeader::ContentLength)) {
+        return info;
+    }
+    
+    // Lookups only see the last of repeated headers, so walk them all
+    std::optional<std::string_view> transfer_encoding;
+    std::optional<size_t> content_length;
+    for (const auto& [name, value] : headers) {
+        switch (known_header(name)) {
+            case KnownHeader::TransferEncoding:
+                if (transfer_encoding) {
+                    return unexpected(Error::http(HttpError::BadRequest,
+                                                  "Repeated Transfer-Encoding"));
+                }
+                transfer_encoding = value;
+                break;
+            case KnownHeader::ContentLength: {
+                auto length = from_string<size_t>(value);
+                if (!length) {
+                    return unexpected(Error::http(HttpError::BadRequest,
+                                                  "Invalid Content-Length"));
+                }
+                if (content_length && *content_length != *length) {
+                    return unexpected(Error::http(HttpError::BadRequest,
+                                                  "Conflicting Content-Length"));
+                }
+                content_length = *length;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    
+    if (transfer_encoding) {
+        if (content_length) {
+            return unexpected(Error::http(HttpError::BadRequest,
+                                          "Transfer-Encoding with Content-Length"));
+        }
+        if (!iequals(*transfer_encoding, "chunked")) {
+            return unexpected(Error::http(HttpError::NotImplemented,
+                                          "Unsupported Transfer-Encoding"));
+        }
+        info.framing = Framing::Chunked;
+        return info;
+    }
+    
+    if (*content_length > 0) {
+        info.framing = Framing::ContentLength;
+        info.content_length = *content_length;
+    }
+    return info;
+}
+
+BodyStream::BodyStream(net::Connection& conn, Framing framing, size_t content_length,
+                       std::string_view buffered)
+    : conn_(&conn), framing_(framing) {
+    switch (framing_) {
+        case Framing::None:
+            break;
+        case Framing::ContentLength:
+            content_length_ = content_length;
+            buffered_ = buffered.substr(0, content_length);
+            finished_ = content_length == 0;
+            break;
+        case Framing::Chunked:
+            chunked_ = std::make_unique<ChunkedBodyReader>(&conn, buffered);
+            finished_ = false;
+            break;
+    }
+}
+
+expected<void, Error> BodyStream::check_limit(size_t total) const {
+    if (limit_ > 0 && total > limit_) {
+        return unexpected(Error::http(HttpError::PayloadTooLarge,
+                                      "Request body too large (max " +
+                                          std::to_string(limit_) + " bytes)"));
+    }
+    return {};
+}
+
+Task<expected<size_t, Error>> BodyStream::read(char* out, size_t max) {
+    if (finished_ || max == 0) {
+        co_return size_t{0};
+    }
+
+    size_t n = 0;
+    if (framing_ == Framing::ContentLength) {
+        if (auto limited = check_limit(content_length_); !limited) {
+            co_return unexpected(limited.error());
+        }
+        n = std::min(max, content_length_ - received_);
+        if (!buffered_.empty()) {
+            n = std::min(n, buffered_.size());
+            std::memcpy(out, buffered_.data(), n);
+            buffered_.remove_prefix(n);
+        } else {
+            auto result = co_await conn_->async_read(out, n);
+            if (!result) {
+                co_return unexpected(result.error());
+            }
+            if (*result == 0) {
+                co_return unexpected(
+                    Error::http(HttpError::BadRequest, "Incomplete request body"));
+            }
+            n = *result;
+        }
+        received_ += n;
+        finished_ = received_ == content_length_;
+        co_return n;
+    }
+
+    auto result = co_await chunked_->read_some(out, max);
+    if (!result) {
+        co_return unexpected(result.error());
+    }
+    n = *result;
+    if (n == 0) {
+        finished_ = true;
+        co_return n;
+    }
+    received_ += n;
+    if (auto limited = check_limit(received_); !limited) {
+        co_return unexpected(limited.error());
+    }
+    co_return n;
+}
+
+Task<expected<std::string_view, Error>> BodyStream::next() {
+    if (finished_) {
+        co_return std::string_view{};
+    }
+
+    // A short Content-Length body needs no more than its own size
+    size_t size = PIECE_SIZE;
+    if (framing_ == Framing::ContentLength) {
+        size = std::min(size, content_length_ - received_);
+    }
+
+    // Body bytes read with the head are handed out in place
+    if (!buffered_.empty()) {
+        if (auto limited = check_limit(content_length_); !limited) {
+            co_return unexpected(limited.error());
+        }
+        auto piece = buffered_.substr(0, size);
+        buffered_.remove_prefix(piece.size());
+        received_ += piece.size();
+        finished_ = received_ == content_length_;
+        co_return piece;
+    }
+
+    if (!piece_) {
+        piece_ = std::make_unique<char[]>(PIECE_SIZE);
+    }
+    auto result = co_await read(piece_.get(), size);
+    if (!result) {
+        co_return unexpected(result.error());
+    }
+    co_return std::string_view(piece_.get(), *result);
+}
+
+Task<expected<std::string, Error>> BodyStream::read_all() {
+    std::string body;
+    if (framing_ == Framing::ContentLength) {
+        if (auto limited = check_limit(content_length_); !limited) {
+            co_return unexpected(limited.error());
+        }
+    }
+
+    while (!finished_) {
+        size_t step = READ_ALL_STEP;
+        if (framing_ == Framing::ContentLength) {
+            step = std::min(step, content_length_ - received_);
+        }
+        size_t before = body.size();
+        body.resize(before + step);
+        auto result = co_await read(body.data() + before, step);
+        if (!result) {
+            co_return unexpected(result.error());
+        }
+        body.resize(before + *result);
+    }
+    co_return body;
+}
+
+Task<expected<void, Error>> BodyStream::discard(size_t max_bytes) {
+    if (finished_) {
+        co_return expected<void, Error>{};
+    }
+    if (framing_ == Framing::ContentLength && content_length_ - received_ > max_bytes) {
+        co_return unexpected(Error::http(HttpError::PayloadTooLarge,
+                                         "Unread request body too large to skip"));
+    }
+
+    // The limit no longer applies: what is left is only skipped
+    limit_ = 0;
+    size_t dropped = 0;
+    char scratch[4096];
+    while (!finished_) {
+        auto result = co_await read(scratch, sizeof(scratch));
+        if (!result) {
+            co_return unexpected(result.error());
+        }
+        dropped += *result;
+        if (dropped > max_bytes) {
+            co_return unexpected(Error::http(HttpError::PayloadTooLarge,
+                                             "Unread request body too large to skip"));
+        }
+    }
+    co_return expected<void, Error>{};
+}
+
+const std::vector<std::pair<std::string, std::string>>& BodyStream::trailers() const noexcept {
+    return chunked_ ? chunked_->trailers() : NO_TRAILERS;
+}
+
+std::string BodyStream::take_unread() {
+    if (!chunked_ || !finished_) {
+        return {};
+    }
+    return chunked_->take_buffered();
+}
+
+} // namespace coroute
@@ -4,6 +4,9 @@
 #include <iomanip>
 #include <algorithm>
 #include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
 
 namespace coroute {
 
@@ -56,7 +59,8 @@ int64_t parse_chunk_size(std::string_view hex_size) {
         hex_size = hex_size.substr(0, semicolon);
     }
     
-    if (hex_size.empty()) {
+    // More digits would overflow
+    if (hex_size.empty() || hex_size.size() > 15) {
         return -1;
     }
     
@@ -95,15 +99,7 @@ std::string_view ChunkedResponse::status_text(int status) noexcept {
     }
 }
 
-Task<expected<void, Error>> ChunkedResponse::send_headers() {
-    if (!conn_) {
-        co_return unexpected(Error::http(HttpError::Internal, "No connection set"));
-    }
-    
-    if (headers_sent_) {
-        co_return expected<void, Error>{};  // Already sent
-    }
-    
+std::string ChunkedResponse::serialize_headers() const {
     std::ostringstream oss;
     
     // Status line
@@ -134,8 +130,31 @@ Task<expected<void, Error>> ChunkedResponse::send_headers() {
     // End of headers
     oss << "\r\n";
     
-    std::string header_data = oss.str();
-    auto result = co_await conn_->async_write_all(header_data.data(), header_data.size());
+    return oss.str();
+}
+
+Task<expected<void, Error>> ChunkedResponse::send(std::span<const net::IoVec> parts) {
+    std::string header_data;
+    net::IoVec inline_parts[4];
+    std::vector<net::IoVec> all;
+    std::span<const net::IoVec> to_send = parts;
+    
+    // The first write carries the headers in the same batch
+    if (!headers_sent_) {
+        header_data = serialize_headers();
+        if (parts.size() < std::size(inline_parts)) {
+            inline_parts[0] = net::IoVec(header_data.data(), header_data.size());
+            std::copy(parts.begin(), parts.end(), inline_parts + 1);
+            to_send = std::span<const net::IoVec>(inline_parts, parts.size() + 1);
+        } else {
+            all.reserve(parts.size() + 1);
+            all.emplace_back(header_data.data(), header_data.size());
+            all.insert(all.end(), parts.begin(), parts.end());
+            to_send = all;
+        }
+    }
+    
+    auto result = co_await conn_->async_writev(to_send);
     
     if (!result) {
         co_return unexpected(result.error());
@@ -154,28 +173,23 @@ Task<expected<void, Error>> ChunkedResponse::write(std::string_view data) {
         co_return unexpected(Error::http(HttpError::Internal, "Response already finished"));
     }
     
-    // Send headers on first write
-    if (!headers_sent_) {
-        auto result = co_await send_headers();
-        if (!result) {
-            co_return result;
-        }
-    }
-    
-    // Don't send empty chunks
+    // Don't send empty chunks (the first write still sends the headers)
     if (data.empty()) {
-        co_return expected<void, Error>{};
-    }
-    
-    // Encode and send chunk
-    std::string chunk = chunked::encode_chunk(data);
-    auto result = co_await conn_->async_write_all(chunk.data(), chunk.size());
-    
-    if (!result) {
-        co_return unexpected(result.error());
-    }
-    
-    co_return expected<void, Error>{};
+        if (headers_sent_) {
+            co_return expected<void, Error>{};
+        }
+        co_return co_await send({});
+    }
+    
+    // Size line, payload and CRLF are gathered; the payload is not copied
+    char size_line[24];
+    int size_len = std::snprintf(size_line, sizeof(size_line), "%zx\r\n", data.size());
+    const net::IoVec parts[] = {
+        {size_line, static_cast<size_t>(size_len)},
+        {data.data(), data.size()},
+        {"\r\n", 2},
+    };
+    co_return co_await send(parts);
 }
 
 Task<expected<void, Error>> ChunkedResponse::finish() {
@@ -187,15 +201,7 @@ Task<expected<void, Error>> ChunkedResponse::finish() {
         co_return expected<void, Error>{};  // Already finished
     }
     
-    // Send headers if not sent yet (empty response)
-    if (!headers_sent_) {
-        auto result = co_await send_headers();
-        if (!result) {
-            co_return result;
-        }
-    }
-    
-    // Send final chunk with trailers
+    // Send final chunk with trailers (and the headers, for an empty response)
     std::string final_chunk;
     if (trailers_.empty()) {
         final_chunk = chunked::encode_final_chunk();
@@ -203,10 +209,11 @@ Task<expected<void, Error>> ChunkedResponse::finish() {
         final_chunk = chunked::encode_final_chunk(trailers_);
     }
     
-    auto result = co_await conn_->async_write_all(final_chunk.data(), final_chunk.size());
+    const net::IoVec parts[] = {{final_chunk.data(), final_chunk.size()}};
+    auto result = co_await send(parts);
     
     if (!result) {
-        co_return unexpected(result.error());
+        co_return result;
     }
     
     finished_ = true;
@@ -288,12 +295,7 @@ Task<expected<std::string, Error>> ChunkedBodyReader::read_bytes(size_t n) {
     co_return result;
 }
 
-Task<expected<std::string, Error>> ChunkedBodyReader::read_chunk() {
-    if (finished_) {
-        co_return std::string{};
-    }
-    
-    // Read chunk size line
+Task<expected<size_t, Error>> ChunkedBodyReader::read_chunk_size() {
     auto size_line = co_await read_line();
     if (!size_line) {
         co_return unexpected(size_line.error());
@@ -307,6 +309,7 @@ Task<expected<std::string, Error>> ChunkedBodyReader::read_chunk() {
     // Final chunk
     if (chunk_size == 0) {
         // Read trailers (if any) until empty line
+        size_t trailer_bytes = 0;
         while (true) {
             auto trailer_line = co_await read_line();
             if (!trailer_line) {
@@ -317,6 +320,12 @@ Task<expected<std::string, Error>> ChunkedBodyReader::read_chunk() {
                 break;  // End of trailers
             }
             
+            trailer_bytes += trailer_line->size() + 2;
+            if (trailer_bytes > MAX_TRAILER_SIZE) {
+                co_return unexpected(Error::http(HttpError::RequestHeaderFieldsTooLarge,
+                                                 "Chunked trailers too large"));
+            }
+            
             // Parse trailer
             auto colon = trailer_line->find(':');
             if (colon != std::string::npos) {
@@ -331,11 +340,26 @@ Task<expected<std::string, Error>> ChunkedBodyReader::read_chunk() {
         }
         
         finished_ = true;
+    }
+    
+    co_return static_cast<size_t>(chunk_size);
+}
+
+Task<expected<std::string, Error>> ChunkedBodyReader::read_chunk() {
+    if (finished_) {
+        co_return std::string{};
+    }
+    
+    auto chunk_size = co_await read_chunk_size();
+    if (!chunk_size) {
+        co_return unexpected(chunk_size.error());
+    }
+    if (finished_) {
         co_return std::string{};
     }
     
     // Read chunk data
-    auto chunk_data = co_await read_bytes(static_cast<size_t>(chunk_size));
+    auto chunk_data = co_await read_bytes(*chunk_size);
     if (!chunk_data) {
         co_return unexpected(chunk_data.error());
     }
@@ -353,6 +377,56 @@ Task<expected<std::string, Error>> ChunkedBodyReader::read_chunk() {
     co_return std::move(*chunk_data);
 }
 
+Task<expected<size_t, Error>> ChunkedBodyReader::read_some(char* out, size_t max) {
+    if (finished_ || max == 0) {
+        co_return size_t{0};
+    }
+    
+    while (chunk_remaining_ == 0) {
+        if (chunk_open_) {
+            auto crlf = co_await read_line();
+            if (!crlf) {
+                co_return unexpected(crlf.error());
+            }
+            if (!crlf->empty()) {
+                co_return unexpected(Error::http(HttpError::BadRequest, "Missing CRLF after chunk data"));
+            }
+            chunk_open_ = false;
+        }
+        
+        auto chunk_size = co_await read_chunk_size();
+        if (!chunk_size) {
+            co_return unexpected(chunk_size.error());
+        }
+        if (finished_) {
+            co_return size_t{0};
+        }
+        chunk_remaining_ = *chunk_size;
+        chunk_open_ = true;
+    }
+    
+    size_t n = std::min(max, chunk_remaining_);
+    if (!buffer_.empty()) {
+        // Data that came in with an earlier read
+        n = std::min(n, buffer_.size());
+        std::memcpy(out, buffer_.data(), n);
+        buffer_.erase(0, n);
+    } else {
+        // Straight from the connection; never past this chunk, so the size
+        // line that follows is read by read_line()
+        auto result = co_await conn_->async_read(out, n);
+        if (!result) {
+            co_return unexpected(result.error());
+        }
+        if (*result == 0) {
+            co_return unexpected(Error::http(HttpError::BadRequest, "Connection closed while reading chunk data"));
+        }
+        n = *result;
+    }
+    chunk_remaining_ -= n;
+    co_return n;
+}
+
 Task<expected<std::string, Error>> ChunkedBodyReader::read_all(size_t max_size) {
     std::string result;
     
@@ -460,12 +460,8 @@ Task<Response> CompressionMiddleware::operator()(Request& req, Next next) {
     Response resp = co_await next(req);
     
     // Skip if response already has Content-Encoding
-    if (options_.skip_if_encoded) {
-        for (const auto& [key, value] : resp.headers()) {
-            if (key == "Content-Encoding") {
-                co_return resp;
-            }
-        }
+    if (options_.skip_if_encoded && resp.header(KnownHeader::ContentEncoding)) {
+        co_return resp;
     }
     
     // Check body size
@@ -474,20 +470,14 @@ Task<Response> CompressionMiddleware::operator()(Request& req, Next next) {
     }
     
     // Check content type
-    std::string_view content_type;
-    for (const auto& [key, value] : resp.headers()) {
-        if (key == "Content-Type") {
-            content_type = value;
-            break;
-        }
-    }
+    std::string_view content_type = resp.header(KnownHeader::ContentType).value_or("");
     
     if (content_type.empty() || !should_compress(content_type)) {
         co_return resp;
     }
     
     // Parse Accept-Encoding
-    auto accept_encoding = req.header("Accept-Encoding");
+    auto accept_encoding = req.header(KnownHeader::AcceptEncoding);
     if (!accept_encoding) {
         co_return resp;
     }
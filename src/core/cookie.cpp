@@ -132,7 +132,7 @@ CookieJar CookieJar::parse(std::string_view header) {
 }
 
 CookieJar CookieJar::from_request(const Request& req) {
-    auto cookie_header = req.header("Cookie");
+    auto cookie_header = req.header(KnownHeader::Cookie);
     if (!cookie_header) {
         return CookieJar{};
     }
@@ -54,7 +54,9 @@ public:
             case HttpError::PayloadTooLarge: return "Payload Too Large";
             case HttpError::UriTooLong: return "URI Too Long";
             case HttpError::UnsupportedMediaType: return "Unsupported Media Type";
+            case HttpError::ExpectationFailed: return "Expectation Failed";
             case HttpError::TooManyRequests: return "Too Many Requests";
+            case HttpError::RequestHeaderFieldsTooLarge: return "Request Header Fields Too Large";
             case HttpError::Internal: return "Internal Server Error";
             case HttpError::NotImplemented: return "Not Implemented";
             case HttpError::BadGateway: return "Bad Gateway";
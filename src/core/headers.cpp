@@ -0,0 +1,147 @@
+#include "coroute/core/headers.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+namespace coroute {
+
+namespace {
+
+constexpr char ascii_lower(char c) noexcept {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+// Canonical names, indexed by KnownHeader
+constexpr std::string_view KNOWN_NAMES[] = {
+    "Host",
+    "Connection",
+    "Content-Length",
+    "Content-Type",
+    "Transfer-Encoding",
+    "Cookie",
+    "Accept-Encoding",
+    "Upgrade",
+    "Expect",
+    "Range",
+    "If-None-Match",
+    "If-Modified-Since",
+    "Content-Encoding",
+    "Date",
+};
+static_assert(std::size(KNOWN_NAMES) == static_cast<size_t>(KnownHeader::Count));
+
+// A known name lowered and packed into words, with 0x20 set in the mask
+// at each letter: (word | mask) == lower then accepts either case of a
+// letter and only the exact byte elsewhere
+struct FoldedName {
+    uint64_t lower[3] = {};
+    uint64_t mask[3] = {};
+};
+
+constexpr FoldedName fold(std::string_view name) {
+    FoldedName f;
+    for (size_t i = 0; i < name.size(); ++i) {
+        size_t shift = std::endian::native == std::endian::little ? (i % 8) * 8 : (7 - i % 8) * 8;
+        char c = ascii_lower(name[i]);
+        f.lower[i / 8] |= static_cast<uint64_t>(static_cast<unsigned char>(c)) << shift;
+        if (c >= 'a' && c <= 'z') {
+            f.mask[i / 8] |= uint64_t{0x20} << shift;
+        }
+    }
+    return f;
+}
+
+constexpr auto FOLDED = [] {
+    std::array<FoldedName, std::size(KNOWN_NAMES)> folded{};
+    for (size_t i = 0; i < folded.size(); ++i) {
+        folded[i] = fold(KNOWN_NAMES[i]);
+    }
+    return folded;
+}();
+
+// `name` has exactly N bytes, the length of `header`
+template <size_t N>
+bool is(std::string_view name, KnownHeader header) noexcept {
+    static_assert(N <= 24);
+    const FoldedName& f = FOLDED[static_cast<size_t>(header)];
+    for (size_t w = 0; w < (N + 7) / 8; ++w) {
+        uint64_t word = 0;
+        std::memcpy(&word, name.data() + w * 8, w * 8 + 8 <= N ? 8 : N % 8);
+        if ((word | f.mask[w]) != f.lower[w]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool iequals(std::string_view a, std::string_view b) noexcept {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] != b[i] && ascii_lower(a[i]) != ascii_lower(b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+KnownHeader known_header(std::string_view name) noexcept {
+    // The length alone rules out almost every other name; at most two
+    // candidates share one
+    switch (name.size()) {
+        case 4:
+            if (is<4>(name, KnownHeader::Host)) return KnownHeader::Host;
+            if (is<4>(name, KnownHeader::Date)) return KnownHeader::Date;
+            break;
+        case 5:
+            if (is<5>(name, KnownHeader::Range)) return KnownHeader::Range;
+            break;
+        case 6:
+            if (is<6>(name, KnownHeader::Cookie)) return KnownHeader::Cookie;
+            if (is<6>(name, KnownHeader::Expect)) return KnownHeader::Expect;
+            break;
+        case 7:
+            if (is<7>(name, KnownHeader::Upgrade)) return KnownHeader::Upgrade;
+            break;
+        case 10:
+            if (is<10>(name, KnownHeader::Connection)) return KnownHeader::Connection;
+            break;
+        case 12:
+            if (is<12>(name, KnownHeader::ContentType)) return KnownHeader::ContentType;
+            break;
+        case 13:
+            if (is<13>(name, KnownHeader::IfNoneMatch)) return KnownHeader::IfNoneMatch;
+            break;
+        case 14:
+            if (is<14>(name, KnownHeader::ContentLength)) return KnownHeader::ContentLength;
+            break;
+        case 15:
+            if (is<15>(name, KnownHeader::AcceptEncoding)) return KnownHeader::AcceptEncoding;
+            break;
+        case 16:
+            if (is<16>(name, KnownHeader::ContentEncoding)) return KnownHeader::ContentEncoding;
+            break;
+        case 17:
+            if (is<17>(name, KnownHeader::TransferEncoding)) return KnownHeader::TransferEncoding;
+            if (is<17>(name, KnownHeader::IfModifiedSince)) return KnownHeader::IfModifiedSince;
+            break;
+        default:
+            break;
+    }
+    return KnownHeader::Count;
+}
+
+std::string_view known_header_name(KnownHeader header) noexcept {
+    if (header >= KnownHeader::Count) {
+        return {};
+    }
+    return KNOWN_NAMES[static_cast<size_t>(header)];
+}
+
+} // namespace coroute
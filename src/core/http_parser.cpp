@@ -0,0 +1,430 @@
+#include "coroute/core/http_parser.hpp"
+#include "coroute/core/form.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__))
+#define COROUTE_PARSER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace coroute::http1 {
+
+namespace {
+
+// ============================================================================
+// Character Classes
+// ============================================================================
+
+// tchar per RFC 9110 section 5.6.2
+constexpr bool is_tchar(unsigned char c) {
+    if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+        return true;
+    }
+    return c != 0 && std::string_view("!#$%&'*+-.^_`|~").find(static_cast<char>(c)) !=
+                         std::string_view::npos;
+}
+
+// Bytes not allowed in a field value or request line: controls except HTAB
+// (this includes CR and LF, which end the line) and DEL
+constexpr bool is_ctl(unsigned char c) {
+    return (c < 0x20 && c != '\t') || c == 0x7f;
+}
+
+constexpr std::array<bool, 256> make_table(bool (*pred)(unsigned char)) {
+    std::array<bool, 256> table{};
+    for (unsigned c = 0; c < 256; ++c) {
+        table[c] = pred(static_cast<unsigned char>(c));
+    }
+    return table;
+}
+
+constexpr auto TOKEN_TABLE = make_table(is_tchar);
+constexpr auto CTL_TABLE = make_table(is_ctl);
+
+// ============================================================================
+// Kernels
+// ============================================================================
+
+// Each returns the first matching byte in [p, end), or end
+struct Kernels {
+    const char* (*find_cr)(const char* p, const char* end);
+    const char* (*find_ctl)(const char* p, const char* end);
+    const char* (*find_non_token)(const char* p, const char* end);
+};
+
+const char* scalar_find_cr(const char* p, const char* end) {
+    auto* cr = static_cast<const char*>(std::memchr(p, '\r', static_cast<size_t>(end - p)));
+    return cr ? cr : end;
+}
+
+const char* scalar_find_ctl(const char* p, const char* end) {
+    while (p < end && !CTL_TABLE[static_cast<unsigned char>(*p)]) {
+        ++p;
+    }
+    return p;
+}
+
+const char* scalar_find_non_token(const char* p, const char* end) {
+    while (p < end && TOKEN_TABLE[static_cast<unsigned char>(*p)]) {
+        ++p;
+    }
+    return p;
+}
+
+constexpr Kernels SCALAR_KERNELS{scalar_find_cr, scalar_find_ctl, scalar_find_non_token};
+
+#ifdef COROUTE_PARSER_X86
+
+// Nibble lookup tables for tchar: byte b is a token character iff
+// TOKEN_LO[b & 15] & TOKEN_HI[b >> 4] is non-zero. Bit n of TOKEN_LO[lo]
+// says whether (n << 4 | lo) is a tchar; non-ASCII high nibbles map to 0.
+constexpr std::array<uint8_t, 16> make_token_lo() {
+    std::array<uint8_t, 16> lut{};
+    for (unsigned c = 0; c < 128; ++c) {
+        if (is_tchar(static_cast<unsigned char>(c))) {
+            lut[c & 15] = static_cast<uint8_t>(lut[c & 15] | (1u << (c >> 4)));
+        }
+    }
+    return lut;
+}
+
+constexpr std::array<uint8_t, 16> make_token_hi() {
+    std::array<uint8_t, 16> lut{};
+    for (unsigned hi = 0; hi < 8; ++hi) {
+        lut[hi] = static_cast<uint8_t>(1u << hi);
+    }
+    return lut;
+}
+
+alignas(16) constexpr auto TOKEN_LO = make_token_lo();
+alignas(16) constexpr auto TOKEN_HI = make_token_hi();
+
+inline const char* first_set(const char* p, uint32_t mask) {
+    return p + __builtin_ctz(mask);
+}
+
+// ----- SSE4.2 (16 bytes per step) -----
+
+// Also inlined into the AVX2 kernels for their tails, which keeps those
+// VEX-encoded and avoids SSE/AVX transition stalls
+#define COROUTE_SSE42 __attribute__((target("sse4.2"), always_inline)) inline
+
+COROUTE_SSE42 const char* sse42_find_cr(const char* p, const char* end) {
+    const __m128i cr = _mm_set1_epi8('\r');
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, cr)));
+        if (mask != 0) {
+            return first_set(p, mask);
+        }
+    }
+    return scalar_find_cr(p, end);
+}
+
+COROUTE_SSE42 const char* sse42_find_ctl(const char* p, const char* end) {
+    // Ranges 0x00-0x08, 0x0a-0x1f and 0x7f, matched by PCMPESTRI
+    alignas(16) static const char ranges[16] = "\x00\x08\x0a\x1f\x7f\x7f";
+    const __m128i set = _mm_load_si128(reinterpret_cast<const __m128i*>(ranges));
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        int index = _mm_cmpestri(set, 6, v, 16,
+                                 _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT);
+        if (index != 16) {
+            return p + index;
+        }
+    }
+    return scalar_find_ctl(p, end);
+}
+
+COROUTE_SSE42 const char* sse42_find_non_token(const char* p, const char* end) {
+    const __m128i lo_lut = _mm_load_si128(reinterpret_cast<const __m128i*>(TOKEN_LO.data()));
+    const __m128i hi_lut = _mm_load_si128(reinterpret_cast<const __m128i*>(TOKEN_HI.data()));
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    const __m128i zero = _mm_setzero_si128();
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i lo = _mm_shuffle_epi8(lo_lut, _mm_and_si128(v, nibble));
+        __m128i hi = _mm_shuffle_epi8(hi_lut, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+        __m128i bad = _mm_cmpeq_epi8(_mm_and_si128(lo, hi), zero);
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(bad));
+        if (mask != 0) {
+            return first_set(p, mask);
+        }
+    }
+    return scalar_find_non_token(p, end);
+}
+
+constexpr Kernels SSE42_KERNELS{sse42_find_cr, sse42_find_ctl, sse42_find_non_token};
+
+// ----- AVX2 (32 bytes per step) -----
+
+__attribute__((target("avx2")))
+const char* avx2_find_cr(const char* p, const char* end) {
+    const __m256i cr = _mm256_set1_epi8('\r');
+    for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, cr)));
+        if (mask != 0) {
+            return first_set(p, mask);
+        }
+    }
+    return sse42_find_cr(p, end);
+}
+
+__attribute__((target("avx2")))
+const char* avx2_find_ctl(const char* p, const char* end) {
+    const __m256i max_ctl = _mm256_set1_epi8(0x1f);
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i del = _mm256_set1_epi8(0x7f);
+    for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        // Unsigned v <= 0x1f, minus HTAB, plus DEL
+        __m256i ctl = _mm256_cmpeq_epi8(_mm256_min_epu8(v, max_ctl), v);
+        ctl = _mm256_andnot_si256(_mm256_cmpeq_epi8(v, tab), ctl);
+        ctl = _mm256_or_si256(ctl, _mm256_cmpeq_epi8(v, del));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(ctl));
+        if (mask != 0) {
+            return first_set(p, mask);
+        }
+    }
+    return sse42_find_ctl(p, end);
+}
+
+__attribute__((target("avx2")))
+const char* avx2_find_non_token(const char* p, const char* end) {
+    const __m256i lo_lut = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(TOKEN_LO.data())));
+    const __m256i hi_lut = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(TOKEN_HI.data())));
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const __m256i zero = _mm256_setzero_si256();
+    for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i lo = _mm256_shuffle_epi8(lo_lut, _mm256_and_si256(v, nibble));
+        __m256i hi = _mm256_shuffle_epi8(hi_lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+        __m256i bad = _mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), zero);
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(bad));
+        if (mask != 0) {
+            return first_set(p, mask);
+        }
+    }
+    return sse42_find_non_token(p, end);
+}
+
+constexpr Kernels AVX2_KERNELS{avx2_find_cr, avx2_find_ctl, avx2_find_non_token};
+
+#endif // COROUTE_PARSER_X86
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+bool cpu_supports(Isa isa) noexcept {
+#ifdef COROUTE_PARSER_X86
+    switch (isa) {
+        case Isa::AVX2: return __builtin_cpu_supports("avx2");
+        case Isa::SSE42: return __builtin_cpu_supports("sse4.2");
+        case Isa::Scalar: return true;
+    }
+    return false;
+#else
+    return isa == Isa::Scalar;
+#endif
+}
+
+const Kernels& kernels_for(Isa isa) noexcept {
+#ifdef COROUTE_PARSER_X86
+    switch (isa) {
+        case Isa::AVX2: return AVX2_KERNELS;
+        case Isa::SSE42: return SSE42_KERNELS;
+        case Isa::Scalar: break;
+    }
+#endif
+    (void)isa;
+    return SCALAR_KERNELS;
+}
+
+struct Active {
+    std::atomic<Isa> isa;
+    std::atomic<const Kernels*> kernels;
+
+    Active() {
+        Isa best = Isa::AVX2;
+        while (!cpu_supports(best)) {
+            best = static_cast<Isa>(static_cast<uint8_t>(best) - 1);
+        }
+        isa.store(best);
+        kernels.store(&kernels_for(best));
+    }
+};
+
+Active& active() noexcept {
+    static Active state;
+    return state;
+}
+
+const Kernels& kernels() noexcept {
+    return *active().kernels.load(std::memory_order_relaxed);
+}
+
+Error bad_request(const char* reason) {
+    return Error::http(HttpError::BadRequest, reason);
+}
+
+void parse_query(std::string_view qs, Request& req) {
+    while (!qs.empty()) {
+        auto amp = qs.find('&');
+        std::string_view param = (amp != std::string_view::npos) ? qs.substr(0, amp) : qs;
+
+        auto eq = param.find('=');
+        if (eq != std::string_view::npos) {
+            req.add_query_param(form::url_decode(param.substr(0, eq)),
+                                form::url_decode(param.substr(eq + 1)));
+        } else if (!param.empty()) {
+            // Parameter without value
+            req.add_query_param(form::url_decode(param), "");
+        }
+
+        if (amp == std::string_view::npos) {
+            break;
+        }
+        qs = qs.substr(amp + 1);
+    }
+}
+
+} // namespace
+
+Isa active_isa() noexcept {
+    return active().isa.load(std::memory_order_relaxed);
+}
+
+std::string_view isa_name(Isa isa) noexcept {
+    switch (isa) {
+        case Isa::Scalar: return "scalar";
+        case Isa::SSE42: return "sse4.2";
+        case Isa::AVX2: return "avx2";
+    }
+    return "unknown";
+}
+
+Isa set_isa(Isa isa) noexcept {
+    while (!cpu_supports(isa)) {
+        isa = static_cast<Isa>(static_cast<uint8_t>(isa) - 1);
+    }
+    active().isa.store(isa, std::memory_order_relaxed);
+    active().kernels.store(&kernels_for(isa), std::memory_order_relaxed);
+    return isa;
+}
+
+// ============================================================================
+// Parsing
+// ============================================================================
+
+size_t find_head_end(std::string_view data, size_t from) noexcept {
+    const char* begin = data.data();
+    const char* end = begin + data.size();
+    // A terminator may straddle the previous scan's end
+    const char* p = begin + (from >= 3 ? std::min(from - 3, data.size()) : 0);
+
+    const auto find_cr = kernels().find_cr;
+    while ((p = find_cr(p, end)) != end) {
+        if (end - p < 4) {
+            break;
+        }
+        if (p[1] == '\n' && p[2] == '\r' && p[3] == '\n') {
+            return static_cast<size_t>(p + 4 - begin);
+        }
+        ++p;
+    }
+    return std::string_view::npos;
+}
+
+expected<void, Error> parse_head(std::string_view head, Request& req) {
+    const Kernels& k = kernels();
+    const char* p = head.data();
+    const char* end = p + head.size();
+
+    // ----- Request line: method SP request-target SP HTTP-version CRLF -----
+
+    const char* method_end = k.find_non_token(p, end);
+    if (method_end == p || method_end == end || *method_end != ' ') {
+        return unexpected(bad_request("Invalid request method"));
+    }
+    req.set_method(std::string_view(p, static_cast<size_t>(method_end - p)));
+
+    const char* target = method_end + 1;
+    const char* line_end = k.find_ctl(target, end);
+    if (end - line_end < 2 || line_end[0] != '\r' || line_end[1] != '\n') {
+        return unexpected(bad_request("Invalid request line"));
+    }
+
+    std::string_view rest(target, static_cast<size_t>(line_end - target));
+    auto space = rest.find(' ');
+    if (space == 0 || space == std::string_view::npos) {
+        return unexpected(bad_request("Invalid request line"));
+    }
+    std::string_view path_with_query = rest.substr(0, space);
+    std::string_view version = rest.substr(space + 1);
+    if (version.size() != 8 || !version.starts_with("HTTP/") || version[6] != '.' ||
+        version[5] < '0' || version[5] > '9' || version[7] < '0' || version[7] > '9') {
+        return unexpected(bad_request("Invalid HTTP version"));
+    }
+    req.set_http_version_view(version);
+
+    std::string_view path = path_with_query;
+    auto query_start = path_with_query.find('?');
+    if (query_start != std::string_view::npos) {
+        path = path_with_query.substr(0, query_start);
+        std::string_view qs = path_with_query.substr(query_start + 1);
+        req.set_query_string_view(qs);
+        parse_query(qs, req);
+    }
+    // Only paths with escapes need a decoded copy
+    if (path.find_first_of("%+") != std::string_view::npos) {
+        req.set_path(form::url_decode(path));
+    } else {
+        req.set_path_view(path);
+    }
+
+    // ----- Header fields: name ":" OWS value OWS CRLF -----
+
+    p = line_end + 2;
+    while (true) {
+        if (end - p < 2) {
+            return unexpected(bad_request("Incomplete request headers"));
+        }
+        if (p[0] == '\r' && p[1] == '\n') {
+            break;  // Blank line ends the head
+        }
+
+        // Leading whitespace (obsolete line folding) fails here as well
+        const char* name_end = k.find_non_token(p, end);
+        if (name_end == p || name_end == end || *name_end != ':') {
+            return unexpected(bad_request("Invalid header name"));
+        }
+
+        const char* value = name_end + 1;
+        while (value < end && (*value == ' ' || *value == '\t')) {
+            ++value;
+        }
+        const char* value_end = k.find_ctl(value, end);
+        if (end - value_end < 2 || value_end[0] != '\r' || value_end[1] != '\n') {
+            return unexpected(bad_request("Invalid header value"));
+        }
+        const char* trimmed = value_end;
+        while (trimmed > value && (trimmed[-1] == ' ' || trimmed[-1] == '\t')) {
+            --trimmed;
+        }
+
+        req.append_header_view(std::string_view(p, static_cast<size_t>(name_end - p)),
+                               std::string_view(value, static_cast<size_t>(trimmed - value)));
+        p = value_end + 2;
+    }
+
+    return {};
+}
+
+} // namespace coroute::http1
@@ -0,0 +1,234 @@
+#include "coroute/core/http_writer.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <string>
+
+namespace coroute::http1 {
+
+namespace {
+
+constexpr int FIRST_STATUS = 100;
+constexpr int LAST_STATUS = 599;
+
+constexpr std::string_view CONNECTION_CLOSE = "Connection: close\r\n";
+constexpr std::string_view CONNECTION_KEEP_ALIVE = "Connection: keep-alive\r\n";
+constexpr std::string_view KEEP_ALIVE = "Keep-Alive: ";
+constexpr std::string_view MAX_PARAM = ", max=";
+
+// "Date: " + IMF-fixdate + CRLF
+constexpr size_t DATE_HEADER_SIZE = 37;
+
+// Every status line back to back, so each one is a slice of one string
+class StatusLines {
+    std::string storage_;
+    std::array<uint32_t, LAST_STATUS - FIRST_STATUS + 2> offsets_{};
+
+public:
+    StatusLines() {
+        for (int status = FIRST_STATUS; status <= LAST_STATUS; ++status) {
+            offsets_[status - FIRST_STATUS] = static_cast<uint32_t>(storage_.size());
+            storage_ += "HTTP/1.1 ";
+            storage_ += std::to_string(status);
+            storage_ += ' ';
+            storage_ += Response::default_status_text(status);
+            storage_ += "\r\n";
+        }
+        offsets_.back() = static_cast<uint32_t>(storage_.size());
+    }
+
+    std::string_view get(int status) const noexcept {
+        if (status < FIRST_STATUS || status > LAST_STATUS) {
+            return {};
+        }
+        size_t i = static_cast<size_t>(status - FIRST_STATUS);
+        return std::string_view(storage_).substr(offsets_[i], offsets_[i + 1] - offsets_[i]);
+    }
+};
+
+const StatusLines& status_lines() {
+    static const StatusLines lines;
+    return lines;
+}
+
+size_t decimal_digits(size_t value) noexcept {
+    size_t digits = 1;
+    while (value >= 10) {
+        value /= 10;
+        ++digits;
+    }
+    return digits;
+}
+
+char* put(char* out, std::string_view s) noexcept {
+    std::memcpy(out, s.data(), s.size());
+    return out + s.size();
+}
+
+char* put_decimal(char* out, size_t value) noexcept {
+    size_t digits = decimal_digits(value);
+    for (size_t i = digits; i > 0; --i) {
+        out[i - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    return out + digits;
+}
+
+char* put_two_digits(char* out, unsigned value) noexcept {
+    out[0] = static_cast<char>('0' + value / 10);
+    out[1] = static_cast<char>('0' + value % 10);
+    return out + 2;
+}
+
+void format_date(char* out, std::chrono::sys_seconds now) noexcept {
+    static constexpr std::string_view DAYS[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    static constexpr std::string_view MONTHS[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                                  "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+    auto days = std::chrono::floor<std::chrono::days>(now);
+    std::chrono::year_month_day date{days};
+    std::chrono::hh_mm_ss time{now - days};
+    unsigned weekday = std::chrono::weekday{days}.c_encoding();
+    int year = static_cast<int>(date.year());
+
+    out = put(out, "Date: ");
+    out = put(out, DAYS[weekday]);
+    out = put(out, ", ");
+    out = put_two_digits(out, static_cast<unsigned>(date.day()));
+    *out++ = ' ';
+    out = put(out, MONTHS[static_cast<unsigned>(date.month()) - 1]);
+    *out++ = ' ';
+    out = put_two_digits(out, static_cast<unsigned>(year / 100));
+    out = put_two_digits(out, static_cast<unsigned>(year % 100));
+    *out++ = ' ';
+    out = put_two_digits(out, static_cast<unsigned>(time.hours().count()));
+    *out++ = ':';
+    out = put_two_digits(out, static_cast<unsigned>(time.minutes().count()));
+    *out++ = ':';
+    out = put_two_digits(out, static_cast<unsigned>(time.seconds().count()));
+    put(out, " GMT\r\n");
+}
+
+struct DateCache {
+    std::chrono::sys_seconds second{std::chrono::seconds(-1)};
+    char text[DATE_HEADER_SIZE];
+};
+
+thread_local DateCache date_cache;
+
+bool adds_date(const Response& resp, const HeadOptions& options) noexcept {
+    return options.date && !resp.headers().contains(KnownHeader::Date);
+}
+
+// Produce the head as a sequence of pieces, each passed to `emit`
+template<typename Emit>
+void emit_head(const Response& resp, const HeadOptions& options, Emit&& emit) {
+    char digits[20];
+    auto decimal = [&](size_t value) {
+        return std::string_view(digits, static_cast<size_t>(put_decimal(digits, value) - digits));
+    };
+
+    if (auto line = status_line(resp.status()); !line.empty()) {
+        emit(line);
+    } else {
+        emit("HTTP/1.1 ");
+        emit(decimal(static_cast<size_t>(resp.status() < 0 ? 0 : resp.status())));
+        emit(" ");
+        emit(resp.status_text());
+        emit("\r\n");
+    }
+
+    for (const auto& [name, value] : resp.headers()) {
+        emit(name);
+        emit(": ");
+        emit(value);
+        emit("\r\n");
+    }
+
+    if (adds_date(resp, options)) {
+        emit(date_header());
+    }
+
+    switch (options.connection) {
+        case HeadOptions::Connection::None:
+            break;
+        case HeadOptions::Connection::Close:
+            emit(CONNECTION_CLOSE);
+            break;
+        case HeadOptions::Connection::KeepAlive:
+            emit(CONNECTION_KEEP_ALIVE);
+            if (!options.keep_alive.empty()) {
+                emit(KEEP_ALIVE);
+                emit(options.keep_alive);
+                if (options.max_requests > 0) {
+                    emit(MAX_PARAM);
+                    emit(decimal(options.max_requests));
+                }
+                emit("\r\n");
+            }
+            break;
+    }
+
+    emit("\r\n");
+}
+
+} // namespace
+
+std::string_view status_line(int status) noexcept {
+    return status_lines().get(status);
+}
+
+std::string_view date_header() noexcept {
+    auto now = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+    if (now != date_cache.second) {
+        format_date(date_cache.text, now);
+        date_cache.second = now;
+    }
+    return std::string_view(date_cache.text, DATE_HEADER_SIZE);
+}
+
+size_t head_size(const Response& resp, const HeadOptions& options) noexcept {
+    size_t size = status_line(resp.status()).size();
+    if (size == 0) {
+        // "HTTP/1.1 " status SP reason CRLF
+        size = 9 + decimal_digits(static_cast<size_t>(resp.status() < 0 ? 0 : resp.status())) +
+               1 + resp.status_text().size() + 2;
+    }
+    for (const auto& [name, value] : resp.headers()) {
+        size += name.size() + 2 + value.size() + 2;
+    }
+    if (adds_date(resp, options)) {
+        size += DATE_HEADER_SIZE;
+    }
+    switch (options.connection) {
+        case HeadOptions::Connection::None:
+            break;
+        case HeadOptions::Connection::Close:
+            size += CONNECTION_CLOSE.size();
+            break;
+        case HeadOptions::Connection::KeepAlive:
+            size += CONNECTION_KEEP_ALIVE.size();
+            if (!options.keep_alive.empty()) {
+                size += KEEP_ALIVE.size() + options.keep_alive.size() + 2;
+                if (options.max_requests > 0) {
+                    size += MAX_PARAM.size() + decimal_digits(options.max_requests);
+                }
+            }
+            break;
+    }
+    return size + 2;
+}
+
+char* write_head(char* out, const Response& resp, const HeadOptions& options) noexcept {
+    emit_head(resp, options, [&](std::string_view piece) { out = put(out, piece); });
+    return out;
+}
+
+void append_head(std::vector<char>& out, const Response& resp, const HeadOptions& options) {
+    emit_head(resp, options, [&](std::string_view piece) {
+        out.insert(out.end(), piece.begin(), piece.end());
+    });
+}
+
+} // namespace coroute::http1
@@ -250,7 +250,7 @@ Middleware request_logger(Logger& logger, RequestLogOptions options) {
         
         if (options.log_headers) {
             for (const auto& [key, value] : req.headers()) {
-                entry.field("req_" + key, value);
+                entry.field("req_" + std::string(key), std::string(value));
             }
         }
         
@@ -191,11 +191,11 @@ std::optional<RangeHeader> parse(std::string_view header) {
 }
 
 bool has_range_header(const Request& req) {
-    return req.header("Range").has_value();
+    return req.headers().contains(KnownHeader::Range);
 }
 
 std::optional<RangeHeader> get_range(const Request& req) {
-    auto header = req.header("Range");
+    auto header = req.header(KnownHeader::Range);
     if (!header) {
         return std::nullopt;
     }
@@ -1,9 +1,21 @@
 #include "coroute/core/request.hpp"
+#include "coroute/core/body_stream.hpp"
 #include <algorithm>
 #include <cctype>
 
 namespace coroute {
 
+BodyStream& Request::body_stream() {
+    if (!body_stream_) {
+        body_stream_ = std::make_shared<BodyStream>();
+    }
+    return *body_stream_;
+}
+
+bool Request::body_pending() const noexcept {
+    return body_stream_ && !body_stream_->finished();
+}
+
 HttpMethod parse_method(std::string_view method) noexcept {
     if (method == "GET") return HttpMethod::GET;
     if (method == "POST") return HttpMethod::POST;
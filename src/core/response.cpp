@@ -1,43 +1,23 @@
 #include "coroute/core/response.hpp"
-#include <sstream>
+#include "coroute/core/http_writer.hpp"
+
+#include <cstring>
 
 namespace coroute {
 
 std::string Response::serialize() const {
-    std::ostringstream oss;
-    
-    // Status line
-    oss << "HTTP/1.1 " << status_ << " " << status_text_ << "\r\n";
-    
-    // Headers
-    for (const auto& [key, value] : headers_) {
-        oss << key << ": " << value << "\r\n";
+    std::string out(http1::head_size(*this) + body_.size(), '\0');
+    char* end = http1::write_head(out.data(), *this);
+    if (!body_.empty()) {
+        std::memcpy(end, body_.data(), body_.size());
     }
-    
-    // Empty line separating headers from body
-    oss << "\r\n";
-    
-    // Body
-    oss << body_;
-    
-    return oss.str();
+    return out;
 }
 
 std::string Response::serialize_headers() const {
-    std::ostringstream oss;
-    
-    // Status line
-    oss << "HTTP/1.1 " << status_ << " " << status_text_ << "\r\n";
-    
-    // Headers
-    for (const auto& [key, value] : headers_) {
-        oss << key << ": " << value << "\r\n";
-    }
-    
-    // Empty line separating headers from body
-    oss << "\r\n";
-    
-    return oss.str();
+    std::string out(http1::head_size(*this), '\0');
+    http1::write_head(out.data(), *this);
+    return out;
 }
 
 std::string_view Response::default_status_text(int status) noexcept {
@@ -72,8 +52,10 @@ std::string_view Response::default_status_text(int status) noexcept {
         case 413: return "Payload Too Large";
         case 414: return "URI Too Long";
         case 415: return "Unsupported Media Type";
+        case 417: return "Expectation Failed";
         case 422: return "Unprocessable Entity";
         case 429: return "Too Many Requests";
+        case 431: return "Request Header Fields Too Large";
         
         // 5xx Server Errors
         case 500: return "Internal Server Error";
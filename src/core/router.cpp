@@ -114,7 +114,8 @@ Router::convert_pattern(std::string_view pattern) {
   return {matcher_pattern.str(), std::move(param_names)};
 }
 
-void Router::add(HttpMethod method, std::string pattern, Handler handler) {
+void Router::add(HttpMethod method, std::string pattern, Handler handler,
+                 RouteOptions options) {
   // Convert pattern to url-matcher format
   auto [matcher_pattern, param_names] = convert_pattern(pattern);
 
@@ -123,7 +124,8 @@ void Router::add(HttpMethod method, std::string pattern, Handler handler) {
   routes_.push_back(RouteInfo{.pattern = std::move(pattern),
                               .handler = std::move(handler),
                               .method = method,
-                              .param_names = std::move(param_names)});
+                              .param_names = std::move(param_names),
+                              .options = options});
 
   // Add to the appropriate matcher
   get_matcher_for(method).add_regex(matcher_pattern, route_id);
@@ -150,6 +152,7 @@ Router::MatchResult Router::match(HttpMethod method, std::string_view path) {
 
   const auto &route = routes_[route_id];
   result.handler = &route.handler;
+  result.options = &route.options;
 
   // Extract captured groups as strings
   // url-matcher groups are 0-indexed
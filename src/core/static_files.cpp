@@ -271,7 +271,7 @@ bool StaticFileServer::check_not_modified(
     std::filesystem::file_time_type mtime) const
 {
     // Check If-None-Match (ETag)
-    auto if_none_match = req.header("If-None-Match");
+    auto if_none_match = req.header(KnownHeader::IfNoneMatch);
     if (if_none_match && options_.etag) {
         // Simple comparison (doesn't handle weak ETags or multiple values)
         if (*if_none_match == etag) {
@@ -280,7 +280,7 @@ bool StaticFileServer::check_not_modified(
     }
     
     // Check If-Modified-Since
-    auto if_modified_since = req.header("If-Modified-Since");
+    auto if_modified_since = req.header(KnownHeader::IfModifiedSince);
     if (if_modified_since && options_.last_modified) {
         // Parse the date and compare
         // For simplicity, we'll skip full parsing and just use ETag
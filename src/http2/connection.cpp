@@ -140,6 +140,20 @@ Task<expected<void, Error>> Http2Connection::send_frame(std::span<const uint8_t>
     co_return expected<void, Error>{};
 }
 
+Task<expected<void, Error>> Http2Connection::send_frame(const FrameHeader& header,
+                                                        std::span<const uint8_t> payload) {
+    auto header_bytes = header.serialize();
+    const net::IoVec buffers[] = {
+        {header_bytes.data(), header_bytes.size()},
+        {payload.data(), payload.size()},
+    };
+    auto result = co_await conn_->async_writev(buffers);
+    if (!result) {
+        co_return unexpected(result.error());
+    }
+    co_return expected<void, Error>{};
+}
+
 // ============================================================================
 // Connection Setup
 // ============================================================================
@@ -650,6 +664,17 @@ Task<expected<void, Error>> Http2Connection::send_window_update(uint32_t stream_
 }
 
 Task<expected<size_t, Error>> Http2Connection::read_more() {
+    // Provided-buffer mode: append straight from the leased buffer
+    if (conn_->supports_read_lease()) {
+        auto lease = co_await conn_->async_read_lease();
+        if (!lease) {
+            co_return unexpected(lease.error());
+        }
+        auto* bytes = reinterpret_cast<const uint8_t*>(lease->data());
+        read_buffer_.insert(read_buffer_.end(), bytes, bytes + lease->size());
+        co_return lease->size();
+    }
+    
     std::array<uint8_t, 16384> buf;
     auto result = co_await conn_->async_read(buf.data(), buf.size());
     if (!result) {
@@ -673,8 +698,8 @@ bool is_http2_preface(std::span<const uint8_t> data) {
 }
 
 bool is_h2c_upgrade_request(const Request& req) {
-    auto connection = req.header("Connection");
-    auto upgrade = req.header("Upgrade");
+    auto connection = req.header(KnownHeader::Connection);
+    auto upgrade = req.header(KnownHeader::Upgrade);
     auto settings = req.header("HTTP2-Settings");
     
     if (!connection || !upgrade || !settings) {
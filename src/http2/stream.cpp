@@ -208,11 +208,15 @@ Task<expected<void, Error>> Stream::send_headers(
         co_return unexpected(encoded.error());
     }
     
-    // Serialize HEADERS frame
-    auto frame = serialize_headers_frame(id_, *encoded, end_stream, true);
+    FrameHeader header;
+    header.length = static_cast<uint32_t>(encoded->size());
+    header.type = FrameType::Headers;
+    header.flags = FrameFlags::EndHeaders;
+    if (end_stream) header.flags |= FrameFlags::EndStream;
+    header.stream_id = id_;
     
-    // Send frame
-    co_return co_await connection_->send_frame(frame);
+    // Send frame header and header block together
+    co_return co_await connection_->send_frame(header, *encoded);
 }
 
 Task<expected<void, Error>> Stream::send_data(
@@ -233,13 +237,14 @@ Task<expected<void, Error>> Stream::send_data(
         bool is_last = (offset + chunk_size >= data.size());
         bool frame_end_stream = end_stream && is_last;
         
-        auto frame = serialize_data_frame(
-            id_,
-            data.subspan(offset, chunk_size),
-            frame_end_stream
-        );
+        FrameHeader header;
+        header.length = static_cast<uint32_t>(chunk_size);
+        header.type = FrameType::Data;
+        header.flags = frame_end_stream ? FrameFlags::EndStream : 0;
+        header.stream_id = id_;
         
-        auto result = co_await connection_->send_frame(frame);
+        // Gather header and body slice; the body is not copied
+        auto result = co_await connection_->send_frame(header, data.subspan(offset, chunk_size));
         if (!result) {
             co_return unexpected(result.error());
         }
@@ -0,0 +1,268 @@
+#include "coroute/net/endpoint.hpp"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#endif
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace coroute::net {
+
+namespace {
+
+Error invalid_endpoint(std::string_view text, const char* reason) {
+    std::string msg = "Invalid endpoint '";
+    msg.append(text);
+    msg += "': ";
+    msg += reason;
+    return Error::io(IoError::InvalidArgument, std::move(msg));
+}
+
+bool parse_port(std::string_view text, uint16_t& port) {
+    if (text.empty()) {
+        return false;
+    }
+    unsigned value = 0;
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc{} || end != text.data() + text.size() || value > 65535) {
+        return false;
+    }
+    port = static_cast<uint16_t>(value);
+    return true;
+}
+
+} // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+Endpoint Endpoint::any(uint16_t port) {
+    Endpoint ep;
+    ep.port_ = port;
+    return ep;
+}
+
+Endpoint Endpoint::ipv4(std::string_view address, uint16_t port) {
+    Endpoint ep;
+    ep.family_ = Family::IPv4;
+    ep.address_ = address;
+    ep.port_ = port;
+    return ep;
+}
+
+Endpoint Endpoint::ipv6(std::string_view address, uint16_t port, bool v6_only) {
+    Endpoint ep;
+    ep.family_ = Family::IPv6;
+    ep.address_ = address;
+    ep.port_ = port;
+    ep.v6_only_ = v6_only;
+    return ep;
+}
+
+Endpoint Endpoint::unix_socket(std::string_view path) {
+    Endpoint ep;
+    ep.family_ = Family::Unix;
+    ep.address_ = path;
+    return ep;
+}
+
+Endpoint Endpoint::abstract_socket(std::string_view name) {
+    Endpoint ep = unix_socket(name);
+    ep.abstract_ = true;
+    return ep;
+}
+
+Endpoint Endpoint::with_port(uint16_t port) const {
+    Endpoint ep = *this;
+    if (family_ != Family::Unix) {
+        ep.port_ = port;
+    }
+    return ep;
+}
+
+expected<Endpoint, Error> Endpoint::parse(std::string_view text) {
+    if (text.starts_with("unix:")) {
+        std::string_view path = text.substr(5);
+        if (path.empty() || path == "@") {
+            return unexpected(invalid_endpoint(text, "empty socket path"));
+        }
+        Endpoint ep = path.front() == '@' ? abstract_socket(path.substr(1)) : unix_socket(path);
+        if (auto addr = ep.to_sockaddr(); !addr) {
+            return unexpected(addr.error());
+        }
+        return ep;
+    }
+
+    uint16_t port = 0;
+    if (text.find(':') == std::string_view::npos) {
+        if (!parse_port(text, port)) {
+            return unexpected(invalid_endpoint(text, "expected a port or host:port"));
+        }
+        return any(port);
+    }
+
+    std::string_view host;
+    std::string_view port_text;
+    if (text.front() == '[') {
+        auto close = text.find(']');
+        if (close == std::string_view::npos || close + 1 >= text.size() || text[close + 1] != ':') {
+            return unexpected(invalid_endpoint(text, "expected [address]:port"));
+        }
+        host = text.substr(1, close - 1);
+        port_text = text.substr(close + 2);
+    } else {
+        auto colon = text.rfind(':');
+        if (text.find(':') != colon) {
+            return unexpected(invalid_endpoint(text, "IPv6 addresses must be bracketed"));
+        }
+        host = text.substr(0, colon);
+        port_text = text.substr(colon + 1);
+    }
+
+    if (!parse_port(port_text, port)) {
+        return unexpected(invalid_endpoint(text, "bad port"));
+    }
+
+    Endpoint ep;
+    if (host.empty() || host == "*") {
+        ep = any(port);
+    } else if (text.front() == '[') {
+        ep = ipv6(host, port);
+    } else {
+        ep = ipv4(host, port);
+    }
+
+    if (auto addr = ep.to_sockaddr(); !addr) {
+        return unexpected(invalid_endpoint(text, "not an IP address literal"));
+    }
+    return ep;
+}
+
+std::string Endpoint::to_string() const {
+    switch (family_) {
+        case Family::Any:
+            return "*:" + std::to_string(port_);
+        case Family::IPv4:
+            return address_ + ":" + std::to_string(port_);
+        case Family::IPv6:
+            return "[" + address_ + "]:" + std::to_string(port_);
+        case Family::Unix:
+            return (abstract_ ? "unix:@" : "unix:") + address_;
+    }
+    return {};
+}
+
+// ============================================================================
+// sockaddr Conversion
+// ============================================================================
+
+expected<SocketAddress, Error> Endpoint::to_sockaddr() const {
+    static_assert(sizeof(SocketAddress::storage) >= sizeof(sockaddr_storage));
+    static_assert(alignof(sockaddr_storage) <= 8);
+
+    SocketAddress out;
+    switch (family_) {
+        case Family::Any:
+        case Family::IPv6: {
+            auto* sin6 = reinterpret_cast<sockaddr_in6*>(out.storage);
+            sin6->sin6_family = AF_INET6;
+            sin6->sin6_port = htons(port_);
+            if (family_ == Family::Any) {
+                sin6->sin6_addr = in6addr_any;
+            } else if (inet_pton(AF_INET6, address_.c_str(), &sin6->sin6_addr) != 1) {
+                return unexpected(invalid_endpoint(to_string(), "not an IPv6 address"));
+            }
+            out.size = sizeof(sockaddr_in6);
+            out.domain = AF_INET6;
+            return out;
+        }
+        case Family::IPv4: {
+            auto* sin = reinterpret_cast<sockaddr_in*>(out.storage);
+            sin->sin_family = AF_INET;
+            sin->sin_port = htons(port_);
+            if (inet_pton(AF_INET, address_.c_str(), &sin->sin_addr) != 1) {
+                return unexpected(invalid_endpoint(to_string(), "not an IPv4 address"));
+            }
+            out.size = sizeof(sockaddr_in);
+            out.domain = AF_INET;
+            return out;
+        }
+        case Family::Unix: {
+#ifdef _WIN32
+            return unexpected(invalid_endpoint(to_string(), "Unix sockets are not supported"));
+#else
+#ifndef __linux__
+            if (abstract_) {
+                return unexpected(invalid_endpoint(to_string(), "abstract sockets are Linux-only"));
+            }
+#endif
+            auto* sun = reinterpret_cast<sockaddr_un*>(out.storage);
+            sun->sun_family = AF_UNIX;
+            // Abstract names start with a NUL byte and are not terminated
+            size_t offset = abstract_ ? 1 : 0;
+            if (address_.empty() || offset + address_.size() >= sizeof(sun->sun_path)) {
+                return unexpected(invalid_endpoint(to_string(), "socket path is empty or too long"));
+            }
+            std::memcpy(sun->sun_path + offset, address_.data(), address_.size());
+            out.size = static_cast<uint32_t>(offsetof(sockaddr_un, sun_path) + offset +
+                                             address_.size() + (abstract_ ? 0 : 1));
+            out.domain = AF_UNIX;
+            return out;
+#endif
+        }
+    }
+    return unexpected(Error::io(IoError::InvalidArgument, "Unknown endpoint family"));
+}
+
+Endpoint Endpoint::from_sockaddr(const void* addr, size_t size) {
+    sockaddr_storage ss{};
+    std::memcpy(&ss, addr, size < sizeof(ss) ? size : sizeof(ss));
+
+    char ip[INET6_ADDRSTRLEN] = {};
+    switch (ss.ss_family) {
+        case AF_INET: {
+            const auto* sin = reinterpret_cast<const sockaddr_in*>(&ss);
+            inet_ntop(AF_INET, &sin->sin_addr, ip, sizeof(ip));
+            return ipv4(ip, ntohs(sin->sin_port));
+        }
+        case AF_INET6: {
+            const auto* sin6 = reinterpret_cast<const sockaddr_in6*>(&ss);
+            uint16_t port = ntohs(sin6->sin6_port);
+            // IPv4 clients of a dual-stack listener arrive as ::ffff:a.b.c.d
+            if (IN6_IS_ADDR_V4MAPPED(&sin6->sin6_addr)) {
+                inet_ntop(AF_INET, reinterpret_cast<const unsigned char*>(&sin6->sin6_addr) + 12,
+                          ip, sizeof(ip));
+                return ipv4(ip, port);
+            }
+            inet_ntop(AF_INET6, &sin6->sin6_addr, ip, sizeof(ip));
+            return ipv6(ip, port);
+        }
+#ifndef _WIN32
+        case AF_UNIX: {
+            const auto* sun = reinterpret_cast<const sockaddr_un*>(&ss);
+            size_t base = offsetof(sockaddr_un, sun_path);
+            if (size <= base) {
+                return unix_socket({});  // Unnamed (typical for clients)
+            }
+            size_t len = std::min(size - base, sizeof(sun->sun_path));
+            if (sun->sun_path[0] == '\0') {
+                return abstract_socket(std::string_view(sun->sun_path + 1, len - 1));
+            }
+            return unix_socket(std::string_view(sun->sun_path, strnlen(sun->sun_path, len)));
+        }
+#endif
+        default:
+            return Endpoint{};
+    }
+}
+
+} // namespace coroute::net
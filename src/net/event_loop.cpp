@@ -1,5 +1,7 @@
 #include "coroute/net/io_context.hpp"
 
+#include <thread>
+
 // Platform-specific includes
 #if defined(COROUTE_PLATFORM_WINDOWS)
     // IOCP implementation in iocp/iocp_context.cpp
@@ -13,4 +15,36 @@ namespace coroute::net {
 
 // Factory implementations are in platform-specific files
 
+// ============================================================================
+// Timers
+// ============================================================================
+
+namespace detail {
+
+namespace {
+thread_local TimerArmFn t_timer_hook = nullptr;
+}
+
+void set_thread_timer_hook(TimerArmFn fn) noexcept {
+    t_timer_hook = fn;
+}
+
+} // namespace detail
+
+bool SleepAwaiter::await_suspend(std::coroutine_handle<> h) {
+    handle_ = h;
+    entry_.user_data = this;
+    entry_.on_expire = [](TimerEntry& entry) {
+        static_cast<SleepAwaiter*>(entry.user_data)->handle_.resume();
+    };
+    
+    if (detail::t_timer_hook && detail::t_timer_hook(entry_, deadline_)) {
+        return true;
+    }
+    
+    // Not on an I/O worker thread: block until the deadline
+    std::this_thread::sleep_until(deadline_);
+    return false;
+}
+
 } // namespace coroute::net
@@ -3,22 +3,30 @@
 #if defined(COROUTE_PLATFORM_LINUX)
 
 #include <liburing.h>
+#include <linux/filter.h>
 #include <sys/socket.h>
 #include <sys/eventfd.h>
-#include <sys/sendfile.h>
+#include <sys/mman.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
 
+#include <algorithm>
+#include <chrono>
 #include <thread>
 #include <vector>
-#include <queue>
-#include <mutex>
+#include <deque>
 #include <atomic>
 #include <memory>
+#include <climits>
+#include <cstddef>
 #include <cstring>
+#include <utility>
 
 namespace coroute::net {
 
@@ -40,12 +48,22 @@ struct UringOperation {
     std::coroutine_handle<> continuation;
     Error error;
     int result = 0;
+    uint32_t cqe_flags = 0;  // Flags of the last CQE (IORING_CQE_F_MORE etc.)
     size_t ring_index = 0;  // Which ring this operation belongs to
     
+    // Deadline for an attached IORING_OP_LINK_TIMEOUT; must stay valid
+    // until the SQE pair has been submitted
+    __kernel_timespec timeout_ts{};
+    bool linked_timeout = false;
+    
+    // Custom completion handler; when set, it replaces the default
+    // store-result-and-resume dispatch (used by multishot operations)
+    void (*on_complete)(UringOperation& op, const io_uring_cqe& cqe) = nullptr;
+    
     // For accept
     int accept_fd = -1;
-    sockaddr_in client_addr{};
-    socklen_t client_addr_len = sizeof(sockaddr_in);
+    sockaddr_storage client_addr{};
+    socklen_t client_addr_len = sizeof(sockaddr_storage);
     
     UringOperation(UringOpType t) : type(t) {}
 };
@@ -63,6 +81,286 @@ struct UringAwaiter {
     void await_resume() const noexcept {}
 };
 
+// ============================================================================
+// Provided Buffers - Kernel-selected read buffers (one buffer group per ring)
+// ============================================================================
+
+struct ProvidedBuffers {
+    static constexpr uint16_t GROUP_ID = 0;
+    
+    io_uring_buf_ring* br = nullptr;
+    size_t ring_bytes = 0;
+    std::unique_ptr<char[]> storage;
+    size_t buffer_size = 0;
+    unsigned count = 0;
+    int mask = 0;
+    
+    ProvidedBuffers() = default;
+    ProvidedBuffers(const ProvidedBuffers&) = delete;
+    ProvidedBuffers& operator=(const ProvidedBuffers&) = delete;
+    
+    ~ProvidedBuffers() {
+        if (br) {
+            munmap(br, ring_bytes);
+        }
+    }
+    
+    // Register a buffer ring of `entries` buffers (power of two) with the ring
+    bool init(io_uring& ring, size_t size, unsigned entries) {
+        ring_bytes = entries * sizeof(io_uring_buf);
+        void* mem = mmap(nullptr, ring_bytes, PROT_READ | PROT_WRITE,
+                         MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+        if (mem == MAP_FAILED) {
+            return false;
+        }
+        br = static_cast<io_uring_buf_ring*>(mem);
+        io_uring_buf_ring_init(br);
+        
+        io_uring_buf_reg reg{};
+        reg.ring_addr = reinterpret_cast<uint64_t>(br);
+        reg.ring_entries = entries;
+        reg.bgid = GROUP_ID;
+        if (io_uring_register_buf_ring(&ring, &reg, 0) < 0) {
+            return false;
+        }
+        
+        storage = std::make_unique<char[]>(size * entries);
+        buffer_size = size;
+        count = entries;
+        mask = io_uring_buf_ring_mask(entries);
+        for (unsigned i = 0; i < entries; ++i) {
+            io_uring_buf_ring_add(br, buffer(static_cast<uint16_t>(i)),
+                                  static_cast<unsigned>(size), static_cast<uint16_t>(i), mask, static_cast<int>(i));
+        }
+        io_uring_buf_ring_advance(br, static_cast<int>(entries));
+        return true;
+    }
+    
+    char* buffer(uint16_t bid) const noexcept {
+        return storage.get() + static_cast<size_t>(bid) * buffer_size;
+    }
+    
+    // Hand a buffer back to the kernel (owning worker thread only)
+    void recycle(uint16_t bid) noexcept {
+        io_uring_buf_ring_add(br, buffer(bid), static_cast<unsigned>(buffer_size), bid, mask, 0);
+        io_uring_buf_ring_advance(br, 1);
+    }
+    
+    static void release_lease(void* owner, uint32_t bid) noexcept {
+        static_cast<ProvidedBuffers*>(owner)->recycle(static_cast<uint16_t>(bid));
+    }
+};
+
+// Multishot recv state for one connection in provided-buffer mode. Received
+// chunks queue up here until the connection reads them. The stream is heap
+// allocated so it can outlive its connection until the kernel has finished
+// the multishot (after cancellation on close).
+struct RecvStream : UringOperation {
+    struct Chunk {
+        uint16_t bid;
+        uint32_t len;
+        uint32_t offset;
+    };
+    
+    ProvidedBuffers* buffers;
+    std::deque<Chunk> chunks;
+    int end_result = 1;    // 0 = EOF, < 0 = error, 1 = still open
+    bool armed = false;
+    bool starved = false;  // Multishot ended with -ENOBUFS
+    bool timed_out = false; // Read deadline passed while waiting
+    bool orphaned = false; // Connection closed while armed
+    
+    // Read deadline of the current wait, on the ring's timer wheel. A linked
+    // timeout would bound the multishot's whole lifetime, not one wait.
+    TimerEntry deadline;
+    
+    explicit RecvStream(ProvidedBuffers* pool)
+        : UringOperation(UringOpType::Read)
+        , buffers(pool)
+    {
+        on_complete = &RecvStream::handle_cqe;
+        deadline.user_data = this;
+        deadline.on_expire = &RecvStream::handle_deadline;
+    }
+    
+    ~RecvStream() {
+        for (const auto& chunk : chunks) {
+            buffers->recycle(chunk.bid);
+        }
+    }
+    
+    static void handle_cqe(UringOperation& base, const io_uring_cqe& cqe) {
+        auto& self = static_cast<RecvStream&>(base);
+        
+        if (cqe.flags & IORING_CQE_F_BUFFER) {
+            auto bid = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+            if (cqe.res > 0 && !self.orphaned) {
+                self.chunks.push_back({bid, static_cast<uint32_t>(cqe.res), 0});
+            } else {
+                self.buffers->recycle(bid);
+            }
+        } else if (cqe.res == -ENOBUFS) {
+            self.starved = true;
+        } else if (cqe.res <= 0 && cqe.res != -ECANCELED) {
+            self.end_result = cqe.res;
+        }
+        
+        bool finished = !(cqe.flags & IORING_CQE_F_MORE);
+        if (finished) {
+            self.armed = false;
+        }
+        
+        // The resumed coroutine may close the connection, so `self` must not
+        // be touched after resuming
+        auto h = std::exchange(self.continuation, nullptr);
+        if (finished && self.orphaned) {
+            delete &self;
+        }
+        if (h) {
+            h.resume();
+        }
+    }
+    
+    // The waiter resumes with a timeout and cancels the multishot itself
+    static void handle_deadline(TimerEntry& entry) {
+        auto& self = *static_cast<RecvStream*>(entry.user_data);
+        self.timed_out = true;
+        if (auto h = std::exchange(self.continuation, nullptr)) {
+            h.resume();
+        }
+    }
+};
+
+// IORING_OP_SEND_ZC completes twice: once with the byte count (flagged
+// IORING_CQE_F_MORE when a notification will follow) and once with
+// IORING_CQE_F_NOTIF when the kernel no longer references the buffer. The
+// awaiting coroutine - which keeps the buffer alive - resumes after both.
+struct ZeroCopySendOp : UringOperation {
+    bool sent = false;
+    bool notify_pending = false;
+    
+    ZeroCopySendOp() : UringOperation(UringOpType::Write) {
+        on_complete = [](UringOperation& base, const io_uring_cqe& cqe) {
+            auto& op = static_cast<ZeroCopySendOp&>(base);
+#ifdef IORING_CQE_F_NOTIF
+            if (cqe.flags & IORING_CQE_F_NOTIF) {
+                op.notify_pending = false;
+            } else
+#endif
+            {
+                op.result = cqe.res;
+                op.cqe_flags = cqe.flags;
+                if (cqe.res < 0) {
+                    op.error = Error::system(std::error_code(-cqe.res, std::system_category()));
+                }
+                op.notify_pending = (cqe.flags & IORING_CQE_F_MORE) != 0;
+                op.sent = true;
+            }
+            if (op.sent && !op.notify_pending) {
+                if (auto h = std::exchange(op.continuation, nullptr)) {
+                    h.resume();
+                }
+            }
+        };
+    }
+};
+
+// The single IORING_OP_TIMEOUT a ring keeps armed for its timer wheel
+struct RingTimerOp : UringOperation {
+    __kernel_timespec ts{};
+    bool armed = false;
+    uint64_t armed_tick = 0;
+    
+    RingTimerOp() : UringOperation(UringOpType::Timeout) {
+        // Any completion (expiry, removal) means the kernel timeout is gone;
+        // the worker loop advances the wheel and re-arms as needed
+        on_complete = [](UringOperation& op, const io_uring_cqe&) {
+            static_cast<RingTimerOp&>(op).armed = false;
+        };
+    }
+};
+
+// Keeps a read armed on a ring's eventfd so a write from any thread
+// produces a completion and wakes the worker
+struct EventfdReadOp : UringOperation {
+    uint64_t value = 0;
+    bool armed = false;
+    
+    EventfdReadOp() : UringOperation(UringOpType::Read) {
+        on_complete = [](UringOperation& op, const io_uring_cqe&) {
+            static_cast<EventfdReadOp&>(op).armed = false;
+        };
+    }
+};
+
+// Reusable pipes for file -> pipe -> socket splicing. Owned by one ring and
+// only touched from its worker thread.
+struct PipePool {
+    struct Pipe {
+        int read_fd = -1;
+        int write_fd = -1;
+        size_t capacity = 0;
+    };
+    
+    static constexpr size_t MAX_IDLE = 64;
+    static constexpr int PREFERRED_SIZE = 1 << 20;  // Capped by fs.pipe-max-size
+    
+    std::vector<Pipe> idle;
+    
+    ~PipePool() {
+        for (auto& pipe : idle) {
+            destroy(pipe);
+        }
+    }
+    
+    // Take an empty pipe, creating one if none is idle
+    bool acquire(Pipe& out) {
+        if (!idle.empty()) {
+            out = idle.back();
+            idle.pop_back();
+            return true;
+        }
+        int fds[2];
+        if (::pipe2(fds, O_NONBLOCK | O_CLOEXEC) < 0) {
+            return false;
+        }
+        out.read_fd = fds[0];
+        out.write_fd = fds[1];
+        int size = ::fcntl(fds[1], F_SETPIPE_SZ, PREFERRED_SIZE);
+        if (size < 0) {
+            size = ::fcntl(fds[1], F_GETPIPE_SZ);
+        }
+        out.capacity = size > 0 ? static_cast<size_t>(size) : 65536;
+        return true;
+    }
+    
+    // Return a pipe; one that may still hold data is closed instead
+    void release(Pipe& pipe, bool drained) {
+        if (drained && idle.size() < MAX_IDLE) {
+            idle.push_back(pipe);
+        } else {
+            destroy(pipe);
+        }
+        pipe = Pipe{};
+    }
+    
+    static void destroy(Pipe& pipe) {
+        if (pipe.read_fd >= 0) ::close(pipe.read_fd);
+        if (pipe.write_fd >= 0) ::close(pipe.write_fd);
+        pipe = Pipe{};
+    }
+};
+
+struct WorkerRing;
+
+// user_data for IORING_OP_MSG_RING wakeups aimed at a ring. The same op tags
+// the CQE posted into the target and, on failure, the sender's CQE.
+struct MsgRingOp : UringOperation {
+    WorkerRing* target = nullptr;
+    
+    MsgRingOp();
+};
+
 // ============================================================================
 // Per-Thread Ring - Each worker has its own io_uring instance and listener
 // ============================================================================
@@ -71,11 +369,71 @@ struct WorkerRing {
     io_uring ring;
     int eventfd = -1;
     int listen_fd = -1;  // SO_REUSEPORT listener for this ring
+    int cpu = -1;        // CPU the worker is pinned to (-1 = unpinned)
     std::atomic<bool> initialized{false};
     
-    WorkerRing() = default;
+    // Multishot accept stays armed beyond a single coroutine suspension, so the
+    // operation lives with the ring rather than in the accept loop's frame
+    UringOperation accept_op{UringOpType::Accept};
+    
+    // Provided-buffer pool (only when enable_provided_buffers() was called)
+    std::unique_ptr<ProvidedBuffers> buffers;
+    
+    // Pipes for async_transmit_file()
+    PipePool pipes;
+    
+    // Timer wheel in 1 ms ticks since timer_epoch (owning worker thread only)
+    TimerWheel timers;
+    std::chrono::steady_clock::time_point timer_epoch = std::chrono::steady_clock::now();
+    RingTimerOp timer_op;
+    
+    // Work posted from any thread; drained by the owning worker. wake_pending
+    // collapses concurrent wakeups into one until the worker drains again.
+    MpscQueue<PostedTask> posted;
+    std::atomic<bool> wake_pending{false};
+    EventfdReadOp eventfd_op;
+    MsgRingOp msg_op;
+    
+    // Cleared process-wide the first time the kernel rejects IORING_OP_MSG_RING
+    static inline std::atomic<bool> msg_ring_supported{true};
+    
+    // Submission counters (written by the owning worker, read by ring_stats())
+    std::atomic<uint64_t> submit_calls{0};
+    std::atomic<uint64_t> sqes_submitted{0};
+    std::atomic<uint64_t> sq_full_flushes{0};
+    std::atomic<uint64_t> cq_overflows{0};
+    
+    // Accept locality (owning worker writes, ring_stats() reads)
+    std::atomic<uint64_t> accepts{0};
+    std::atomic<uint64_t> cross_core_accepts{0};
+    
+    // Live UringConnections assigned to this ring (any thread)
+    std::atomic<uint64_t> connections{0};
+    
+    // Setup flags in effect and IORING_FEAT_* reported by the kernel
+    unsigned setup_flags = 0;
+    unsigned kernel_features = 0;
+    
+    // Time accounting (owning worker writes, ring_stats() reads)
+    std::atomic<uint64_t> busy_ns{0};
+    std::atomic<uint64_t> spin_ns{0};
+    std::atomic<uint64_t> idle_ns{0};
+    std::chrono::steady_clock::time_point busy_since = std::chrono::steady_clock::now();
+    
+    // Moving average of how long the worker waited for work (owning worker only)
+    uint64_t wait_avg_ns = 0;
+    
+    WorkerRing() {
+        msg_op.target = this;
+    }
     
     ~WorkerRing() {
+        // Anything still queued never ran; let owners reclaim it
+        while (PostedTask* task = posted.pop()) {
+            if (task->discard) {
+                task->discard(*task);
+            }
+        }
         if (listen_fd >= 0) {
             ::close(listen_fd);
         }
@@ -91,13 +449,32 @@ struct WorkerRing {
     WorkerRing(const WorkerRing&) = delete;
     WorkerRing& operator=(const WorkerRing&) = delete;
     
-    bool init() {
-        // Use larger queue size for better throughput
-        io_uring_params params{};
-        // SQPOLL can hurt performance for this workload, use regular mode
-        int ret = io_uring_queue_init_params(8192, &ring, &params);
-        if (ret < 0) {
-            return false;
+    // Create the ring with the requested setup flags. Flags the kernel
+    // rejects are dropped in order of how new they are, and `flags` is
+    // updated to what was actually used so later rings skip the probing.
+    bool init(const IoContextOptions& options, size_t index, unsigned& flags) {
+        for (;;) {
+            io_uring_params params{};
+            params.flags = flags;
+            if (flags & IORING_SETUP_CQSIZE) {
+                params.cq_entries = options.cq_entries;
+            }
+            if (flags & IORING_SETUP_SQPOLL) {
+                params.sq_thread_idle = static_cast<unsigned>(options.sqpoll_idle.count());
+            }
+            if (flags & IORING_SETUP_SQ_AFF) {
+                params.sq_thread_cpu = static_cast<unsigned>(options.sqpoll_cpu) +
+                                       static_cast<unsigned>(index);
+            }
+            
+            int ret = io_uring_queue_init_params(options.sq_entries, &ring, &params);
+            if (ret == 0) {
+                kernel_features = params.features;
+                break;
+            }
+            if ((ret != -EINVAL && ret != -EPERM) || !drop_newest_flag(flags)) {
+                return false;
+            }
         }
         
         eventfd = ::eventfd(0, EFD_NONBLOCK);
@@ -106,53 +483,302 @@ struct WorkerRing {
             return false;
         }
         
+        setup_flags = flags;
         initialized = true;
         return true;
     }
     
-    // Create SO_REUSEPORT listener for this ring
-    bool create_listener(uint16_t port, int backlog) {
-        listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
-        if (listen_fd < 0) return false;
-        
-        int opt = 1;
-        setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
-        setsockopt(listen_fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt));
-        
-        sockaddr_in addr{};
-        addr.sin_family = AF_INET;
-        addr.sin_addr.s_addr = INADDR_ANY;
-        addr.sin_port = htons(port);
-        
-        if (bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
-            ::close(listen_fd);
-            listen_fd = -1;
-            return false;
+    static bool drop_newest_flag(unsigned& flags) {
+#ifdef IORING_SETUP_DEFER_TASKRUN
+        if (flags & IORING_SETUP_DEFER_TASKRUN) {
+            flags &= ~IORING_SETUP_DEFER_TASKRUN;
+            // TASKRUN_FLAG is only valid alongside a *_TASKRUN mode
+            if (!(flags & IORING_SETUP_COOP_TASKRUN)) {
+                flags &= ~IORING_SETUP_TASKRUN_FLAG;
+            }
+            return true;
         }
-        
-        if (::listen(listen_fd, backlog) < 0) {
-            ::close(listen_fd);
-            listen_fd = -1;
+#endif
+#ifdef IORING_SETUP_SINGLE_ISSUER
+        if (flags & IORING_SETUP_SINGLE_ISSUER) {
+            flags &= ~(IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_R_DISABLED);
+            return true;
+        }
+#endif
+#ifdef IORING_SETUP_COOP_TASKRUN
+        if (flags & (IORING_SETUP_COOP_TASKRUN | IORING_SETUP_TASKRUN_FLAG)) {
+            flags &= ~(IORING_SETUP_COOP_TASKRUN | IORING_SETUP_TASKRUN_FLAG);
+            return true;
+        }
+#endif
+        if (flags & IORING_SETUP_SQ_AFF) {
+            flags &= ~IORING_SETUP_SQ_AFF;
+            return true;
+        }
+        if (flags & IORING_SETUP_SQPOLL) {
+            flags &= ~IORING_SETUP_SQPOLL;
+            return true;
+        }
+        if (flags & IORING_SETUP_CQSIZE) {
+            flags &= ~IORING_SETUP_CQSIZE;
+            return true;
+        }
+        return false;
+    }
+    
+    // Rings created with IORING_SETUP_R_DISABLED (single issuer) are enabled
+    // from the worker thread, which makes it the ring's only submitter
+    void enable_on_current_thread() {
+        if (setup_flags & IORING_SETUP_R_DISABLED) {
+            if (io_uring_enable_rings(&ring) == 0) {
+                setup_flags &= ~IORING_SETUP_R_DISABLED;
+            }
+        }
+    }
+    
+    // Completions ready in the CQ. With *_TASKRUN setups (or after a CQ
+    // overflow) finished work may still be waiting in the kernel; flush it
+    // only when the kernel flags that there is something to flush.
+    bool cq_ready() {
+        if (io_uring_cq_ready(&ring) > 0) {
+            return true;
+        }
+        unsigned sq_flags = std::atomic_ref<unsigned>(*ring.sq.kflags).load(std::memory_order_acquire);
+        if (sq_flags & (IORING_SQ_TASKRUN | IORING_SQ_CQ_OVERFLOW)) {
+            if (sq_flags & IORING_SQ_CQ_OVERFLOW) {
+                cq_overflows.fetch_add(1, std::memory_order_relaxed);
+            }
+            io_uring_get_events(&ring);
+            return io_uring_cq_ready(&ring) > 0;
+        }
+        return false;
+    }
+    
+    bool setup_provided_buffers(size_t size, unsigned entries) {
+        auto pool = std::make_unique<ProvidedBuffers>();
+        if (!pool->init(ring, size, entries)) {
             return false;
         }
-        
+        buffers = std::move(pool);
         return true;
     }
     
+    // Get an SQE; if the SQ is full, flush it to the kernel and retry once
+    io_uring_sqe* get_sqe() {
+        io_uring_sqe* sqe = io_uring_get_sqe(&ring);
+        if (!sqe) {
+            sq_full_flushes.fetch_add(1, std::memory_order_relaxed);
+            flush();
+            sqe = io_uring_get_sqe(&ring);
+        }
+        return sqe;
+    }
+    
+    // Submit all queued SQEs without waiting
+    int flush() {
+        int ret = io_uring_submit(&ring);
+        record_submit(ret);
+        return ret;
+    }
+    
+    void record_submit(int submitted) {
+        if (submitted > 0) {
+            submit_calls.fetch_add(1, std::memory_order_relaxed);
+            sqes_submitted.fetch_add(static_cast<uint64_t>(submitted), std::memory_order_relaxed);
+        }
+    }
+    
+    uint64_t tick_for(std::chrono::steady_clock::time_point when) const noexcept {
+        if (when <= timer_epoch) {
+            return 0;
+        }
+        return static_cast<uint64_t>(
+            std::chrono::ceil<std::chrono::milliseconds>(when - timer_epoch).count());
+    }
+    
+    uint64_t current_tick() const noexcept {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - timer_epoch).count());
+    }
+    
+    // Single-writer counter bump; avoids a locked RMW on the hot path
+    static void add_ns(std::atomic<uint64_t>& counter, std::chrono::steady_clock::duration d) {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+        if (ns > 0) {
+            counter.store(counter.load(std::memory_order_relaxed) + static_cast<uint64_t>(ns),
+                          std::memory_order_relaxed);
+        }
+    }
+    
+    // Spin only when work has recently been arriving within max_spin; then
+    // spin for about twice the typical wait so most arrivals are caught
+    // without a sleep/wakeup round trip
+    std::chrono::nanoseconds spin_budget(std::chrono::nanoseconds max_spin) const noexcept {
+        auto typical = std::chrono::nanoseconds(static_cast<int64_t>(wait_avg_ns));
+        if (typical > max_spin) {
+            return std::chrono::nanoseconds::zero();
+        }
+        return std::min(typical * 2, max_spin);
+    }
+    
+    void record_wait(std::chrono::steady_clock::duration waited) noexcept {
+        auto ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count());
+        wait_avg_ns = wait_avg_ns - wait_avg_ns / 8 + ns / 8;
+    }
+    
+    RingStats stats() const {
+        RingStats s;
+        s.submit_calls = submit_calls.load(std::memory_order_relaxed);
+        s.sqes_submitted = sqes_submitted.load(std::memory_order_relaxed);
+        s.sq_full_flushes = sq_full_flushes.load(std::memory_order_relaxed);
+        s.cq_overflows = cq_overflows.load(std::memory_order_relaxed);
+        s.busy_ns = busy_ns.load(std::memory_order_relaxed);
+        s.spin_ns = spin_ns.load(std::memory_order_relaxed);
+        s.idle_ns = idle_ns.load(std::memory_order_relaxed);
+        s.accepts = accepts.load(std::memory_order_relaxed);
+        s.cross_core_accepts = cross_core_accepts.load(std::memory_order_relaxed);
+        s.connections = connections.load(std::memory_order_relaxed);
+        return s;
+    }
+    
     void wake() {
         if (eventfd >= 0) {
             uint64_t val = 1;
             ::write(eventfd, &val, sizeof(val));
         }
     }
+    
+    // Keep a read pending on the eventfd (owning worker only)
+    void arm_eventfd() {
+        if (eventfd_op.armed || eventfd < 0) {
+            return;
+        }
+        io_uring_sqe* sqe = get_sqe();
+        if (!sqe) {
+            return;
+        }
+        io_uring_prep_read(sqe, eventfd, &eventfd_op.value, sizeof(eventfd_op.value), 0);
+        io_uring_sqe_set_data(sqe, &eventfd_op);
+        eventfd_op.armed = true;
+    }
 };
 
+MsgRingOp::MsgRingOp() : UringOperation(UringOpType::Read) {
+    // Success lands in the target ring with nothing to do but wake it. An
+    // error comes back to the sender (older kernel, target not enabled yet
+    // or overflowing): wake through the eventfd instead, and stop using
+    // MSG_RING if the kernel does not know the opcode.
+    on_complete = [](UringOperation& op, const io_uring_cqe& cqe) {
+        if (cqe.res < 0) {
+            if (cqe.res == -EINVAL || cqe.res == -EOPNOTSUPP) {
+                WorkerRing::msg_ring_supported.store(false, std::memory_order_relaxed);
+            }
+            static_cast<MsgRingOp&>(op).target->wake();
+        }
+    };
+}
+
 // ============================================================================
 // io_uring Context Implementation - Per-Thread Rings
 // ============================================================================
 
 // Forward declaration
 class UringConnection;
+class UringContext;
+
+namespace {
+
+// Ring and context owned by the current worker thread (null elsewhere)
+thread_local WorkerRing* t_current_ring = nullptr;
+thread_local UringContext* t_current_context = nullptr;
+
+// detail::TimerArmFn for worker threads: arm on this thread's wheel
+bool arm_timer_on_current_ring(TimerEntry& entry, std::chrono::steady_clock::time_point deadline) {
+    if (!t_current_ring) {
+        return false;
+    }
+    t_current_ring->timers.schedule(entry, t_current_ring->tick_for(deadline));
+    return true;
+}
+
+// Spin-wait hint to the CPU
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Pin the calling thread to one CPU
+bool pin_current_thread(int cpu) noexcept {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+// Run `fn` on a short-lived thread pinned to `cpu` (inline if cpu < 0), so
+// memory it first touches is allocated on that CPU's NUMA node
+template<typename Fn>
+void run_on_cpu(int cpu, Fn&& fn) {
+    if (cpu < 0) {
+        fn();
+        return;
+    }
+    std::thread([cpu, &fn] {
+        pin_current_thread(cpu);
+        fn();
+    }).join();
+}
+
+// Classic BPF program for SO_ATTACH_REUSEPORT_CBPF that returns the index of
+// the ring pinned to the CPU which processed the connection's packets. A
+// ring's listener index in the reuseport group is its ring index, as the
+// sockets join the group in ring order. Unmapped CPUs return an out-of-range
+// index, which makes the kernel fall back to its hash.
+std::vector<sock_filter> cpu_steering_program(const std::vector<int>& ring_cpus) {
+    std::vector<sock_filter> prog;
+    prog.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)));
+    std::vector<int> seen;
+    for (size_t ring = 0; ring < ring_cpus.size(); ++ring) {
+        int cpu = ring_cpus[ring];
+        if (cpu < 0 || std::find(seen.begin(), seen.end(), cpu) != seen.end()) {
+            continue;  // Unpinned, or a CPU shared with an earlier ring
+        }
+        seen.push_back(cpu);
+        prog.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, static_cast<uint32_t>(cpu), 0, 1));
+        prog.push_back(BPF_STMT(BPF_RET | BPF_K, static_cast<uint32_t>(ring)));
+    }
+    prog.push_back(BPF_STMT(BPF_RET | BPF_K, 0xFFFFFFFFu));
+    return prog;
+}
+
+// Timer for schedule(); frees itself after firing
+struct ScheduledCallback {
+    TimerEntry entry;
+    std::function<void()> callback;
+};
+
+// Heap node for post(ring, fn); frees itself after running
+struct CallbackTask : PostedTask {
+    std::function<void()> callback;
+    
+    explicit CallbackTask(std::function<void()> cb) : callback(std::move(cb)) {
+        run = [](PostedTask& task) {
+            std::unique_ptr<CallbackTask> owned(static_cast<CallbackTask*>(&task));
+            if (owned->callback) {
+                owned->callback();
+            }
+        };
+        discard = [](PostedTask& task) {
+            delete static_cast<CallbackTask*>(&task);
+        };
+    }
+};
+
+} // namespace
 
 // Connection handler callback
 using ConnectionHandler = std::function<void(std::unique_ptr<Connection>)>;
@@ -164,30 +790,108 @@ class UringContext : public IoContext {
     std::atomic<size_t> next_ring_{0};
     size_t thread_count_;
     
+    // Deferred submission: SQEs are flushed once per worker loop iteration
+    std::atomic<bool> deferred_submit_{true};
+    
+    // Cleared the first time the kernel rejects a multishot accept
+    std::atomic<bool> multishot_accept_{true};
+
+    // Multi-accept loops disarm and wait while set (see set_accept_paused)
+    std::atomic<bool> accept_paused_{false};
+    
+    // Set once close_multi_accept() has shut the listeners down
+    std::atomic<bool> accept_closed_{false};
+    
+    // Zero-copy sends for writes >= threshold (0 = off); cleared if the
+    // kernel does not know IORING_OP_SEND_ZC
+    size_t zerocopy_threshold_ = 0;
+    std::atomic<bool> send_zc_supported_{true};
+    
+    // Idle wait strategy (see WaitPolicy)
+    std::atomic<WaitPolicy> wait_policy_;
+    std::atomic<int64_t> max_spin_ns_;
+    
     // SO_REUSEPORT multi-accept
     ConnectionHandler connection_handler_;
-    uint16_t listen_port_ = 0;
+    Endpoint listen_endpoint_;
     bool multi_accept_enabled_ = false;
-    
-    // Posted callbacks
-    std::mutex callback_mutex_;
-    std::queue<std::function<void()>> callbacks_;
+    bool steer_connections_ = true;
+    bool steering_attached_ = false;
+
+    // Setup flags asked for, for reporting what the kernel refused
+    unsigned requested_flags_ = 0;
 
 public:
-    explicit UringContext(size_t thread_count)
-        : thread_count_(thread_count > 0 ? thread_count : 1)
+    explicit UringContext(const IoContextOptions& options)
+        : thread_count_(options.threads > 0 ? options.threads : 1)
+        , wait_policy_(options.wait_policy)
+        , max_spin_ns_(std::chrono::duration_cast<std::chrono::nanoseconds>(options.max_spin).count())
+        , steer_connections_(options.steer_connections)
     {
-        // Create per-thread rings
+#ifdef IORING_CQE_F_NOTIF
+        zerocopy_threshold_ = options.zerocopy_send_threshold;
+#endif
+        unsigned flags = setup_flags_for(options);
+        requested_flags_ = flags;
+        
+        // Create per-thread rings; the first one settles which flags work.
+        // Pinned rings are built on their CPU so the kernel's ring memory and
+        // our own per-ring state come from the worker's NUMA node.
         rings_.reserve(thread_count_);
         for (size_t i = 0; i < thread_count_; ++i) {
-            auto ring = std::make_unique<WorkerRing>();
-            if (!ring->init()) {
+            const auto& cpus = options.cpu_affinity;
+            int cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+            std::unique_ptr<WorkerRing> ring;
+            bool ok = false;
+            run_on_cpu(cpu, [&] {
+                ring = std::make_unique<WorkerRing>();
+                ok = ring->init(options, i, flags);
+            });
+            if (!ok) {
                 throw std::runtime_error("Failed to initialize io_uring ring " + std::to_string(i));
             }
+            ring->cpu = cpu;
+            if (cpu >= 0) {
+                // Keep the ring's io-wq helper threads on the same CPU
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpu, &set);
+                io_uring_register_iowq_aff(&ring->ring, sizeof(set), &set);
+            }
             rings_.push_back(std::move(ring));
         }
     }
     
+    static unsigned setup_flags_for(const IoContextOptions& options) {
+        unsigned flags = 0;
+        if (options.cq_entries > options.sq_entries) {
+            flags |= IORING_SETUP_CQSIZE;
+        }
+        if (options.sqpoll) {
+            flags |= IORING_SETUP_SQPOLL;
+            if (options.sqpoll_cpu >= 0) {
+                flags |= IORING_SETUP_SQ_AFF;
+            }
+        }
+#ifdef IORING_SETUP_COOP_TASKRUN
+        if (options.coop_taskrun) {
+            flags |= IORING_SETUP_COOP_TASKRUN | IORING_SETUP_TASKRUN_FLAG;
+        }
+#endif
+#ifdef IORING_SETUP_SINGLE_ISSUER
+        if (options.single_issuer) {
+            flags |= IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_R_DISABLED;
+#ifdef IORING_SETUP_DEFER_TASKRUN
+            // SQPOLL rings cannot defer task work to the (non-submitting) worker
+            if (!options.sqpoll) {
+                flags |= IORING_SETUP_DEFER_TASKRUN | IORING_SETUP_TASKRUN_FLAG;
+            }
+#endif
+        }
+#endif
+        return flags;
+    }
+    
     ~UringContext() override {
         stop();
         
@@ -196,9 +900,18 @@ public:
                 worker.join();
             }
         }
+        
+        if (multi_accept_enabled_ && listen_endpoint_.is_unix() && !listen_endpoint_.is_abstract()) {
+            ::unlink(listen_endpoint_.address().c_str());
+        }
     }
 
-    size_t ring_count() const noexcept { return rings_.size(); }
+    size_t ring_count() const noexcept override { return rings_.size(); }
+    
+    bool is_current_ring(size_t ring_index) const noexcept override {
+        return t_current_context == this && !rings_.empty() &&
+               t_current_ring == rings_[ring_index % rings_.size()].get();
+    }
     
     WorkerRing* worker_ring(size_t index) noexcept {
         return rings_[index % rings_.size()].get();
@@ -214,11 +927,48 @@ public:
         return next_ring_.fetch_add(1, std::memory_order_relaxed) % rings_.size();
     }
     
-    // Enable SO_REUSEPORT multi-accept: each worker accepts on its own listener
-    bool enable_multi_accept(uint16_t port, ConnectionHandler handler, int backlog = 1024) override {
-        // Create SO_REUSEPORT listeners on all rings
-        for (auto& ring : rings_) {
-            if (!ring->create_listener(port, backlog)) {
+    // Ring for a newly accepted connection: the one with the fewest live
+    // connections, ties broken round-robin so idle rings share new work
+    size_t pick_connection_ring() noexcept {
+        size_t start = next_ring_index();
+        size_t best = start;
+        uint64_t best_load = UINT64_MAX;
+        for (size_t i = 0; i < rings_.size(); ++i) {
+            size_t index = (start + i) % rings_.size();
+            uint64_t load = rings_[index]->connections.load(std::memory_order_relaxed);
+            if (load < best_load) {
+                best = index;
+                best_load = load;
+            }
+        }
+        return best;
+    }
+    
+    // Ring owned by the calling thread; ring 0 outside the workers
+    size_t current_ring_index() const noexcept {
+        if (t_current_context == this && t_current_ring) {
+            return ring_index_of(t_current_ring);
+        }
+        return 0;
+    }
+    
+    using IoContext::enable_multi_accept;
+    
+    // Enable SO_REUSEPORT multi-accept: each worker accepts on its own listener.
+    // A Unix socket path can only be bound once, so for those every ring
+    // accepts on a duplicate of a single listening socket instead.
+    bool enable_multi_accept(const Endpoint& endpoint, ConnectionHandler handler, int backlog = 1024) override {
+        Endpoint bound = endpoint;
+        for (size_t i = 0; i < rings_.size(); ++i) {
+            auto& ring = rings_[i];
+            if (i > 0 && endpoint.is_unix()) {
+                ring->listen_fd = fcntl(rings_[0]->listen_fd, F_DUPFD_CLOEXEC, 0);
+            } else {
+                auto fd = detail::open_listen_socket(bound, backlog, true);
+                ring->listen_fd = fd ? *fd : -1;
+            }
+            
+            if (ring->listen_fd < 0) {
                 // Clean up on failure
                 for (auto& r : rings_) {
                     if (r->listen_fd >= 0) {
@@ -228,29 +978,302 @@ public:
                 }
                 return false;
             }
+            
+            // Port 0: the remaining rings join the port the first one got
+            if (i == 0) {
+                bound = endpoint.with_port(detail::local_endpoint(ring->listen_fd).port());
+            }
+        }
+        
+        if (!endpoint.is_unix()) {
+            steering_attached_ = attach_cpu_steering();
         }
         
         connection_handler_ = std::move(handler);
-        listen_port_ = port;
+        listen_endpoint_ = bound;
         multi_accept_enabled_ = true;
         return true;
     }
     
+    // Route new connections to the ring on the CPU that received them. Only
+    // meaningful with pinned workers; without it the kernel hashes.
+    bool attach_cpu_steering() {
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+        std::vector<int> cpus;
+        for (const auto& ring : rings_) {
+            cpus.push_back(ring->cpu);
+        }
+        if (!steer_connections_ || rings_.size() < 2 ||
+            std::all_of(cpus.begin(), cpus.end(), [](int cpu) { return cpu < 0; })) {
+            return false;
+        }
+        
+        auto prog = cpu_steering_program(cpus);
+        sock_fprog fprog{};
+        fprog.len = static_cast<unsigned short>(prog.size());
+        fprog.filter = prog.data();
+        // The program applies to the whole reuseport group
+        return setsockopt(rings_[0]->listen_fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF,
+                          &fprog, sizeof(fprog)) == 0;
+#else
+        return false;
+#endif
+    }
+    
+    Endpoint multi_accept_endpoint() const override { return listen_endpoint_; }
+    
     bool is_multi_accept_enabled() const noexcept override { return multi_accept_enabled_; }
-    uint16_t listen_port() const noexcept { return listen_port_; }
+
+    void set_accept_paused(bool paused) override {
+        accept_paused_.store(paused, std::memory_order_relaxed);
+    }
+    
+    // Shutting a listening socket down takes it out of the listening state
+    // and fails the accept armed on it, which closing the descriptor would
+    // not: the ring holds its own reference to the file. The descriptors
+    // themselves are closed with the rings.
+    void close_multi_accept() override {
+        if (!multi_accept_enabled_ || accept_closed_.exchange(true)) {
+            return;
+        }
+        for (auto& ring : rings_) {
+            if (ring->listen_fd >= 0) {
+                ::shutdown(ring->listen_fd, SHUT_RDWR);
+            }
+        }
+    }
     
-    // Submit SQE to a specific ring
+    bool enable_provided_buffers(size_t buffer_size, unsigned buffer_count) override {
+        if (!workers_.empty() || buffer_size == 0 || buffer_count == 0) {
+            return false;
+        }
+        
+        // Buffer rings need a power-of-two entry count; buffer IDs are 16-bit
+        unsigned entries = 1;
+        while (entries < buffer_count && entries < 32768) {
+            entries <<= 1;
+        }
+        
+        for (auto& ring : rings_) {
+            // Allocate (and first-touch) the buffers on the ring's CPU
+            bool ok = false;
+            run_on_cpu(ring->cpu, [&] { ok = ring->setup_provided_buffers(buffer_size, entries); });
+            if (!ok) {
+                for (auto& r : rings_) {
+                    if (r->buffers) {
+                        io_uring_unregister_buf_ring(&r->ring, ProvidedBuffers::GROUP_ID);
+                        r->buffers.reset();
+                    }
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    ProvidedBuffers* provided_buffers(size_t ring_index) noexcept {
+        return rings_[ring_index % rings_.size()]->buffers.get();
+    }
+    uint16_t listen_port() const noexcept { return listen_endpoint_.port(); }
+    
+    bool use_send_zc(size_t len) const noexcept {
+        return zerocopy_threshold_ > 0 && len >= zerocopy_threshold_ &&
+               send_zc_supported_.load(std::memory_order_relaxed);
+    }
+    
+    void disable_send_zc() noexcept {
+        send_zc_supported_.store(false, std::memory_order_relaxed);
+    }
+    
+    void set_deferred_submit(bool enabled) override {
+        deferred_submit_.store(enabled, std::memory_order_relaxed);
+    }
+    
+    void set_wait_policy(WaitPolicy policy, std::chrono::microseconds max_spin) override {
+        wait_policy_.store(policy, std::memory_order_relaxed);
+        max_spin_ns_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(max_spin).count(),
+                           std::memory_order_relaxed);
+    }
+    
+    std::string features() const override {
+        const WorkerRing& first = *rings_.front();
+        unsigned flags = first.setup_flags & ~IORING_SETUP_R_DISABLED;
+        unsigned refused = requested_flags_ & ~first.setup_flags & ~IORING_SETUP_R_DISABLED;
+        
+        std::string out = "io_uring, " + std::to_string(rings_.size()) + " ring(s), sq=" +
+                          std::to_string(first.ring.sq.ring_entries) + " cq=" +
+                          std::to_string(first.ring.cq.ring_entries);
+        auto list = [&](unsigned set) {
+            std::string names;
+            auto add = [&](unsigned bit, const char* name) {
+                if (set & bit) {
+                    names += names.empty() ? "" : " ";
+                    names += name;
+                }
+            };
+            add(IORING_SETUP_CQSIZE, "CQSIZE");
+            add(IORING_SETUP_SQPOLL, "SQPOLL");
+            add(IORING_SETUP_SQ_AFF, "SQ_AFF");
+#ifdef IORING_SETUP_COOP_TASKRUN
+            add(IORING_SETUP_COOP_TASKRUN, "COOP_TASKRUN");
+            add(IORING_SETUP_TASKRUN_FLAG, "TASKRUN_FLAG");
+#endif
+#ifdef IORING_SETUP_SINGLE_ISSUER
+            add(IORING_SETUP_SINGLE_ISSUER, "SINGLE_ISSUER");
+#endif
+#ifdef IORING_SETUP_DEFER_TASKRUN
+            add(IORING_SETUP_DEFER_TASKRUN, "DEFER_TASKRUN");
+#endif
+            return names;
+        };
+        
+        if (flags) {
+            out += ", " + list(flags);
+        }
+        if (refused) {
+            out += " (unavailable: " + list(refused) + ")";
+        }
+        if (!(first.kernel_features & IORING_FEAT_NODROP)) {
+            out += ", CQ overflow drops completions";
+        }
+        if (use_send_zc(SIZE_MAX)) {
+            out += ", SEND_ZC >= " + std::to_string(zerocopy_threshold_) + " bytes";
+        }
+        if (!WorkerRing::msg_ring_supported.load(std::memory_order_relaxed)) {
+            out += ", no MSG_RING";
+        }
+        if (first.cpu >= 0) {
+            out += ", pinned to CPU";
+            for (size_t i = 0; i < rings_.size(); ++i) {
+                out += (i ? "," : " ") + std::to_string(rings_[i]->cpu);
+            }
+        }
+        if (steering_attached_) {
+            out += ", CPU-steered accept";
+        }
+        return out;
+    }
+    
+    std::vector<RingStats> ring_stats() const override {
+        std::vector<RingStats> stats;
+        stats.reserve(rings_.size());
+        for (const auto& ring : rings_) {
+            stats.push_back(ring->stats());
+        }
+        return stats;
+    }
+    
+    // Queue an SQE on a specific ring. In deferred mode it is flushed by the
+    // owning worker at the top of its next loop iteration.
+    //
+    // Only the owning worker touches a ring's SQ. From any other thread the
+    // submission is posted to that worker, and if it then finds no SQE the
+    // operation completes with -EBUSY. A coroutine that awaits the result
+    // must hop onto the ring first (as UringConnection does), or the
+    // completion could race its suspension.
     template<typename PrepFunc>
     bool submit_sqe(size_t ring_index, UringOperation* op, PrepFunc prep_func) {
+        if (!is_current_ring(ring_index)) {
+            post(ring_index, [this, ring_index, op, prep_func] {
+                if (!submit_sqe(ring_index, op, prep_func)) {
+                    fail_operation(op, -EBUSY);
+                }
+            });
+            return true;
+        }
+        
         auto* worker_ring = rings_[ring_index % rings_.size()].get();
+        io_uring_sqe* sqe = worker_ring->get_sqe();
+        if (!sqe) {
+            return false;
+        }
+        prep_func(sqe);
+        io_uring_sqe_set_data(sqe, op);
+        op->ring_index = ring_index;
+        if (!deferred_submit_.load(std::memory_order_relaxed)) {
+            worker_ring->flush();
+        }
+        return true;
+    }
+    
+    // Queue an SQE followed by a linked IORING_OP_LINK_TIMEOUT. If the timeout
+    // fires first, the operation completes with -ECANCELED. A zero timeout
+    // queues the operation alone. Off the owning worker it is posted, as
+    // with submit_sqe().
+    template<typename PrepFunc>
+    bool submit_linked(size_t ring_index, UringOperation* op,
+                       std::chrono::milliseconds timeout, PrepFunc prep_func) {
+        op->linked_timeout = timeout.count() > 0;
+        if (!op->linked_timeout) {
+            return submit_sqe(ring_index, op, prep_func);
+        }
+        
+        if (!is_current_ring(ring_index)) {
+            post(ring_index, [this, ring_index, op, timeout, prep_func] {
+                if (!submit_linked(ring_index, op, timeout, prep_func)) {
+                    fail_operation(op, -EBUSY);
+                }
+            });
+            return true;
+        }
+        
+        auto* worker_ring = rings_[ring_index % rings_.size()].get();
+        
+        // Both SQEs must land in the same submission for the link to hold.
+        // A flush does not guarantee the room (under SQPOLL the kernel thread
+        // may not have consumed the queue yet), so check again before
+        // preparing the first one rather than leave a dangling IO_LINK.
+        if (io_uring_sq_space_left(&worker_ring->ring) < 2) {
+            worker_ring->sq_full_flushes.fetch_add(1, std::memory_order_relaxed);
+            worker_ring->flush();
+            if (io_uring_sq_space_left(&worker_ring->ring) < 2) {
+                return false;
+            }
+        }
+        
         io_uring_sqe* sqe = io_uring_get_sqe(&worker_ring->ring);
         if (!sqe) {
             return false;
         }
         prep_func(sqe);
+        sqe->flags |= IOSQE_IO_LINK;
         io_uring_sqe_set_data(sqe, op);
         op->ring_index = ring_index;
-        io_uring_submit(&worker_ring->ring);
+        
+        op->timeout_ts.tv_sec = timeout.count() / 1000;
+        op->timeout_ts.tv_nsec = (timeout.count() % 1000) * 1000000;
+        
+        io_uring_sqe* timeout_sqe = io_uring_get_sqe(&worker_ring->ring);
+        io_uring_prep_link_timeout(timeout_sqe, &op->timeout_ts, 0);
+        io_uring_sqe_set_data(timeout_sqe, nullptr);
+        
+        if (!deferred_submit_.load(std::memory_order_relaxed)) {
+            worker_ring->flush();
+        }
+        return true;
+    }
+    
+    // Cancel an in-flight operation; the cancel itself produces no wakeup.
+    // From another thread it is posted to the owning worker (close() may run
+    // anywhere); the target stays alive until its final CQE regardless.
+    bool submit_cancel(size_t ring_index, UringOperation* target) {
+        if (!is_current_ring(ring_index)) {
+            post(ring_index, [this, ring_index, target] {
+                submit_cancel(ring_index, target);
+            });
+            return true;
+        }
+        
+        auto* worker_ring = rings_[ring_index % rings_.size()].get();
+        io_uring_sqe* sqe = worker_ring->get_sqe();
+        if (!sqe) {
+            return false;
+        }
+        io_uring_prep_cancel(sqe, target, 0);
+        io_uring_sqe_set_data(sqe, nullptr);
+        if (!deferred_submit_.load(std::memory_order_relaxed)) {
+            worker_ring->flush();
+        }
         return true;
     }
     
@@ -277,7 +1300,11 @@ public:
     }
     
     void run_one() override {
+        enter_worker(0);
+        submit_and_wait(0);
         poll_and_resume(0);
+        run_timers(0);
+        process_posted(0);
     }
     
     void stop() override {
@@ -293,58 +1320,243 @@ public:
         return stopped_;
     }
 
+    // From a worker: run on that worker's ring. From any other thread: ring 0,
+    // so callbacks posted by one outside thread keep their order.
     void post(std::function<void()> callback) override {
-        {
-            std::lock_guard lock(callback_mutex_);
-            callbacks_.push(std::move(callback));
+        size_t ring_index = 0;
+        if (t_current_context == this && t_current_ring) {
+            ring_index = ring_index_of(t_current_ring);
+        }
+        post(ring_index, std::move(callback));
+    }
+    
+    void post(size_t ring_index, std::function<void()> callback) override {
+        post_task(ring_index, *new CallbackTask(std::move(callback)));
+    }
+    
+    void post_task(size_t ring_index, PostedTask& task) override {
+        auto* target = rings_[ring_index % rings_.size()].get();
+        target->posted.push(task);
+        
+        // Pairs with the fence in process_posted(): either the worker sees
+        // this task while draining, or we see wake_pending cleared and wake it
+        if (!target->wake_pending.exchange(true, std::memory_order_seq_cst)) {
+            wake_ring(target);
+        }
+    }
+
+    void schedule(std::chrono::milliseconds delay, std::function<void()> callback) override {
+        schedule_at(std::chrono::steady_clock::now() + delay, std::move(callback));
+    }
+
+private:
+    // Accept loop coroutine for multi-accept mode
+    Task<void> accept_loop(size_t ring_index);
+    
+    // Arm a callback on the calling worker's timer wheel, or hand it to a
+    // worker first when called from another thread
+    void schedule_at(std::chrono::steady_clock::time_point when, std::function<void()> callback) {
+        if (t_current_context != this || !t_current_ring) {
+            post([this, when, cb = std::move(callback)]() mutable {
+                schedule_at(when, std::move(cb));
+            });
+            return;
+        }
+        
+        auto* task = new ScheduledCallback{{}, std::move(callback)};
+        task->entry.user_data = task;
+        task->entry.on_expire = [](TimerEntry& entry) {
+            std::unique_ptr<ScheduledCallback> owned(static_cast<ScheduledCallback*>(entry.user_data));
+            if (owned->callback) {
+                owned->callback();
+            }
+        };
+        t_current_ring->timers.schedule(task->entry, t_current_ring->tick_for(when));
+    }
+    
+    size_t ring_index_of(const WorkerRing* worker_ring) const noexcept {
+        for (size_t i = 0; i < rings_.size(); ++i) {
+            if (rings_[i].get() == worker_ring) {
+                return i;
+            }
+        }
+        return 0;
+    }
+    
+    // Wake a ring's worker. A worker of this context sends an
+    // IORING_OP_MSG_RING from its own ring (no syscall of its own; it rides
+    // the next batched submit); other threads write the target's eventfd.
+    void wake_ring(WorkerRing* target) {
+        if (t_current_context == this && t_current_ring) {
+            if (t_current_ring == target) {
+                return;  // Drained at the end of this loop iteration
+            }
+#ifdef IORING_SETUP_SUBMIT_ALL  // 5.18 headers, which also add IORING_OP_MSG_RING
+            if (WorkerRing::msg_ring_supported.load(std::memory_order_relaxed)) {
+                io_uring_sqe* sqe = t_current_ring->get_sqe();
+                if (sqe) {
+                    io_uring_prep_msg_ring(sqe, target->ring.ring_fd, 0,
+                                           reinterpret_cast<uint64_t>(&target->msg_op), 0);
+                    // Only a failure produces a CQE on the sending ring
+                    io_uring_sqe_set_data(sqe, &target->msg_op);
+                    io_uring_sqe_set_flags(sqe, IOSQE_CQE_SKIP_SUCCESS);
+                    if (!deferred_submit_.load(std::memory_order_relaxed)) {
+                        t_current_ring->flush();
+                    }
+                    return;
+                }
+            }
+#endif
+        }
+        target->wake();
+    }
+    
+    // Run work posted to a ring. Bounded so a flood of posts cannot starve
+    // I/O completions; leftovers run on the next iteration.
+    void process_posted(size_t ring_index) {
+        auto* worker_ring = rings_[ring_index].get();
+        worker_ring->wake_pending.store(false, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        
+        for (int i = 0; i < 1024; ++i) {
+            PostedTask* task = worker_ring->posted.pop();
+            if (!task) {
+                return;
+            }
+            task->run(*task);
+        }
+        worker_ring->wake_pending.store(true, std::memory_order_relaxed);
+    }
+    
+    // Bind the calling thread to a ring so timers and sleeps land on it
+    void enter_worker(size_t ring_index) {
+        rings_[ring_index]->enable_on_current_thread();
+        t_current_ring = rings_[ring_index].get();
+        t_current_context = this;
+        detail::set_thread_timer_hook(&arm_timer_on_current_ring);
+    }
+    
+    // Fire due timers, then make sure the ring's kernel timeout covers the
+    // earliest remaining one so a blocking wait wakes up in time
+    void run_timers(size_t ring_index) {
+        auto* worker_ring = rings_[ring_index].get();
+        auto& wheel = worker_ring->timers;
+        if (wheel.empty()) {
+            return;
+        }
+        
+        uint64_t now = worker_ring->current_tick();
+        wheel.advance(now);
+        
+        auto next = wheel.next_expiry();
+        auto& timer = worker_ring->timer_op;
+        if (!next || (timer.armed && timer.armed_tick <= *next)) {
+            return;
         }
         
-        // Wake up ring 0 to process callbacks
-        if (!rings_.empty()) {
-            rings_[0]->wake();
+        io_uring_sqe* sqe = worker_ring->get_sqe();
+        if (!sqe) {
+            return;
         }
+        
+        uint64_t delay_ms = *next > now ? *next - now : 0;
+        timer.ts.tv_sec = static_cast<long long>(delay_ms / 1000);
+        timer.ts.tv_nsec = static_cast<long long>((delay_ms % 1000) * 1000000);
+        if (timer.armed) {
+            io_uring_prep_timeout_update(sqe, &timer.ts, reinterpret_cast<uint64_t>(&timer), 0);
+            io_uring_sqe_set_data(sqe, nullptr);
+        } else {
+            io_uring_prep_timeout(sqe, &timer.ts, 0, 0);
+            io_uring_sqe_set_data(sqe, &timer);
+        }
+        timer.armed = true;
+        timer.armed_tick = *next;
     }
-
-    void schedule(std::chrono::milliseconds delay, std::function<void()> callback) override {
-        std::thread([this, delay, cb = std::move(callback)]() mutable {
-            std::this_thread::sleep_for(delay);
-            post(std::move(cb));
-        }).detach();
-    }
-
-private:
-    // Accept loop coroutine for multi-accept mode
-    Task<void> accept_loop(size_t ring_index);
     
     void worker_loop(size_t ring_index) {
+        if (rings_[ring_index]->cpu >= 0) {
+            pin_current_thread(rings_[ring_index]->cpu);
+        }
+        enter_worker(ring_index);
+        
         // Start accept loop if multi-accept is enabled
         if (multi_accept_enabled_ && rings_[ring_index]->listen_fd >= 0) {
             accept_loop(ring_index).start_detached();
         }
         
         while (!stopped_) {
+            submit_and_wait(ring_index);
             poll_and_resume(ring_index);
-            
-            // Only ring 0 processes callbacks
-            if (ring_index == 0) {
-                process_callbacks();
-            }
+            run_timers(ring_index);
+            process_posted(ring_index);
         }
     }
 
-    void poll_and_resume(size_t ring_index) {
+    // Flush every SQE queued since the last pass and wait for work as the
+    // wait policy dictates. Blocking waits submit in the same io_uring_enter.
+    void submit_and_wait(size_t ring_index) {
+        using clock = std::chrono::steady_clock;
         auto* worker_ring = rings_[ring_index].get();
-        io_uring_cqe* cqe;
+        auto start = clock::now();
+        WorkerRing::add_ns(worker_ring->busy_ns, start - worker_ring->busy_since);
         
-        // Use short timeout - balance between latency and CPU usage
-        __kernel_timespec ts;
-        ts.tv_sec = 0;
-        ts.tv_nsec = 1000; // 1µs timeout for low latency
+        auto policy = wait_policy_.load(std::memory_order_relaxed);
+        bool ready = has_work(worker_ring);
         
-        int ret = io_uring_wait_cqe_timeout(&worker_ring->ring, &cqe, &ts);
-        if (ret == -ETIME || ret < 0) {
-            return;
+        if (ready || policy != WaitPolicy::Block) {
+            worker_ring->flush();
+        }
+        
+        if (!ready && policy != WaitPolicy::Block) {
+            auto budget = policy == WaitPolicy::BusyPoll
+                ? clock::duration::max()
+                : worker_ring->spin_budget(std::chrono::nanoseconds(
+                      max_spin_ns_.load(std::memory_order_relaxed)));
+            if (budget > clock::duration::zero()) {
+                ready = spin(worker_ring, start, budget);
+                WorkerRing::add_ns(worker_ring->spin_ns, clock::now() - start);
+            }
+        }
+        
+        if (!ready) {
+            // Wakeups from other threads arrive as eventfd completions
+            worker_ring->arm_eventfd();
+            auto block_start = clock::now();
+            int ret = io_uring_submit_and_wait(&worker_ring->ring, 1);
+            worker_ring->record_submit(ret);
+            WorkerRing::add_ns(worker_ring->idle_ns, clock::now() - block_start);
+        }
+        
+        worker_ring->busy_since = clock::now();
+        worker_ring->record_wait(worker_ring->busy_since - start);
+    }
+    
+    // Completions to reap, leftover posted work, or a stop request
+    bool has_work(WorkerRing* worker_ring) {
+        return worker_ring->cq_ready() ||
+               !worker_ring->posted.empty() ||
+               stopped_.load(std::memory_order_relaxed);
+    }
+    
+    // Poll for work until it shows up or the budget runs out
+    bool spin(WorkerRing* worker_ring, std::chrono::steady_clock::time_point start,
+              std::chrono::steady_clock::duration budget) {
+        auto now = start;
+        while (now - start < budget) {
+            for (int i = 0; i < 16; ++i) {
+                if (has_work(worker_ring)) {
+                    return true;
+                }
+                cpu_relax();
+            }
+            now = std::chrono::steady_clock::now();
         }
+        return has_work(worker_ring);
+    }
+
+    void poll_and_resume(size_t ring_index) {
+        auto* worker_ring = rings_[ring_index].get();
+        io_uring_cqe* cqe;
         
         // Process all available completions in batch
         unsigned head;
@@ -352,35 +1564,39 @@ private:
         io_uring_for_each_cqe(&worker_ring->ring, head, cqe) {
             auto* op = static_cast<UringOperation*>(io_uring_cqe_get_data(cqe));
             if (op) {
-                op->result = cqe->res;
-                if (cqe->res < 0) {
-                    op->error = Error::system(std::error_code(-cqe->res, std::system_category()));
-                }
-                
-                // Resume coroutine inline
-                if (op->continuation) {
-                    op->continuation.resume();
-                }
+                complete_operation(*op, *cqe);
             }
             processed++;
             if (processed >= 512) break;  // Limit batch size
         }
         io_uring_cq_advance(&worker_ring->ring, processed);
     }
-
-    void process_callbacks() {
-        for (int i = 0; i < 32; ++i) {
-            std::function<void()> callback;
-            {
-                std::lock_guard lock(callback_mutex_);
-                if (callbacks_.empty()) return;
-                callback = std::move(callbacks_.front());
-                callbacks_.pop();
-            }
-            if (callback) {
-                callback();
-            }
+    
+    static void complete_operation(UringOperation& op, const io_uring_cqe& cqe) {
+        if (op.on_complete) {
+            op.on_complete(op, cqe);
+            return;
+        }
+        
+        op.result = cqe.res;
+        op.cqe_flags = cqe.flags;
+        if (cqe.res < 0) {
+            op.error = Error::system(std::error_code(-cqe.res, std::system_category()));
         }
+        
+        // Resume coroutine inline. Multishot operations deliver several
+        // CQEs to the same op, so the handle is consumed before resuming.
+        if (auto h = std::exchange(op.continuation, nullptr)) {
+            h.resume();
+        }
+    }
+    
+    // Complete an operation that never reached the kernel as if it had
+    static void fail_operation(UringOperation* op, int res) {
+        io_uring_cqe cqe{};
+        cqe.user_data = reinterpret_cast<uint64_t>(op);
+        cqe.res = res;
+        complete_operation(*op, cqe);
     }
 };
 
@@ -391,7 +1607,7 @@ private:
 class UringListener : public Listener {
     UringContext& ctx_;
     int listen_fd_ = -1;
-    uint16_t port_ = 0;
+    Endpoint endpoint_;
 
 public:
     explicit UringListener(UringContext& ctx) : ctx_(ctx) {}
@@ -400,41 +1616,17 @@ public:
         close();
     }
 
-    expected<void, Error> listen(uint16_t port, int backlog) override {
-        listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
-        if (listen_fd_ < 0) {
-            return unexpected(Error::system(std::error_code(errno, std::system_category())));
-        }
-        
-        // Set SO_REUSEADDR
-        int opt = 1;
-        setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
-        
-        // Bind
-        sockaddr_in addr{};
-        addr.sin_family = AF_INET;
-        addr.sin_addr.s_addr = INADDR_ANY;
-        addr.sin_port = htons(port);
-        
-        if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
-            ::close(listen_fd_);
-            listen_fd_ = -1;
-            return unexpected(Error::system(std::error_code(errno, std::system_category())));
-        }
-        
-        // Listen
-        if (::listen(listen_fd_, backlog) < 0) {
-            ::close(listen_fd_);
-            listen_fd_ = -1;
-            return unexpected(Error::system(std::error_code(errno, std::system_category())));
+    using Listener::listen;
+
+    expected<void, Error> listen(const Endpoint& endpoint, int backlog) override {
+        auto fd = detail::open_listen_socket(endpoint, backlog);
+        if (!fd) {
+            return unexpected(fd.error());
         }
+        listen_fd_ = *fd;
         
-        // Get actual port
-        sockaddr_in bound_addr{};
-        socklen_t addr_len = sizeof(bound_addr);
-        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&bound_addr), &addr_len);
-        port_ = ntohs(bound_addr.sin_port);
-        
+        // Resolve an ephemeral port
+        endpoint_ = endpoint.with_port(detail::local_endpoint(listen_fd_).port());
         return {};
     }
     
@@ -447,6 +1639,9 @@ public:
         if (listen_fd_ >= 0) {
             ::close(listen_fd_);
             listen_fd_ = -1;
+            if (endpoint_.is_unix() && !endpoint_.is_abstract()) {
+                ::unlink(endpoint_.address().c_str());
+            }
         }
     }
     
@@ -455,7 +1650,11 @@ public:
     }
 
     uint16_t local_port() const noexcept override {
-        return port_;
+        return endpoint_.port();
+    }
+    
+    Endpoint local_endpoint() const override {
+        return endpoint_;
     }
 };
 
@@ -467,36 +1666,63 @@ class UringConnection : public Connection {
     UringContext& ctx_;
     int fd_;
     size_t ring_index_;  // Which ring this connection is assigned to
-    std::chrono::milliseconds timeout_{30000};
+    std::chrono::milliseconds read_timeout_{0};   // 0 = no deadline
+    std::chrono::milliseconds write_timeout_{0};
     CancellationToken cancel_token_;
     std::string remote_addr_;
     uint16_t remote_port_ = 0;
+    RecvStream* recv_ = nullptr;  // Multishot recv (provided-buffer mode only)
 
 public:
-    UringConnection(UringContext& ctx, int fd, const sockaddr_in& addr, size_t ring_index = 0)
+    UringConnection(UringContext& ctx, int fd, const sockaddr_storage& addr, socklen_t addr_len,
+                    size_t ring_index = 0)
         : ctx_(ctx)
         , fd_(fd)
         , ring_index_(ring_index)
     {
-        char ip[INET_ADDRSTRLEN];
-        inet_ntop(AF_INET, &addr.sin_addr, ip, sizeof(ip));
-        remote_addr_ = ip;
-        remote_port_ = ntohs(addr.sin_port);
+        Endpoint peer = Endpoint::from_sockaddr(&addr, addr_len);
+        remote_addr_ = peer.address();
+        remote_port_ = peer.port();
+        
+        ctx_.worker_ring(ring_index_)->connections.fetch_add(1, std::memory_order_relaxed);
+        
+        if (auto* pool = ctx_.provided_buffers(ring_index_)) {
+            recv_ = new RecvStream(pool);
+        }
     }
     
     size_t ring_index() const noexcept { return ring_index_; }
     
     ~UringConnection() override {
         close();
+        ctx_.worker_ring(ring_index_)->connections.fetch_sub(1, std::memory_order_relaxed);
     }
 
     Task<ReadResult> async_read(void* buffer, size_t len) override;
+    Task<LeaseResult> async_read_lease(size_t max_len) override;
+    bool supports_read_lease() const noexcept override { return recv_ != nullptr; }
     Task<ReadResult> async_read_until(void* buffer, size_t len, char delimiter) override;
     Task<WriteResult> async_write(const void* buffer, size_t len) override;
     Task<WriteResult> async_write_all(const void* buffer, size_t len) override;
+    Task<WriteResult> async_writev(std::span<const IoVec> buffers) override;
     Task<TransmitResult> async_transmit_file(FileHandle file, size_t offset, size_t length) override;
 
     void close() override {
+        if (recv_) {
+            if (recv_->armed) {
+                // The kernel still references the stream; it is freed by its
+                // completion handler once the multishot terminates
+                recv_->orphaned = true;
+                for (const auto& chunk : recv_->chunks) {
+                    recv_->buffers->recycle(chunk.bid);
+                }
+                recv_->chunks.clear();
+                ctx_.submit_cancel(ring_index_, recv_);
+            } else {
+                delete recv_;
+            }
+            recv_ = nullptr;
+        }
         if (fd_ >= 0) {
             ::close(fd_);
             fd_ = -1;
@@ -508,7 +1734,16 @@ public:
     }
 
     void set_timeout(std::chrono::milliseconds timeout) override {
-        timeout_ = timeout;
+        read_timeout_ = timeout;
+        write_timeout_ = timeout;
+    }
+    
+    void set_read_timeout(std::chrono::milliseconds timeout) override {
+        read_timeout_ = timeout;
+    }
+    
+    void set_write_timeout(std::chrono::milliseconds timeout) override {
+        write_timeout_ = timeout;
     }
 
     std::string remote_address() const override {
@@ -524,6 +1759,15 @@ public:
     }
 
     int fd() const noexcept { return fd_; }
+
+    int native_socket() const noexcept override { return fd_; }
+
+private:
+    // Wait until the multishot recv has queued data. Returns false if the
+    // provided-buffer pool ran dry, in which case a plain recv should be used.
+    Task<expected<bool, Error>> wait_for_data();
+    
+    Task<TransmitResult> transmit_file_buffered(FileHandle file, size_t offset, size_t length);
 };
 
 // ============================================================================
@@ -538,8 +1782,10 @@ Task<AcceptResult> UringListener::async_accept() {
     UringOperation op{UringOpType::Accept};
     int fd = listen_fd_;
     
-    // Submit accept to ring 0
-    bool submitted = ctx_.submit_sqe(0, &op, [fd, &op](io_uring_sqe* sqe) {
+    // Accept on the caller's ring: the accept loop may have been handed off
+    // to any ring by a previous accept, and only a ring's owner may submit
+    size_t ring_index = ctx_.current_ring_index();
+    bool submitted = ctx_.submit_sqe(ring_index, &op, [fd, &op](io_uring_sqe* sqe) {
         io_uring_prep_accept(sqe, fd, 
                              reinterpret_cast<sockaddr*>(&op.client_addr), 
                              &op.client_addr_len, 0);
@@ -560,11 +1806,110 @@ Task<AcceptResult> UringListener::async_accept() {
         co_return unexpected(Error::system(std::error_code(-op.result, std::system_category())));
     }
     
-    // Connection on ring 0
-    co_return AcceptResult(std::make_unique<UringConnection>(ctx_, op.result, op.client_addr, 0));
+    // Spread connections over the rings, then continue on the chosen one so
+    // the caller starts the connection's coroutine on the thread that owns
+    // its I/O
+    size_t target = ctx_.pick_connection_ring();
+    auto conn = std::make_unique<UringConnection>(ctx_, op.result, op.client_addr,
+                                                  op.client_addr_len, target);
+    co_await ctx_.resume_on(target);
+    co_return AcceptResult(std::move(conn));
+}
+
+Task<expected<bool, Error>> UringConnection::wait_for_data() {
+    while (recv_->chunks.empty()) {
+        if (recv_->end_result == 0) {
+            co_return unexpected(Error::io(IoError::EndOfStream, "Connection closed by peer"));
+        }
+        if (recv_->end_result < 0) {
+            co_return unexpected(Error::system(std::error_code(-recv_->end_result, std::system_category())));
+        }
+        if (recv_->timed_out) {
+            recv_->timed_out = false;
+            if (recv_->armed) {
+                ctx_.submit_cancel(ring_index_, recv_);
+            }
+            co_return unexpected(Error::timeout());
+        }
+        if (recv_->starved) {
+            co_return false;
+        }
+        if (cancel_token_.is_cancelled()) {
+            co_return unexpected(Error::cancelled());
+        }
+        
+        if (!recv_->armed) {
+            int fd = fd_;
+            bool submitted = ctx_.submit_sqe(ring_index_, recv_, [fd](io_uring_sqe* sqe) {
+                io_uring_prep_recv_multishot(sqe, fd, nullptr, 0, 0);
+                sqe->flags |= IOSQE_BUFFER_SELECT;
+                sqe->buf_group = ProvidedBuffers::GROUP_ID;
+            });
+            if (!submitted) {
+                co_return unexpected(Error::io(IoError::Unknown, "Failed to get SQE"));
+            }
+            recv_->armed = true;
+        }
+        
+        if (read_timeout_.count() > 0) {
+            auto* worker_ring = ctx_.worker_ring(ring_index_);
+            worker_ring->timers.schedule(recv_->deadline, worker_ring->tick_for(
+                std::chrono::steady_clock::now() + read_timeout_));
+        }
+        
+        co_await UringAwaiter{*recv_};
+        
+        if (!recv_) {
+            co_return unexpected(Error::io(IoError::ConnectionReset, "Connection closed"));
+        }
+        ctx_.worker_ring(ring_index_)->timers.cancel(recv_->deadline);
+    }
+    co_return true;
+}
+
+Task<LeaseResult> UringConnection::async_read_lease(size_t max_len) {
+    // The connection's I/O state and SQEs belong to its ring's worker; a
+    // caller on another thread continues there (a no-op on the worker)
+    co_await ctx_.resume_on(ring_index_);
+    
+    if (!recv_) {
+        co_return co_await Connection::async_read_lease(max_len);
+    }
+    
+    if (!is_open()) {
+        co_return unexpected(Error::io(IoError::ConnectionReset, "Connection closed"));
+    }
+    
+    auto ready = co_await wait_for_data();
+    if (!ready) {
+        co_return unexpected(ready.error());
+    }
+    if (!*ready) {
+        // Pool exhausted - async_read() falls back to a plain recv
+        co_return co_await Connection::async_read_lease(max_len);
+    }
+    
+    auto& chunk = recv_->chunks.front();
+    const char* data = recv_->buffers->buffer(chunk.bid) + chunk.offset;
+    size_t available = chunk.len - chunk.offset;
+    
+    if (available <= max_len) {
+        BufferLease lease(data, available, &ProvidedBuffers::release_lease,
+                          recv_->buffers, chunk.bid);
+        recv_->chunks.pop_front();
+        co_return lease;
+    }
+    
+    // Caller wants less than the chunk holds: copy out and keep the rest queued
+    auto storage = std::make_unique<char[]>(max_len);
+    std::memcpy(storage.get(), data, max_len);
+    chunk.offset += static_cast<uint32_t>(max_len);
+    co_return BufferLease::owning(std::move(storage), max_len);
 }
 
 Task<ReadResult> UringConnection::async_read(void* buffer, size_t len) {
+    co_await ctx_.resume_on(ring_index_);
+    
     if (!is_open()) {
         co_return unexpected(Error::io(IoError::ConnectionReset, "Connection closed"));
     }
@@ -573,10 +1918,31 @@ Task<ReadResult> UringConnection::async_read(void* buffer, size_t len) {
         co_return unexpected(Error::cancelled());
     }
     
+    if (recv_) {
+        auto ready = co_await wait_for_data();
+        if (!ready) {
+            co_return unexpected(ready.error());
+        }
+        if (*ready) {
+            auto& chunk = recv_->chunks.front();
+            size_t n = std::min<size_t>(len, chunk.len - chunk.offset);
+            std::memcpy(buffer, recv_->buffers->buffer(chunk.bid) + chunk.offset, n);
+            chunk.offset += static_cast<uint32_t>(n);
+            if (chunk.offset == chunk.len) {
+                recv_->buffers->recycle(chunk.bid);
+                recv_->chunks.pop_front();
+            }
+            co_return n;
+        }
+        // Pool exhausted: read this once into the caller's buffer and re-arm
+        // the multishot on the next read
+        recv_->starved = false;
+    }
+    
     UringOperation op{UringOpType::Read};
     int fd = fd_;
     
-    bool submitted = ctx_.submit_sqe(ring_index_, &op, [fd, buffer, len](io_uring_sqe* sqe) {
+    bool submitted = ctx_.submit_linked(ring_index_, &op, read_timeout_, [fd, buffer, len](io_uring_sqe* sqe) {
         io_uring_prep_recv(sqe, fd, buffer, len, 0);
     });
     
@@ -586,6 +1952,10 @@ Task<ReadResult> UringConnection::async_read(void* buffer, size_t len) {
     
     co_await UringAwaiter{op};
     
+    if (op.linked_timeout && op.result == -ECANCELED) {
+        co_return unexpected(Error::timeout());
+    }
+    
     if (op.error) {
         co_return unexpected(op.error);
     }
@@ -620,7 +1990,26 @@ Task<ReadResult> UringConnection::async_read_until(void* buffer, size_t len, cha
     co_return total;
 }
 
+// Map a completed send to the write result
+static WriteResult send_result(const UringOperation& op) {
+    if (op.linked_timeout && op.result == -ECANCELED) {
+        return unexpected(Error::timeout());
+    }
+    
+    if (op.error) {
+        return unexpected(op.error);
+    }
+    
+    if (op.result < 0) {
+        return unexpected(Error::system(std::error_code(-op.result, std::system_category())));
+    }
+    
+    return static_cast<size_t>(op.result);
+}
+
 Task<WriteResult> UringConnection::async_write(const void* buffer, size_t len) {
+    co_await ctx_.resume_on(ring_index_);
+    
     if (!is_open()) {
         co_return unexpected(Error::io(IoError::ConnectionReset, "Connection closed"));
     }
@@ -629,10 +2018,34 @@ Task<WriteResult> UringConnection::async_write(const void* buffer, size_t len) {
         co_return unexpected(Error::cancelled());
     }
     
-    UringOperation op{UringOpType::Write};
     int fd = fd_;
     
-    bool submitted = ctx_.submit_sqe(ring_index_, &op, [fd, buffer, len](io_uring_sqe* sqe) {
+#ifdef IORING_CQE_F_NOTIF
+    if (ctx_.use_send_zc(len)) {
+        ZeroCopySendOp zc_op;
+        bool submitted = ctx_.submit_linked(ring_index_, &zc_op, write_timeout_, [fd, buffer, len](io_uring_sqe* sqe) {
+            io_uring_prep_send_zc(sqe, fd, buffer, len, 0, 0);
+        });
+        if (!submitted) {
+            co_return unexpected(Error::io(IoError::Unknown, "Failed to get SQE"));
+        }
+        
+        co_await UringAwaiter{zc_op};
+        
+        // Unknown opcode (pre-6.0 kernel) or a socket type without zerocopy
+        // support: send this one, and everything after it if the opcode is
+        // missing, the regular way
+        if (zc_op.result == -EINVAL) {
+            ctx_.disable_send_zc();
+        } else if (zc_op.result != -EOPNOTSUPP) {
+            co_return send_result(zc_op);
+        }
+    }
+#endif
+    
+    UringOperation op{UringOpType::Write};
+    
+    bool submitted = ctx_.submit_linked(ring_index_, &op, write_timeout_, [fd, buffer, len](io_uring_sqe* sqe) {
         io_uring_prep_send(sqe, fd, buffer, len, 0);
     });
     
@@ -642,15 +2055,7 @@ Task<WriteResult> UringConnection::async_write(const void* buffer, size_t len) {
     
     co_await UringAwaiter{op};
     
-    if (op.error) {
-        co_return unexpected(op.error);
-    }
-    
-    if (op.result < 0) {
-        co_return unexpected(Error::system(std::error_code(-op.result, std::system_category())));
-    }
-    
-    co_return static_cast<size_t>(op.result);
+    co_return send_result(op);
 }
 
 Task<WriteResult> UringConnection::async_write_all(const void* buffer, size_t len) {
@@ -668,7 +2073,92 @@ Task<WriteResult> UringConnection::async_write_all(const void* buffer, size_t le
     co_return total;
 }
 
+static_assert(sizeof(IoVec) == sizeof(iovec) &&
+              offsetof(IoVec, data) == offsetof(iovec, iov_base) &&
+              offsetof(IoVec, size) == offsetof(iovec, iov_len),
+              "IoVec must match struct iovec");
+
+// Gathered write with IORING_OP_SENDMSG. A short send advances through the
+// iovec array and the remainder is resubmitted.
+Task<WriteResult> UringConnection::async_writev(std::span<const IoVec> buffers) {
+    co_await ctx_.resume_on(ring_index_);
+    
+    if (!is_open()) {
+        co_return unexpected(Error::io(IoError::ConnectionReset, "Connection closed"));
+    }
+    
+    if (cancel_token_.is_cancelled()) {
+        co_return unexpected(Error::cancelled());
+    }
+    
+    // Mutable copy for advancing past partial sends; small batches stay inline
+    constexpr size_t INLINE_IOVS = 16;
+    iovec inline_iov[INLINE_IOVS];
+    std::vector<iovec> heap_iov;
+    iovec* iov = inline_iov;
+    if (buffers.size() > INLINE_IOVS) {
+        heap_iov.resize(buffers.size());
+        iov = heap_iov.data();
+    }
+    size_t count = 0;
+    for (const auto& buf : buffers) {
+        if (buf.size > 0) {
+            iov[count].iov_base = const_cast<void*>(buf.data);
+            iov[count].iov_len = buf.size;
+            ++count;
+        }
+    }
+    
+    size_t first = 0;
+    size_t total = 0;
+    int fd = fd_;
+    
+    while (first < count) {
+        msghdr msg{};
+        msg.msg_iov = iov + first;
+        msg.msg_iovlen = std::min<size_t>(count - first, IOV_MAX);
+        
+        UringOperation op{UringOpType::Write};
+        bool submitted = ctx_.submit_linked(ring_index_, &op, write_timeout_, [fd, &msg](io_uring_sqe* sqe) {
+            io_uring_prep_sendmsg(sqe, fd, &msg, 0);
+        });
+        if (!submitted) {
+            co_return unexpected(Error::io(IoError::Unknown, "Failed to get SQE"));
+        }
+        
+        co_await UringAwaiter{op};
+        
+        auto sent = send_result(op);
+        if (!sent) {
+            co_return unexpected(sent.error());
+        }
+        if (*sent == 0) {
+            co_return unexpected(Error::io(IoError::ConnectionReset, "Connection closed during write"));
+        }
+        total += *sent;
+        
+        size_t advance = *sent;
+        while (advance > 0 && first < count) {
+            if (advance >= iov[first].iov_len) {
+                advance -= iov[first].iov_len;
+                ++first;
+            } else {
+                iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + advance;
+                iov[first].iov_len -= advance;
+                advance = 0;
+            }
+        }
+    }
+    
+    co_return total;
+}
+
+// File -> pipe -> socket with IORING_OP_SPLICE, so neither the disk read nor
+// a full socket buffer ever blocks the ring's thread. The pipe comes from a
+// per-ring pool and goes back only once it has been fully drained.
 Task<TransmitResult> UringConnection::async_transmit_file(FileHandle file, size_t offset, size_t length) {
+    co_await ctx_.resume_on(ring_index_);
+    
     if (!is_open()) {
         co_return unexpected(Error::io(IoError::ConnectionReset, "Connection closed"));
     }
@@ -677,35 +2167,148 @@ Task<TransmitResult> UringConnection::async_transmit_file(FileHandle file, size_
         co_return unexpected(Error::cancelled());
     }
     
-    // Use sendfile for zero-copy file transfer
-    // Note: sendfile is blocking, but for large files we could use io_uring's splice
-    // For now, use sendfile in a simple loop
+    auto& pipes = ctx_.worker_ring(ring_index_)->pipes;
+    PipePool::Pipe pipe;
+    if (!pipes.acquire(pipe)) {
+        co_return co_await transmit_file_buffered(file, offset, length);
+    }
+    
     size_t total_sent = 0;
-    off_t off = static_cast<off_t>(offset);
+    uint64_t file_offset = offset;
+    size_t in_pipe = 0;
+    int sock = fd_;
     
     while (total_sent < length) {
-        ssize_t sent = sendfile(fd_, file, &off, length - total_sent);
-        if (sent < 0) {
-            if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                // Socket buffer full, need to wait for writability
-                UringOperation wait_op{UringOpType::Write};
-                int fd = fd_;
-                bool submitted = ctx_.submit_sqe(ring_index_, &wait_op, [fd](io_uring_sqe* sqe) {
-                    // Use a zero-length send to wait for socket writability
-                    io_uring_prep_send(sqe, fd, nullptr, 0, MSG_NOSIGNAL);
+        if (cancel_token_.is_cancelled()) {
+            pipes.release(pipe, in_pipe == 0);
+            co_return unexpected(Error::cancelled());
+        }
+        
+        // Fill the pipe from the file (page cache or disk, on io-wq if needed)
+        if (in_pipe == 0) {
+            auto chunk = static_cast<unsigned>(std::min(length - total_sent, pipe.capacity));
+            UringOperation fill_op{UringOpType::Read};
+            int write_fd = pipe.write_fd;
+            bool submitted = ctx_.submit_sqe(ring_index_, &fill_op,
+                [file, file_offset, write_fd, chunk](io_uring_sqe* sqe) {
+                    io_uring_prep_splice(sqe, file, static_cast<int64_t>(file_offset),
+                                         write_fd, -1, chunk, SPLICE_F_MOVE);
                 });
-                if (!submitted) {
-                    co_return unexpected(Error::io(IoError::Unknown, "Failed to get SQE"));
+            if (!submitted) {
+                pipes.release(pipe, true);
+                co_return unexpected(Error::io(IoError::Unknown, "Failed to get SQE"));
+            }
+            co_await UringAwaiter{fill_op};
+            
+            if (fill_op.result < 0) {
+                pipes.release(pipe, true);
+                // Not spliceable (e.g. some FUSE/procfs files): copy instead
+                if (total_sent == 0 && (fill_op.result == -EINVAL || fill_op.result == -EOPNOTSUPP)) {
+                    co_return co_await transmit_file_buffered(file, offset, length);
                 }
-                co_await UringAwaiter{wait_op};
-                continue;
+                co_return unexpected(fill_op.error);
+            }
+            if (fill_op.result == 0) {
+                pipes.release(pipe, true);
+                co_return unexpected(Error::io(IoError::EndOfStream, "File ended before the requested range"));
+            }
+            in_pipe = static_cast<size_t>(fill_op.result);
+            file_offset += static_cast<uint64_t>(fill_op.result);
+        }
+        
+        // Drain the pipe into the socket; short splices leave the rest queued
+        UringOperation drain_op{UringOpType::Write};
+        int read_fd = pipe.read_fd;
+        auto pending = static_cast<unsigned>(in_pipe);
+        bool submitted = ctx_.submit_linked(ring_index_, &drain_op, write_timeout_,
+            [read_fd, sock, pending](io_uring_sqe* sqe) {
+                io_uring_prep_splice(sqe, read_fd, -1, sock, -1, pending, SPLICE_F_MOVE);
+            });
+        if (!submitted) {
+            pipes.release(pipe, false);
+            co_return unexpected(Error::io(IoError::Unknown, "Failed to get SQE"));
+        }
+        co_await UringAwaiter{drain_op};
+        
+        // The socket is non-blocking, so a full send buffer fails the splice
+        // rather than waiting; wait for room and drain again
+        if (drain_op.result == -EAGAIN) {
+            UringOperation poll_op{UringOpType::Write};
+            submitted = ctx_.submit_linked(ring_index_, &poll_op, write_timeout_,
+                [sock](io_uring_sqe* sqe) {
+                    io_uring_prep_poll_add(sqe, sock, POLLOUT);
+                });
+            if (!submitted) {
+                pipes.release(pipe, false);
+                co_return unexpected(Error::io(IoError::Unknown, "Failed to get SQE"));
+            }
+            co_await UringAwaiter{poll_op};
+            
+            if (poll_op.result < 0) {
+                pipes.release(pipe, false);
+                if (poll_op.linked_timeout && poll_op.result == -ECANCELED) {
+                    co_return unexpected(Error::timeout());
+                }
+                co_return unexpected(poll_op.error);
+            }
+            continue;
+        }
+        
+        if (drain_op.result <= 0) {
+            pipes.release(pipe, false);
+            if (drain_op.linked_timeout && drain_op.result == -ECANCELED) {
+                co_return unexpected(Error::timeout());
             }
-            co_return unexpected(Error::system(std::error_code(errno, std::system_category())));
+            if (drain_op.result == 0) {
+                co_return unexpected(Error::io(IoError::ConnectionReset, "Connection closed"));
+            }
+            co_return unexpected(drain_op.error);
+        }
+        in_pipe -= static_cast<size_t>(drain_op.result);
+        total_sent += static_cast<size_t>(drain_op.result);
+    }
+    
+    pipes.release(pipe, in_pipe == 0);
+    co_return total_sent;
+}
+
+// Fallback for files that cannot be spliced: async read into a bounce
+// buffer, then write it out
+Task<TransmitResult> UringConnection::transmit_file_buffered(FileHandle file, size_t offset, size_t length) {
+    constexpr size_t CHUNK = 64 * 1024;
+    auto buffer = std::make_unique<char[]>(CHUNK);
+    size_t total_sent = 0;
+    
+    while (total_sent < length) {
+        if (cancel_token_.is_cancelled()) {
+            co_return unexpected(Error::cancelled());
+        }
+        
+        auto chunk = static_cast<unsigned>(std::min(length - total_sent, CHUNK));
+        UringOperation read_op{UringOpType::Read};
+        char* data = buffer.get();
+        uint64_t file_offset = offset + total_sent;
+        bool submitted = ctx_.submit_sqe(ring_index_, &read_op,
+            [file, data, chunk, file_offset](io_uring_sqe* sqe) {
+                io_uring_prep_read(sqe, file, data, chunk, file_offset);
+            });
+        if (!submitted) {
+            co_return unexpected(Error::io(IoError::Unknown, "Failed to get SQE"));
+        }
+        co_await UringAwaiter{read_op};
+        
+        if (read_op.result < 0) {
+            co_return unexpected(read_op.error);
+        }
+        if (read_op.result == 0) {
+            co_return unexpected(Error::io(IoError::EndOfStream, "File ended before the requested range"));
         }
-        if (sent == 0) {
-            break; // EOF on source file
+        
+        auto written = co_await async_write_all(data, static_cast<size_t>(read_op.result));
+        if (!written) {
+            co_return unexpected(written.error());
         }
-        total_sent += static_cast<size_t>(sent);
+        total_sent += *written;
     }
     
     co_return total_sent;
@@ -727,37 +2330,118 @@ static void set_tcp_opts(int fd) {
     setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
 }
 
+// Count accepts whose packets were processed on another CPU than this worker's
+static void record_accept_locality(WorkerRing* worker_ring, int fd) {
+#ifdef SO_INCOMING_CPU
+    int incoming = -1;
+    socklen_t len = sizeof(incoming);
+    if (getsockopt(fd, SOL_SOCKET, SO_INCOMING_CPU, &incoming, &len) != 0 || incoming < 0) {
+        return;
+    }
+    int here = worker_ring->cpu >= 0 ? worker_ring->cpu : sched_getcpu();
+    worker_ring->accepts.fetch_add(1, std::memory_order_relaxed);
+    if (incoming != here) {
+        worker_ring->cross_core_accepts.fetch_add(1, std::memory_order_relaxed);
+    }
+#else
+    (void)worker_ring; (void)fd;
+#endif
+}
+
+// How often a paused accept loop checks whether to resume
+static constexpr std::chrono::milliseconds ACCEPT_PAUSE_POLL{5};
+
 Task<void> UringContext::accept_loop(size_t ring_index) {
     auto* worker_ring = rings_[ring_index].get();
     
+    // A single multishot accept stays armed across connections; each accepted
+    // socket produces one CQE on this op. It is re-armed whenever the kernel
+    // terminates it (no IORING_CQE_F_MORE), and single-shot accept is used on
+    // kernels that do not support multishot.
+    UringOperation& op = worker_ring->accept_op;
+    bool armed = false;
+    bool multishot = false;
+    bool cancelling = false;
+    
     while (!stopped_ && worker_ring->listen_fd >= 0) {
-        UringOperation op{UringOpType::Accept};
-        int fd = worker_ring->listen_fd;
+        // Once closed, an armed accept still owes the CQE that ends it
+        if (accept_closed_.load(std::memory_order_relaxed) && !armed) {
+            break;
+        }
         
-        bool submitted = submit_sqe(ring_index, &op, [fd, &op](io_uring_sqe* sqe) {
-            io_uring_prep_accept(sqe, fd, 
-                                 reinterpret_cast<sockaddr*>(&op.client_addr), 
-                                 &op.client_addr_len, SOCK_NONBLOCK);
-        });
+        // While paused the accept is cancelled, and connections that raced
+        // the cancel are still handed over, until its final CQE disarms it
+        if (accept_paused_.load(std::memory_order_relaxed)) {
+            if (!armed) {
+                co_await sleep_for(ACCEPT_PAUSE_POLL);
+                continue;
+            }
+            if (!cancelling) {
+                cancelling = submit_cancel(ring_index, &op);
+            }
+        }
         
-        if (!submitted) {
-            continue;
+        if (!armed) {
+            cancelling = false;
+            int fd = worker_ring->listen_fd;
+#ifdef IORING_ACCEPT_MULTISHOT
+            multishot = multishot_accept_.load(std::memory_order_relaxed);
+#endif
+            op.error = Error{};
+            op.client_addr_len = sizeof(op.client_addr);
+            
+            bool submitted = submit_sqe(ring_index, &op, [fd, &op, multishot](io_uring_sqe* sqe) {
+#ifdef IORING_ACCEPT_MULTISHOT
+                if (multishot) {
+                    // The peer address is fetched per connection instead: the
+                    // kernel may overwrite a shared sockaddr before we read it
+                    io_uring_prep_multishot_accept(sqe, fd, nullptr, nullptr, SOCK_NONBLOCK);
+                    return;
+                }
+#endif
+                io_uring_prep_accept(sqe, fd, 
+                                     reinterpret_cast<sockaddr*>(&op.client_addr), 
+                                     &op.client_addr_len, SOCK_NONBLOCK);
+            });
+            
+            if (!submitted) {
+                continue;
+            }
+            armed = true;
         }
         
         co_await UringAwaiter{op};
         
+        if (!(op.cqe_flags & IORING_CQE_F_MORE)) {
+            armed = false;
+        }
+        
         if (stopped_) break;
         
         if (op.result < 0) {
+            if (multishot && op.result == -EINVAL) {
+                // Kernel predates multishot accept - fall back to single-shot
+                multishot_accept_.store(false, std::memory_order_relaxed);
+            }
             // Accept error - continue unless stopped
+            op.error = Error{};
             continue;
         }
         
+        if (multishot) {
+            op.client_addr_len = sizeof(op.client_addr);
+            getpeername(op.result, reinterpret_cast<sockaddr*>(&op.client_addr), &op.client_addr_len);
+        }
+        
         // Set TCP optimizations
-        set_tcp_opts(op.result);
+        if (!listen_endpoint_.is_unix()) {
+            set_tcp_opts(op.result);
+            record_accept_locality(worker_ring, op.result);
+        }
         
         // Create connection on this ring
-        auto conn = std::make_unique<UringConnection>(*this, op.result, op.client_addr, ring_index);
+        auto conn = std::make_unique<UringConnection>(*this, op.result, op.client_addr,
+                                                      op.client_addr_len, ring_index);
         
         // Call the connection handler
         if (connection_handler_) {
@@ -772,8 +2456,8 @@ Task<void> UringContext::accept_loop(size_t ring_index) {
 // Factory Functions
 // ============================================================================
 
-std::unique_ptr<IoContext> IoContext::create(size_t thread_count) {
-    return std::make_unique<UringContext>(thread_count);
+std::unique_ptr<IoContext> IoContext::create(const IoContextOptions& options) {
+    return std::make_unique<UringContext>(options);
 }
 
 std::unique_ptr<Listener> Listener::create(IoContext& ctx) {
@@ -142,6 +142,12 @@ public:
     bool stopped() const noexcept override {
         return stopped_;
     }
+    
+    std::string features() const override {
+        return "IOCP, " + std::to_string(thread_count_) + " thread(s)";
+    }
+
+    using IoContext::post;
 
     void post(std::function<void()> callback) override {
         {
@@ -222,7 +228,7 @@ private:
 class IocpListener : public Listener {
     IocpContext& ctx_;
     SOCKET listen_socket_ = INVALID_SOCKET;
-    uint16_t port_ = 0;
+    Endpoint endpoint_;
     LPFN_ACCEPTEX AcceptEx_ = nullptr;
     LPFN_GETACCEPTEXSOCKADDRS GetAcceptExSockaddrs_ = nullptr;
 
@@ -233,7 +239,20 @@ public:
         close();
     }
 
-    expected<void, Error> listen(uint16_t port, int backlog) override {
+    using Listener::listen;
+
+    expected<void, Error> listen(const Endpoint& endpoint, int backlog) override {
+        // Accept sockets are always IPv6, so a specific IPv4 address is bound
+        // through its v4-mapped form on the dual-stack socket
+        Endpoint bind_endpoint = endpoint;
+        if (endpoint.family() == Endpoint::Family::IPv4) {
+            bind_endpoint = Endpoint::ipv6("::ffff:" + endpoint.address(), endpoint.port());
+        }
+        auto addr = bind_endpoint.to_sockaddr();
+        if (!addr) {
+            return unexpected(addr.error());
+        }
+        
         // Create IPv6 socket (dual-stack: accepts both IPv4 and IPv6)
         listen_socket_ = WSASocketW(AF_INET6, SOCK_STREAM, IPPROTO_TCP, nullptr, 0, WSA_FLAG_OVERLAPPED);
         if (listen_socket_ == INVALID_SOCKET) {
@@ -241,7 +260,7 @@ public:
         }
         
         // Disable IPV6_V6ONLY to allow IPv4 connections on this socket (dual-stack)
-        DWORD v6only = 0;
+        DWORD v6only = endpoint.v6_only() ? 1 : 0;
         setsockopt(listen_socket_, IPPROTO_IPV6, IPV6_V6ONLY, 
                    reinterpret_cast<const char*>(&v6only), sizeof(v6only));
         
@@ -277,13 +296,8 @@ public:
             return unexpected(Error::system(std::error_code(WSAGetLastError(), std::system_category())));
         }
         
-        // Bind to IPv6 any address (dual-stack accepts IPv4 too)
-        sockaddr_in6 addr{};
-        addr.sin6_family = AF_INET6;
-        addr.sin6_addr = in6addr_any;
-        addr.sin6_port = htons(port);
-        
-        if (bind(listen_socket_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR) {
+        if (bind(listen_socket_, reinterpret_cast<const sockaddr*>(addr->data()),
+                 static_cast<int>(addr->size)) == SOCKET_ERROR) {
             close();
             return unexpected(Error::system(std::error_code(WSAGetLastError(), std::system_category())));
         }
@@ -298,7 +312,7 @@ public:
         sockaddr_in6 bound_addr{};
         int addr_len = sizeof(bound_addr);
         getsockname(listen_socket_, reinterpret_cast<sockaddr*>(&bound_addr), &addr_len);
-        port_ = ntohs(bound_addr.sin6_port);
+        endpoint_ = endpoint.with_port(ntohs(bound_addr.sin6_port));
         
         return {};
     }
@@ -317,7 +331,11 @@ public:
     }
 
     uint16_t local_port() const noexcept override {
-        return port_;
+        return endpoint_.port();
+    }
+    
+    Endpoint local_endpoint() const override {
+        return endpoint_;
     }
 };
 
@@ -341,13 +359,12 @@ public:
         ctx_.associate(reinterpret_cast<HANDLE>(socket_));
         
         // Get remote address
-        sockaddr_in addr{};
+        sockaddr_storage addr{};
         int addr_len = sizeof(addr);
         if (getpeername(socket_, reinterpret_cast<sockaddr*>(&addr), &addr_len) == 0) {
-            char ip[INET_ADDRSTRLEN];
-            inet_ntop(AF_INET, &addr.sin_addr, ip, sizeof(ip));
-            remote_addr_ = ip;
-            remote_port_ = ntohs(addr.sin_port);
+            Endpoint peer = Endpoint::from_sockaddr(&addr, static_cast<size_t>(addr_len));
+            remote_addr_ = peer.address();
+            remote_port_ = peer.port();
         }
     }
     
@@ -739,8 +756,8 @@ Task<TransmitResult> IocpConnection::async_transmit_file(FileHandle file,
 // Factory Functions
 // ============================================================================
 
-std::unique_ptr<IoContext> IoContext::create(size_t thread_count) {
-    return std::make_unique<IocpContext>(thread_count);
+std::unique_ptr<IoContext> IoContext::create(const IoContextOptions& options) {
+    return std::make_unique<IocpContext>(options.threads);
 }
 
 std::unique_ptr<Listener> Listener::create(IoContext& ctx) {
@@ -87,6 +87,12 @@ public:
     bool stopped() const noexcept override {
         return stopped_;
     }
+    
+    std::string features() const override {
+        return "kqueue, " + std::to_string(thread_count_) + " thread(s)";
+    }
+
+    using IoContext::post;
 
     void post(std::function<void()> callback) override {
         std::lock_guard lock(callback_mutex_);
@@ -144,7 +150,7 @@ private:
 class KqueueListener : public Listener {
     KqueueContext& ctx_;
     int listen_fd_ = -1;
-    uint16_t port_ = 0;
+    Endpoint endpoint_;
 
 public:
     explicit KqueueListener(KqueueContext& ctx) : ctx_(ctx) {}
@@ -153,36 +159,15 @@ public:
         close();
     }
 
-    expected<void, Error> listen(uint16_t port, int backlog) override {
-        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
-        if (listen_fd_ < 0) {
-            return unexpected(Error::system(std::error_code(errno, std::system_category())));
-        }
-        
-        int opt = 1;
-        setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
-        
-        sockaddr_in addr{};
-        addr.sin_family = AF_INET;
-        addr.sin_addr.s_addr = INADDR_ANY;
-        addr.sin_port = htons(port);
-        
-        if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
-            ::close(listen_fd_);
-            listen_fd_ = -1;
-            return unexpected(Error::system(std::error_code(errno, std::system_category())));
-        }
-        
-        if (::listen(listen_fd_, backlog) < 0) {
-            ::close(listen_fd_);
-            listen_fd_ = -1;
-            return unexpected(Error::system(std::error_code(errno, std::system_category())));
+    using Listener::listen;
+
+    expected<void, Error> listen(const Endpoint& endpoint, int backlog) override {
+        auto fd = detail::open_listen_socket(endpoint, backlog);
+        if (!fd) {
+            return unexpected(fd.error());
         }
-        
-        sockaddr_in bound_addr{};
-        socklen_t addr_len = sizeof(bound_addr);
-        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&bound_addr), &addr_len);
-        port_ = ntohs(bound_addr.sin_port);
+        listen_fd_ = *fd;
+        endpoint_ = endpoint.with_port(detail::local_endpoint(listen_fd_).port());
         
         // Register with kqueue
         struct kevent ev;
@@ -201,6 +186,9 @@ public:
         if (listen_fd_ >= 0) {
             ::close(listen_fd_);
             listen_fd_ = -1;
+            if (endpoint_.is_unix()) {
+                ::unlink(endpoint_.address().c_str());
+            }
         }
     }
     
@@ -209,7 +197,11 @@ public:
     }
 
     uint16_t local_port() const noexcept override {
-        return port_;
+        return endpoint_.port();
+    }
+    
+    Endpoint local_endpoint() const override {
+        return endpoint_;
     }
 };
 
@@ -283,8 +275,8 @@ public:
 // Factory Functions
 // ============================================================================
 
-std::unique_ptr<IoContext> IoContext::create(size_t thread_count) {
-    return std::make_unique<KqueueContext>(thread_count);
+std::unique_ptr<IoContext> IoContext::create(const IoContextOptions& options) {
+    return std::make_unique<KqueueContext>(options.threads);
 }
 
 std::unique_ptr<Listener> Listener::create(IoContext& ctx) {
@@ -1,9 +1,104 @@
 #include "coroute/net/io_context.hpp"
+#include "coroute/net/endpoint.hpp"
 
-// Placeholder - socket utilities shared across platforms
+// Socket utilities shared across the POSIX backends
 
-namespace coroute::net {
+#ifndef _WIN32
 
-// Common socket utilities will go here
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
 
-} // namespace coroute::net
+namespace coroute::net::detail {
+
+namespace {
+
+Error errno_error(int err) {
+    return Error::system(std::error_code(err, std::system_category()));
+}
+
+// Remove a socket file left behind by a process that exited without
+// unlinking it. A socket that still accepts connections is left alone.
+void remove_stale_socket(const SocketAddress& addr, const std::string& path) {
+    struct stat st{};
+    if (::stat(path.c_str(), &st) != 0 || !S_ISSOCK(st.st_mode)) {
+        return;
+    }
+    int probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe < 0) {
+        return;
+    }
+    bool live = ::connect(probe, reinterpret_cast<const sockaddr*>(addr.data()), addr.size) == 0;
+    int err = errno;
+    ::close(probe);
+    if (!live && err == ECONNREFUSED) {
+        ::unlink(path.c_str());
+    }
+}
+
+} // namespace
+
+expected<int, Error> open_listen_socket(const Endpoint& endpoint, int backlog, bool reuse_port) {
+    auto resolved = endpoint.to_sockaddr();
+    if (!resolved) {
+        return unexpected(resolved.error());
+    }
+    SocketAddress* addr = &*resolved;
+
+    int fd = ::socket(addr->domain, SOCK_STREAM, 0);
+    if (fd < 0 && endpoint.family() == Endpoint::Family::Any && errno == EAFNOSUPPORT) {
+        // Host without IPv6: fall back to IPv4 on all interfaces
+        if (auto v4 = Endpoint::ipv4("0.0.0.0", endpoint.port()).to_sockaddr()) {
+            *addr = *v4;
+            fd = ::socket(addr->domain, SOCK_STREAM, 0);
+        }
+    }
+    if (fd < 0) {
+        return unexpected(errno_error(errno));
+    }
+
+    // SOCK_NONBLOCK / SOCK_CLOEXEC are not available on every platform
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+    int opt = 1;
+    if (addr->domain != AF_UNIX) {
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+        if (reuse_port) {
+            setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt));
+        }
+    }
+    if (addr->domain == AF_INET6) {
+        int v6only = endpoint.v6_only() ? 1 : 0;
+        setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &v6only, sizeof(v6only));
+    }
+    if (addr->domain == AF_UNIX && !endpoint.is_abstract()) {
+        remove_stale_socket(*addr, endpoint.address());
+    }
+
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(addr->data()), addr->size) < 0 ||
+        ::listen(fd, backlog) < 0) {
+        int err = errno;
+        ::close(fd);
+        return unexpected(errno_error(err));
+    }
+
+    return fd;
+}
+
+Endpoint local_endpoint(int fd) {
+    sockaddr_storage ss{};
+    socklen_t len = sizeof(ss);
+    if (::getsockname(fd, reinterpret_cast<sockaddr*>(&ss), &len) != 0) {
+        return Endpoint{};
+    }
+    return Endpoint::from_sockaddr(&ss, len);
+}
+
+} // namespace coroute::net::detail
+
+#endif // _WIN32
@@ -1,4 +1,5 @@
 #include "coroute/net/tls.hpp"
+#include "coroute/util/object_pool.hpp"
 
 #ifdef COROUTE_HAS_TLS
 
@@ -6,7 +7,37 @@
 #include <openssl/err.h>
 #include <openssl/x509.h>
 #include <openssl/bio.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/kdf.h>
+#include <openssl/rand.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#endif
+#include <atomic>
+#include <charconv>
 #include <cstring>
+#include <fstream>
+#include <iterator>
+#include <shared_mutex>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <linux/tls.h>
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif
 
 namespace coroute::net {
 
@@ -75,8 +106,656 @@ int sni_callback(SSL* ssl, int* al, void* arg) {
     return SSL_TLSEXT_ERR_OK;
 }
 
+// TLS 1.3 application traffic secrets of one connection, in the order the
+// keylog callback reports them
+struct TrafficSecrets {
+    std::vector<uint8_t> client;
+    std::vector<uint8_t> server;
+    
+    void wipe() {
+        OPENSSL_cleanse(client.data(), client.size());
+        OPENSSL_cleanse(server.data(), server.size());
+        client.clear();
+        server.clear();
+    }
+};
+
+// Installed only for kernel TLS: the keylog lines are the one place
+// OpenSSL hands out the traffic secrets the kernel needs
+void keylog_callback(const SSL* ssl, const char* line) {
+    auto* secrets = static_cast<TrafficSecrets*>(SSL_get_app_data(ssl));
+    if (!secrets) return;
+    
+    std::string_view text(line);
+    std::vector<uint8_t>* target = nullptr;
+    if (text.starts_with("CLIENT_TRAFFIC_SECRET_0 ")) {
+        target = &secrets->client;
+    } else if (text.starts_with("SERVER_TRAFFIC_SECRET_0 ")) {
+        target = &secrets->server;
+    } else {
+        return;
+    }
+    
+    // <label> <client random> <secret>, both in hex
+    std::string_view hex = text.substr(text.rfind(' ') + 1);
+    target->clear();
+    for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+        uint8_t byte = 0;
+        std::from_chars(hex.data() + i, hex.data() + i + 2, byte, 16);
+        target->push_back(byte);
+    }
+}
+
+// Count the application_data records (the ones that advance the record
+// sequence number) in a run of TLS records. `missing` is set to the bytes
+// still needed to complete the trailing record, if it is partial.
+size_t count_records(const unsigned char* data, size_t len, size_t& missing) {
+    constexpr size_t HEADER = 5;
+    constexpr unsigned char APPLICATION_DATA = 23;
+    size_t records = 0;
+    size_t pos = 0;
+    missing = 0;
+    
+    while (pos < len) {
+        if (len - pos < HEADER) {
+            missing = HEADER - (len - pos);
+            break;
+        }
+        size_t body = (static_cast<size_t>(data[pos + 3]) << 8) | data[pos + 4];
+        if (len - pos < HEADER + body) {
+            missing = HEADER + body - (len - pos);
+            break;
+        }
+        if (data[pos] == APPLICATION_DATA) {
+            records++;
+        }
+        pos += HEADER + body;
+    }
+    return records;
+}
+
+#if defined(__linux__) && defined(TLS_1_3_VERSION)
+
+// HKDF-Expand-Label(secret, label, "", len) from RFC 8446 section 7.1
+bool hkdf_expand_label(const EVP_MD* md, const std::vector<uint8_t>& secret,
+                       std::string_view label, uint8_t* out, size_t len) {
+    std::vector<uint8_t> info;
+    info.push_back(static_cast<uint8_t>(len >> 8));
+    info.push_back(static_cast<uint8_t>(len));
+    info.push_back(static_cast<uint8_t>(6 + label.size()));
+    for (char c : std::string_view("tls13 ")) info.push_back(static_cast<uint8_t>(c));
+    for (char c : label) info.push_back(static_cast<uint8_t>(c));
+    info.push_back(0);  // Empty context
+    
+    EVP_PKEY_CTX* pctx = EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, nullptr);
+    bool ok = pctx &&
+        EVP_PKEY_derive_init(pctx) > 0 &&
+        EVP_PKEY_CTX_hkdf_mode(pctx, EVP_PKEY_HKDEF_MODE_EXPAND_ONLY) > 0 &&
+        EVP_PKEY_CTX_set_hkdf_md(pctx, md) > 0 &&
+        EVP_PKEY_CTX_set1_hkdf_key(pctx, secret.data(), static_cast<int>(secret.size())) > 0 &&
+        EVP_PKEY_CTX_add1_hkdf_info(pctx, info.data(), static_cast<int>(info.size())) > 0 &&
+        EVP_PKEY_derive(pctx, out, &len) > 0;
+    EVP_PKEY_CTX_free(pctx);
+    return ok;
+}
+
+constexpr uint16_t TLS_AES_128_GCM_SHA256 = 0x1301;
+constexpr uint16_t TLS_AES_256_GCM_SHA384 = 0x1302;
+constexpr uint16_t TLS_CHACHA20_POLY1305_SHA256 = 0x1303;
+
+bool kernel_supports_suite(uint16_t suite) {
+    switch (suite) {
+        case TLS_AES_128_GCM_SHA256:
+        case TLS_AES_256_GCM_SHA384:
+            return true;
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+        case TLS_CHACHA20_POLY1305_SHA256:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+// Derive one direction's key and IV from its traffic secret and hand them,
+// with the next record sequence number, to the socket (TLS_TX or TLS_RX)
+bool install_kernel_keys(int fd, int direction, uint16_t suite,
+                         const std::vector<uint8_t>& secret, uint64_t seq) {
+    const EVP_MD* md = suite == TLS_AES_256_GCM_SHA384 ? EVP_sha384() : EVP_sha256();
+    size_t key_len = suite == TLS_AES_128_GCM_SHA256 ? 16 : 32;
+    uint8_t key[32];
+    uint8_t iv[12];
+    if (!hkdf_expand_label(md, secret, "key", key, key_len) ||
+        !hkdf_expand_label(md, secret, "iv", iv, sizeof(iv))) {
+        return false;
+    }
+    
+    uint8_t rec_seq[8];
+    for (int i = 0; i < 8; ++i) {
+        rec_seq[i] = static_cast<uint8_t>(seq >> (56 - 8 * i));
+    }
+    
+    // The kernel splits the 12-byte TLS 1.3 IV into salt and explicit IV
+    union {
+        tls12_crypto_info_aes_gcm_128 aes128;
+        tls12_crypto_info_aes_gcm_256 aes256;
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+        tls12_crypto_info_chacha20_poly1305 chacha;
+#endif
+    } info{};
+    socklen_t size = 0;
+    
+    switch (suite) {
+        case TLS_AES_128_GCM_SHA256:
+            info.aes128.info.version = TLS_1_3_VERSION;
+            info.aes128.info.cipher_type = TLS_CIPHER_AES_GCM_128;
+            std::memcpy(info.aes128.key, key, 16);
+            std::memcpy(info.aes128.salt, iv, 4);
+            std::memcpy(info.aes128.iv, iv + 4, 8);
+            std::memcpy(info.aes128.rec_seq, rec_seq, 8);
+            size = sizeof(info.aes128);
+            break;
+        case TLS_AES_256_GCM_SHA384:
+            info.aes256.info.version = TLS_1_3_VERSION;
+            info.aes256.info.cipher_type = TLS_CIPHER_AES_GCM_256;
+            std::memcpy(info.aes256.key, key, 32);
+            std::memcpy(info.aes256.salt, iv, 4);
+            std::memcpy(info.aes256.iv, iv + 4, 8);
+            std::memcpy(info.aes256.rec_seq, rec_seq, 8);
+            size = sizeof(info.aes256);
+            break;
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+        case TLS_CHACHA20_POLY1305_SHA256:
+            info.chacha.info.version = TLS_1_3_VERSION;
+            info.chacha.info.cipher_type = TLS_CIPHER_CHACHA20_POLY1305;
+            std::memcpy(info.chacha.key, key, 32);
+            std::memcpy(info.chacha.iv, iv, 12);
+            std::memcpy(info.chacha.rec_seq, rec_seq, 8);
+            size = sizeof(info.chacha);
+            break;
+#endif
+        default:
+            break;
+    }
+    
+    bool ok = size > 0 && setsockopt(fd, SOL_TLS, direction, &info, size) == 0;
+    OPENSSL_cleanse(key, sizeof(key));
+    OPENSSL_cleanse(iv, sizeof(iv));
+    OPENSSL_cleanse(&info, sizeof(info));
+    return ok;
+}
+
+#endif // __linux__ && TLS_1_3_VERSION
+
 } // anonymous namespace
 
+// Per-connection kernel TLS state. Only sending moves to the kernel:
+// received records stay with OpenSSL, which handles the alerts and
+// post-handshake messages a plain read of a TLS_RX socket would fail on.
+struct TlsConnection::KernelTls {
+    TrafficSecrets secrets;  // Cleared once the keys are installed
+    bool is_server = true;
+    bool tx = false;
+};
+
+// ============================================================================
+// Record Buffers - the connection's BIO
+// ============================================================================
+
+namespace {
+
+// Largest TLS record on the wire (header + 16 KB payload + expansion)
+constexpr size_t MAX_RECORD_SIZE = 5 + 16384 + 2048;
+
+// A buffer is held only while ciphertext is queued, so idle connections
+// keep none. Each worker thread pools its own, so taking one never
+// contends, and one that grew past the default size (behind a large
+// gathered write) is freed rather than kept.
+constexpr size_t RECORD_BUFFER_SIZE = 64 * 1024;
+
+struct RecordBuffer : std::vector<char> {};
+using RecordBufferPool = ThreadLocalPool<RecordBuffer>;
+
+std::unique_ptr<RecordBuffer> acquire_record_buffer(size_t min_size = RECORD_BUFFER_SIZE) {
+    auto buf = RecordBufferPool::acquire();
+    if (buf->capacity() < min_size) {
+        buf->reserve(min_size);
+    }
+    return buf;
+}
+
+void release_record_buffer(std::unique_ptr<RecordBuffer> buf) {
+    if (!buf || buf->capacity() > RECORD_BUFFER_SIZE) {
+        return;
+    }
+    buf->clear();
+    RecordBufferPool::release(std::move(buf));
+}
+
+} // anonymous namespace
+
+struct TlsConnection::RecordBuffers {
+    // Received ciphertext not yet consumed by OpenSSL: either a lease on the
+    // inner connection's receive buffer, or a pooled buffer
+    BufferLease lease;
+    std::unique_ptr<RecordBuffer> in;
+    const char* in_data = nullptr;
+    size_t in_size = 0;
+    
+    // Records produced since the last flush
+    std::unique_ptr<RecordBuffer> out;
+    
+    ~RecordBuffers() {
+        release_input();
+        release_record_buffer(std::move(out));
+    }
+    
+    size_t pending_out() const noexcept { return out ? out->size() : 0; }
+    
+    void set_input(BufferLease received) {
+        release_input();
+        lease = std::move(received);
+        in_data = lease.data();
+        in_size = lease.size();
+    }
+    
+    // Room for `len` more received bytes after what is still unread
+    char* reserve_input(size_t len) {
+        if (!in) {
+            in = acquire_record_buffer(in_size + len);
+        }
+        if (in_size > 0 && in_data != in->data()) {
+            // Compact (or move out of a lease) so reads land right after
+            std::vector<char> unread(in_data, in_data + in_size);
+            in->assign(unread.begin(), unread.end());
+            lease.reset();
+        } else if (in_size == 0) {
+            in->clear();
+        }
+        in->resize(in_size + len);
+        in_data = in->data();
+        return in->data() + in_size;
+    }
+    
+    void commit_input(size_t len) noexcept { in_size += len; }
+    
+    void consume_input(size_t len) {
+        in_data += len;
+        in_size -= len;
+        if (in_size == 0) release_input();
+    }
+    
+    void release_input() {
+        lease.reset();
+        release_record_buffer(std::move(in));
+        in_data = nullptr;
+        in_size = 0;
+    }
+};
+
+// BIO_METHOD whose reads drain RecordBuffers' input and whose writes append
+// to its output. Nothing touches the socket; the coroutine callers do.
+struct RecordBio {
+    using Buffers = TlsConnection::RecordBuffers;
+    
+    static const BIO_METHOD* method() {
+        static BIO_METHOD* m = [] {
+            BIO_METHOD* meth = BIO_meth_new(BIO_get_new_index() | BIO_TYPE_SOURCE_SINK,
+                                            "coroute record buffers");
+            BIO_meth_set_write(meth, write);
+            BIO_meth_set_read(meth, read);
+            BIO_meth_set_ctrl(meth, ctrl);
+            BIO_meth_set_create(meth, [](BIO* bio) { BIO_set_init(bio, 1); return 1; });
+            return meth;
+        }();
+        return m;
+    }
+    
+    static int write(BIO* bio, const char* data, int len) {
+        auto* buffers = static_cast<Buffers*>(BIO_get_data(bio));
+        BIO_clear_retry_flags(bio);
+        if (!buffers->out) {
+            buffers->out = acquire_record_buffer();
+        }
+        buffers->out->insert(buffers->out->end(), data, data + len);
+        return len;
+    }
+    
+    static int read(BIO* bio, char* out, int len) {
+        auto* buffers = static_cast<Buffers*>(BIO_get_data(bio));
+        BIO_clear_retry_flags(bio);
+        if (buffers->in_size == 0) {
+            BIO_set_retry_read(bio);
+            return -1;
+        }
+        size_t n = std::min(static_cast<size_t>(len), buffers->in_size);
+        std::memcpy(out, buffers->in_data, n);
+        buffers->consume_input(n);
+        return static_cast<int>(n);
+    }
+    
+    static long ctrl(BIO* bio, int cmd, long, void*) {
+        auto* buffers = static_cast<Buffers*>(BIO_get_data(bio));
+        switch (cmd) {
+            case BIO_CTRL_FLUSH:
+                return 1;  // Sent by the caller after the SSL call returns
+            case BIO_CTRL_PENDING:
+                return static_cast<long>(buffers->in_size);
+            case BIO_CTRL_WPENDING:
+                return static_cast<long>(buffers->pending_out());
+            default:
+                return 0;
+        }
+    }
+};
+
+// ============================================================================
+// Session Resumption
+// ============================================================================
+
+TicketKey TicketKey::generate() {
+    TicketKey key;
+    key.hmac_secret.resize(32);
+    key.aes_key.resize(32);
+    RAND_bytes(key.name.data(), static_cast<int>(key.name.size()));
+    RAND_bytes(key.hmac_secret.data(), 32);
+    RAND_bytes(key.aes_key.data(), 32);
+    return key;
+}
+
+expected<TicketKey, Error> TicketKey::load(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (!in.is_open() || (bytes.size() != 48 && bytes.size() != 80)) {
+        return unexpected(Error::io(IoError::InvalidArgument,
+            "Ticket key file must hold 48 or 80 bytes: " + path.string()));
+    }
+    
+    size_t half = (bytes.size() - 16) / 2;
+    TicketKey key;
+    std::memcpy(key.name.data(), bytes.data(), 16);
+    key.hmac_secret.assign(bytes.begin() + 16, bytes.begin() + 16 + half);
+    key.aes_key.assign(bytes.begin() + 16 + half, bytes.end());
+    OPENSSL_cleanse(bytes.data(), bytes.size());
+    return key;
+}
+
+expected<void, Error> TicketKey::save(const std::filesystem::path& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(name.data()), name.size());
+    out.write(reinterpret_cast<const char*>(hmac_secret.data()), hmac_secret.size());
+    out.write(reinterpret_cast<const char*>(aes_key.data()), aes_key.size());
+    if (!out) {
+        return unexpected(Error::io(IoError::Unknown, "Failed to write ticket key: " + path.string()));
+    }
+    std::filesystem::permissions(path, std::filesystem::perms::owner_read | std::filesystem::perms::owner_write);
+    return {};
+}
+
+StripedMemorySessionCache::StripedMemorySessionCache(size_t capacity, size_t stripes,
+                                                     std::chrono::seconds ttl)
+    : stripe_capacity_(std::max<size_t>(1, capacity / std::max<size_t>(1, stripes)))
+    , ttl_(ttl)
+{
+    stripes_.reserve(std::max<size_t>(1, stripes));
+    for (size_t i = 0; i < std::max<size_t>(1, stripes); ++i) {
+        stripes_.push_back(std::make_unique<Stripe>());
+    }
+}
+
+StripedMemorySessionCache::Stripe& StripedMemorySessionCache::stripe_for(std::string_view id) {
+    return *stripes_[std::hash<std::string_view>{}(id) % stripes_.size()];
+}
+
+void StripedMemorySessionCache::store(std::string_view id, std::string session) {
+    Stripe& stripe = stripe_for(id);
+    std::lock_guard lock(stripe.mutex);
+    
+    auto it = stripe.entries.find(std::string(id));
+    if (it != stripe.entries.end()) {
+        stripe.order.erase(it->second.order);
+        stripe.entries.erase(it);
+    } else if (stripe.entries.size() >= stripe_capacity_) {
+        stripe.entries.erase(stripe.order.front());
+        stripe.order.pop_front();
+    }
+    
+    auto pos = stripe.order.emplace(stripe.order.end(), id);
+    stripe.entries.emplace(*pos, Entry{std::move(session), Clock::now() + ttl_, pos});
+}
+
+std::optional<std::string> StripedMemorySessionCache::load(std::string_view id) {
+    Stripe& stripe = stripe_for(id);
+    std::lock_guard lock(stripe.mutex);
+    
+    auto it = stripe.entries.find(std::string(id));
+    if (it == stripe.entries.end()) {
+        return std::nullopt;
+    }
+    if (it->second.expires <= Clock::now()) {
+        stripe.order.erase(it->second.order);
+        stripe.entries.erase(it);
+        return std::nullopt;
+    }
+    return it->second.session;
+}
+
+void StripedMemorySessionCache::remove(std::string_view id) {
+    Stripe& stripe = stripe_for(id);
+    std::lock_guard lock(stripe.mutex);
+    
+    auto it = stripe.entries.find(std::string(id));
+    if (it != stripe.entries.end()) {
+        stripe.order.erase(it->second.order);
+        stripe.entries.erase(it);
+    }
+}
+
+size_t StripedMemorySessionCache::size() const {
+    size_t total = 0;
+    for (const auto& stripe : stripes_) {
+        std::lock_guard lock(stripe->mutex);
+        total += stripe->entries.size();
+    }
+    return total;
+}
+
+// Everything OpenSSL callbacks need, reachable from the SSL_CTX
+struct TlsContext::State {
+    std::shared_mutex keys_mutex;
+    std::vector<TicketKey> ticket_keys;  // [0] encrypts
+    std::vector<std::filesystem::path> ticket_key_files;
+    std::shared_ptr<SessionCache> session_cache;
+    
+    std::atomic<uint64_t> handshakes{0};
+    std::atomic<uint64_t> resumed{0};
+    std::atomic<uint64_t> tickets_renewed{0};
+    std::atomic<uint64_t> cache_hits{0};
+    std::atomic<uint64_t> cache_misses{0};
+    
+    static int index() {
+        static int idx = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+        return idx;
+    }
+    
+    static State* of(SSL* ssl) {
+        return static_cast<State*>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), index()));
+    }
+    
+    // OpenSSL callbacks
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    static int ticket_key_callback(SSL* ssl, unsigned char* key_name, unsigned char* iv,
+                                   EVP_CIPHER_CTX* cipher_ctx, EVP_MAC_CTX* mac_ctx, int enc);
+#else
+    static int ticket_key_callback(SSL* ssl, unsigned char* key_name, unsigned char* iv,
+                                   EVP_CIPHER_CTX* cipher_ctx, HMAC_CTX* mac_ctx, int enc);
+#endif
+    static int new_session_callback(SSL* ssl, SSL_SESSION* session);
+    static SSL_SESSION* get_session_callback(SSL* ssl, const unsigned char* id, int id_len, int* copy);
+    static void remove_session_callback(SSL_CTX* ctx, SSL_SESSION* session);
+};
+
+namespace {
+
+expected<std::vector<TicketKey>, Error> load_ticket_keys(const std::vector<std::filesystem::path>& files) {
+    std::vector<TicketKey> keys;
+    for (const auto& file : files) {
+        auto key = TicketKey::load(file);
+        if (!key) {
+            return unexpected(key.error());
+        }
+        keys.push_back(std::move(*key));
+    }
+    return keys;
+}
+
+const EVP_CIPHER* ticket_cipher(const TicketKey& key) {
+    return key.aes_key.size() == 32 ? EVP_aes_256_cbc() : EVP_aes_128_cbc();
+}
+
+// SHA-256 over what decides whether a session may be trusted again: the
+// server certificate, the client verification mode and the CAs client
+// certificates are checked against. Servers agree on it exactly when
+// they are configured alike, so a session never resumes into a context
+// that would have refused the original handshake.
+bool set_session_id_context(SSL_CTX* ctx, const TlsConfig& config) {
+    EVP_MD_CTX* md = EVP_MD_CTX_new();
+    if (!md || EVP_DigestInit_ex(md, EVP_sha256(), nullptr) != 1) {
+        EVP_MD_CTX_free(md);
+        return false;
+    }
+    
+    bool ok = true;
+    if (X509* cert = SSL_CTX_get0_certificate(ctx)) {
+        unsigned char* der = nullptr;
+        int len = i2d_X509(cert, &der);
+        ok = len > 0 && EVP_DigestUpdate(md, der, static_cast<size_t>(len)) == 1;
+        OPENSSL_free(der);
+    }
+    
+    int mode = SSL_CTX_get_verify_mode(ctx);
+    ok = ok && EVP_DigestUpdate(md, &mode, sizeof(mode)) == 1;
+    
+    if (ok && !config.ca_file.empty()) {
+        std::ifstream in(config.ca_file, std::ios::binary);
+        std::string ca((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        ok = EVP_DigestUpdate(md, ca.data(), ca.size()) == 1;
+    }
+    
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int digest_len = 0;
+    ok = ok && EVP_DigestFinal_ex(md, digest, &digest_len) == 1;
+    EVP_MD_CTX_free(md);
+    
+    return ok && SSL_CTX_set_session_id_context(ctx, digest, digest_len) == 1;
+}
+
+} // anonymous namespace
+
+// Encrypt new tickets under the current key; decrypt with whichever key
+// named the ticket, asking OpenSSL to reissue it if that is an old one
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+int TlsContext::State::ticket_key_callback(SSL* ssl, unsigned char* key_name, unsigned char* iv,
+                                           EVP_CIPHER_CTX* cipher_ctx, EVP_MAC_CTX* mac_ctx, int enc) {
+#else
+int TlsContext::State::ticket_key_callback(SSL* ssl, unsigned char* key_name, unsigned char* iv,
+                                           EVP_CIPHER_CTX* cipher_ctx, HMAC_CTX* mac_ctx, int enc) {
+#endif
+    auto* state = of(ssl);
+    std::shared_lock lock(state->keys_mutex);
+    if (state->ticket_keys.empty()) {
+        return enc ? -1 : 0;
+    }
+    
+    const TicketKey* key = nullptr;
+    size_t index = 0;
+    if (enc) {
+        key = &state->ticket_keys.front();
+        std::memcpy(key_name, key->name.data(), key->name.size());
+        if (RAND_bytes(iv, EVP_CIPHER_iv_length(ticket_cipher(*key))) != 1) {
+            return -1;
+        }
+    } else {
+        for (; index < state->ticket_keys.size(); ++index) {
+            if (std::memcmp(key_name, state->ticket_keys[index].name.data(), 16) == 0) {
+                key = &state->ticket_keys[index];
+                break;
+            }
+        }
+        if (!key) {
+            return 0;  // Unknown key: full handshake
+        }
+    }
+    
+    if (EVP_CipherInit_ex(cipher_ctx, ticket_cipher(*key), nullptr,
+                          key->aes_key.data(), iv, enc) != 1) {
+        return -1;
+    }
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    char digest[] = "SHA256";
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest, 0),
+        OSSL_PARAM_construct_end()
+    };
+    if (EVP_MAC_init(mac_ctx, key->hmac_secret.data(), key->hmac_secret.size(), params) != 1) {
+        return -1;
+    }
+#else
+    if (HMAC_Init_ex(mac_ctx, key->hmac_secret.data(), static_cast<int>(key->hmac_secret.size()),
+                     EVP_sha256(), nullptr) != 1) {
+        return -1;
+    }
+#endif
+    
+    if (!enc && index > 0) {
+        state->tickets_renewed.fetch_add(1, std::memory_order_relaxed);
+        return 2;
+    }
+    return 1;
+}
+
+int TlsContext::State::new_session_callback(SSL* ssl, SSL_SESSION* session) {
+    auto* state = of(ssl);
+    unsigned int id_len = 0;
+    const unsigned char* id = SSL_SESSION_get_id(session, &id_len);
+    int size = i2d_SSL_SESSION(session, nullptr);
+    if (size <= 0) {
+        return 0;
+    }
+    
+    std::string der(static_cast<size_t>(size), '\0');
+    auto* out = reinterpret_cast<unsigned char*>(der.data());
+    i2d_SSL_SESSION(session, &out);
+    state->session_cache->store(std::string_view(reinterpret_cast<const char*>(id), id_len),
+                                std::move(der));
+    return 0;  // No reference kept on the SSL_SESSION
+}
+
+SSL_SESSION* TlsContext::State::get_session_callback(SSL* ssl, const unsigned char* id,
+                                                     int id_len, int* copy) {
+    auto* state = of(ssl);
+    *copy = 0;
+    auto der = state->session_cache->load(
+        std::string_view(reinterpret_cast<const char*>(id), static_cast<size_t>(id_len)));
+    if (!der) {
+        state->cache_misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    
+    const auto* in = reinterpret_cast<const unsigned char*>(der->data());
+    SSL_SESSION* session = d2i_SSL_SESSION(nullptr, &in, static_cast<long>(der->size()));
+    auto& counter = session ? state->cache_hits : state->cache_misses;
+    counter.fetch_add(1, std::memory_order_relaxed);
+    return session;
+}
+
+void TlsContext::State::remove_session_callback(SSL_CTX* ctx, SSL_SESSION* session) {
+    auto* state = static_cast<State*>(SSL_CTX_get_ex_data(ctx, index()));
+    unsigned int id_len = 0;
+    const unsigned char* id = SSL_SESSION_get_id(session, &id_len);
+    state->session_cache->remove(std::string_view(reinterpret_cast<const char*>(id), id_len));
+}
+
 // ============================================================================
 // TlsContext Implementation
 // ============================================================================
@@ -89,7 +768,9 @@ TlsContext::~TlsContext() {
 
 TlsContext::TlsContext(TlsContext&& other) noexcept
     : ctx_(other.ctx_)
+    , kernel_tls_(other.kernel_tls_)
     , sni_callback_(std::move(other.sni_callback_))
+    , state_(std::move(other.state_))
 {
     other.ctx_ = nullptr;
 }
@@ -98,7 +779,9 @@ TlsContext& TlsContext::operator=(TlsContext&& other) noexcept {
     if (this != &other) {
         if (ctx_) SSL_CTX_free(ctx_);
         ctx_ = other.ctx_;
+        kernel_tls_ = other.kernel_tls_;
         sni_callback_ = std::move(other.sni_callback_);
+        state_ = std::move(other.state_);
         other.ctx_ = nullptr;
     }
     return *this;
@@ -178,13 +861,41 @@ expected<TlsContext, Error> TlsContext::create(const TlsConfig& config) {
         }
     }
     
+    result.state_ = std::make_unique<State>();
+    SSL_CTX_set_ex_data(result.ctx_, State::index(), result.state_.get());
+    
+    // Sessions are only resumed within the same ID context. Deriving it from
+    // the config lets every process serving this config resume the others'
+    // sessions, and no differently configured one.
+    if (!set_session_id_context(result.ctx_, config)) {
+        return unexpected(make_tls_error("Failed to set session ID context"));
+    }
+    
     // Configure session tickets
     if (!config.session_tickets) {
         SSL_CTX_set_options(result.ctx_, SSL_OP_NO_TICKET);
+    } else if (!config.ticket_key_files.empty()) {
+        auto keys = load_ticket_keys(config.ticket_key_files);
+        if (!keys) {
+            return unexpected(keys.error());
+        }
+        result.state_->ticket_keys = std::move(*keys);
+        result.state_->ticket_key_files = config.ticket_key_files;
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        SSL_CTX_set_tlsext_ticket_key_evp_cb(result.ctx_, State::ticket_key_callback);
+#else
+        SSL_CTX_set_tlsext_ticket_key_cb(result.ctx_, State::ticket_key_callback);
+#endif
     }
     
     // Configure session cache
-    if (config.session_cache_size > 0) {
+    if (config.session_cache) {
+        result.state_->session_cache = config.session_cache;
+        SSL_CTX_set_session_cache_mode(result.ctx_, SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL);
+        SSL_CTX_sess_set_new_cb(result.ctx_, State::new_session_callback);
+        SSL_CTX_sess_set_get_cb(result.ctx_, State::get_session_callback);
+        SSL_CTX_sess_set_remove_cb(result.ctx_, State::remove_session_callback);
+    } else if (config.session_cache_size > 0) {
         SSL_CTX_set_session_cache_mode(result.ctx_, SSL_SESS_CACHE_SERVER);
         SSL_CTX_sess_set_cache_size(result.ctx_, config.session_cache_size);
     } else {
@@ -198,6 +909,14 @@ expected<TlsContext, Error> TlsContext::create(const TlsConfig& config) {
         SSL_CTX_set_alpn_select_cb(result.ctx_, alpn_select_callback, protocols);
     }
     
+    // Kernel TLS needs the traffic secrets (Linux only)
+#ifdef __linux__
+    if (config.kernel_tls) {
+        result.kernel_tls_ = true;
+        SSL_CTX_set_keylog_callback(result.ctx_, keylog_callback);
+    }
+#endif
+    
     // Enable SNI
     SSL_CTX_set_tlsext_servername_callback(result.ctx_, sni_callback);
     SSL_CTX_set_tlsext_servername_arg(result.ctx_, &result);
@@ -219,6 +938,30 @@ void TlsContext::set_sni_callback(SniCallback callback) {
     sni_callback_ = std::move(callback);
 }
 
+void TlsContext::set_ticket_keys(std::vector<TicketKey> keys) {
+    std::unique_lock lock(state_->keys_mutex);
+    state_->ticket_keys = std::move(keys);
+}
+
+expected<void, Error> TlsContext::reload_ticket_keys() {
+    auto keys = load_ticket_keys(state_->ticket_key_files);
+    if (!keys) {
+        return unexpected(keys.error());
+    }
+    set_ticket_keys(std::move(*keys));
+    return {};
+}
+
+TlsStats TlsContext::stats() const {
+    TlsStats out;
+    out.handshakes = state_->handshakes.load(std::memory_order_relaxed);
+    out.resumed = state_->resumed.load(std::memory_order_relaxed);
+    out.tickets_renewed = state_->tickets_renewed.load(std::memory_order_relaxed);
+    out.cache_hits = state_->cache_hits.load(std::memory_order_relaxed);
+    out.cache_misses = state_->cache_misses.load(std::memory_order_relaxed);
+    return out;
+}
+
 // ============================================================================
 // TlsConnection Implementation
 // ============================================================================
@@ -244,20 +987,22 @@ expected<std::unique_ptr<TlsConnection>, Error> TlsConnection::create(
         return unexpected(make_tls_error("Failed to create SSL object"));
     }
     
-    // Create BIO pair for async I/O
-    // rbio: we write network data into it, SSL reads from it
-    // wbio: SSL writes encrypted data into it, we read from it
-    BIO* rbio = BIO_new(BIO_s_mem());
-    BIO* wbio = BIO_new(BIO_s_mem());
-    conn->rbio_ = rbio;
-    conn->wbio_ = wbio;
-    
-    if (!rbio || !wbio) {
-        return unexpected(make_tls_error("Failed to create BIO pair"));
+    // One BIO over the connection's record buffers, for both directions
+    conn->records_ = std::make_unique<RecordBuffers>();
+    BIO* bio = BIO_new(RecordBio::method());
+    if (!bio) {
+        return unexpected(make_tls_error("Failed to create BIO"));
     }
+    BIO_set_data(bio, conn->records_.get());
+    
+    // SSL takes ownership
+    SSL_set_bio(conn->ssl_, bio, bio);
     
-    // Set BIOs (SSL takes ownership)
-    SSL_set_bio(conn->ssl_, rbio, wbio);
+    if (ctx.kernel_tls()) {
+        conn->ktls_ = std::make_unique<KernelTls>();
+        conn->ktls_->is_server = is_server;
+        SSL_set_app_data(conn->ssl_, &conn->ktls_->secrets);
+    }
     
     // Set server/client mode
     if (is_server) {
@@ -269,7 +1014,10 @@ expected<std::unique_ptr<TlsConnection>, Error> TlsConnection::create(
     return conn;
 }
 
-Task<expected<void, Error>> TlsConnection::handshake() {
+Task<expected<void, Error>> TlsConnection::handshake(std::chrono::milliseconds timeout) {
+    using clock = std::chrono::steady_clock;
+    const bool bounded = timeout.count() > 0;
+    const auto deadline = clock::now() + timeout;
     int iteration = 0;
     
     while (true) {
@@ -277,11 +1025,46 @@ Task<expected<void, Error>> TlsConnection::handshake() {
         int result = SSL_do_handshake(ssl_);
         
         if (result == 1) {
+            ctx_->state_->handshakes.fetch_add(1, std::memory_order_relaxed);
+            if (SSL_session_reused(ssl_)) {
+                ctx_->state_->resumed.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (ktls_) {
+                // A server's queued records now (session tickets) were sealed
+                // with the application keys, so they set where the kernel's
+                // sequence numbers start. A client's are its last handshake
+                // flight (Finished, and any certificate), which still uses
+                // the handshake keys despite the application_data outer type,
+                // so its application records start at zero. Either way, send
+                // them before the kernel takes over.
+                size_t missing = 0;
+                size_t tx_records = ktls_->is_server && records_->out
+                    ? count_records(reinterpret_cast<unsigned char*>(records_->out->data()),
+                                    records_->out->size(), missing)
+                    : 0;
+                auto flush_result = co_await flush_write_bio();
+                if (!flush_result) co_return unexpected(flush_result.error());
+                enable_kernel_tls(tx_records);
+            }
+            if (bounded) {
+                inner_->set_read_timeout(std::chrono::milliseconds::zero());
+                inner_->set_write_timeout(std::chrono::milliseconds::zero());
+            }
             co_return expected<void, Error>{};
         }
         
         int err = SSL_get_error(ssl_, result);
         
+        // Each read and write may only use what is left of the budget
+        if (bounded) {
+            auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - clock::now());
+            if (remaining.count() <= 0) {
+                co_return unexpected(Error::timeout());
+            }
+            inner_->set_read_timeout(remaining);
+            inner_->set_write_timeout(remaining);
+        }
+        
         if (err == SSL_ERROR_WANT_READ) {
             auto flush_result = co_await flush_write_bio();
             if (!flush_result) co_return unexpected(flush_result.error());
@@ -307,6 +1090,13 @@ Task<ReadResult> TlsConnection::async_read(void* buffer, size_t len) {
     while (true) {
         int result = SSL_read(ssl_, buffer, static_cast<int>(len));
         
+        // A KeyUpdate asking for ours makes OpenSSL queue a reply sealed
+        // with write state the kernel has since advanced past
+        if (kernel_tls_tx() && records_->pending_out() > 0) {
+            co_return unexpected(Error::io(IoError::Unknown,
+                                           "TLS key update not supported with kernel TLS"));
+        }
+        
         if (result > 0) {
             co_return static_cast<size_t>(result);
         }
@@ -345,6 +1135,10 @@ Task<ReadResult> TlsConnection::async_read_until(void* buffer, size_t len, char
 }
 
 Task<WriteResult> TlsConnection::async_write(const void* data, size_t len) {
+    if (kernel_tls_tx()) {
+        co_return co_await inner_->async_write(data, len);
+    }
+    
     int result = SSL_write(ssl_, data, static_cast<int>(len));
     
     if (result > 0) {
@@ -366,6 +1160,10 @@ Task<WriteResult> TlsConnection::async_write(const void* data, size_t len) {
 }
 
 Task<WriteResult> TlsConnection::async_write_all(const void* data, size_t len) {
+    if (kernel_tls_tx()) {
+        co_return co_await inner_->async_write_all(data, len);
+    }
+    
     const char* ptr = static_cast<const char*>(data);
     size_t remaining = len;
     size_t total = 0;
@@ -383,23 +1181,124 @@ Task<WriteResult> TlsConnection::async_write_all(const void* data, size_t len) {
     co_return total;
 }
 
+// Encrypt every buffer into the write BIO, then send the records together.
+// The BIO is flushed early only once a batch grows large, to bound memory.
+Task<WriteResult> TlsConnection::async_writev(std::span<const IoVec> buffers) {
+    if (kernel_tls_tx()) {
+        co_return co_await inner_->async_writev(buffers);
+    }
+    
+    constexpr int FLUSH_THRESHOLD = 256 * 1024;
+    size_t total = 0;
+    
+    for (const auto& buf : buffers) {
+        const char* ptr = static_cast<const char*>(buf.data);
+        size_t remaining = buf.size;
+        
+        while (remaining > 0) {
+            size_t written = 0;
+            if (SSL_write_ex(ssl_, ptr, remaining, &written) == 1) {
+                ptr += written;
+                remaining -= written;
+                total += written;
+                if (records_->pending_out() >= FLUSH_THRESHOLD) {
+                    auto flush_result = co_await flush_write_bio();
+                    if (!flush_result) co_return unexpected(flush_result.error());
+                }
+                continue;
+            }
+            
+            if (SSL_get_error(ssl_, 0) != SSL_ERROR_WANT_WRITE) {
+                co_return unexpected(Error::io(IoError::Unknown, "TLS write error"));
+            }
+            auto flush_result = co_await flush_write_bio();
+            if (!flush_result) co_return unexpected(flush_result.error());
+        }
+    }
+    
+    auto flush_result = co_await flush_write_bio();
+    if (!flush_result) co_return unexpected(flush_result.error());
+    co_return total;
+}
+
 Task<TransmitResult> TlsConnection::async_transmit_file(
     FileHandle file, size_t offset, size_t length)
 {
-    // TLS doesn't support zero-copy file transmission
-    // Fall back to reading file and writing through TLS
-    // This is a simplified implementation - production code would buffer
-    
+    // With kernel TLS the socket encrypts, so the inner connection's
+    // sendfile/splice path works unchanged
+    if (kernel_tls_tx()) {
+        co_return co_await inner_->async_transmit_file(file, offset, length);
+    }
+    co_return co_await transmit_file_buffered(file, offset, length);
+}
+
+// Without kernel TLS every byte has to pass through OpenSSL: read the file
+// into a bounce buffer and encrypt it from there
+Task<TransmitResult> TlsConnection::transmit_file_buffered(
+    FileHandle file, size_t offset, size_t length)
+{
+#ifdef _WIN32
     (void)file;
     (void)offset;
     (void)length;
+    co_return unexpected(Error::io(IoError::InvalidArgument, "TLS does not support file transfer on Windows"));
+#else
+    constexpr size_t CHUNK = 64 * 1024;
+    auto buffer = std::make_unique<char[]>(CHUNK);
+    size_t total_sent = 0;
+    
+    while (total_sent < length) {
+        size_t chunk = std::min(length - total_sent, CHUNK);
+        ssize_t n = ::pread(file, buffer.get(), chunk, static_cast<off_t>(offset + total_sent));
+        if (n < 0) {
+            co_return unexpected(Error::system(std::error_code(errno, std::system_category())));
+        }
+        if (n == 0) {
+            break;  // EOF on source file
+        }
+        
+        auto written = co_await async_write_all(buffer.get(), static_cast<size_t>(n));
+        if (!written) co_return unexpected(written.error());
+        total_sent += *written;
+    }
+    
+    co_return total_sent;
+#endif
+}
+
+bool TlsConnection::kernel_tls_tx() const noexcept {
+    return ktls_ && ktls_->tx;
+}
+
+// Switch sending to the socket (TLS_TX). If any step fails the connection
+// stays on OpenSSL, which still holds valid state.
+void TlsConnection::enable_kernel_tls(size_t tx_records) {
+#if defined(__linux__) && defined(TLS_1_3_VERSION)
+    TrafficSecrets& secrets = ktls_->secrets;
+    const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl_);
+    uint16_t suite = cipher ? SSL_CIPHER_get_protocol_id(cipher) : 0;
+    int fd = inner_->native_socket();
+    
+    if (fd < 0 || SSL_version(ssl_) != TLS1_3_VERSION || !kernel_supports_suite(suite) ||
+        secrets.client.empty() || secrets.server.empty() ||
+        setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) != 0) {
+        secrets.wipe();
+        return;
+    }
+    
+    const auto& own_secret = ktls_->is_server ? secrets.server : secrets.client;
+    ktls_->tx = install_kernel_keys(fd, TLS_TX, suite, own_secret, tx_records);
     
-    // For now, return error - caller should read file and use async_write
-    co_return unexpected(Error::io(IoError::InvalidArgument, "TLS does not support zero-copy file transfer"));
+    secrets.wipe();
+#else
+    ktls_->secrets.wipe();
+    (void)tx_records;
+#endif
 }
 
 void TlsConnection::close() {
-    if (ssl_ && is_open()) {
+    // With kernel TX, OpenSSL's record state is stale; just close the socket
+    if (ssl_ && is_open() && !kernel_tls_tx()) {
         // Attempt clean shutdown (non-blocking)
         SSL_shutdown(ssl_);
     }
@@ -462,6 +1361,14 @@ void TlsConnection::set_timeout(std::chrono::milliseconds timeout) {
     if (inner_) inner_->set_timeout(timeout);
 }
 
+void TlsConnection::set_read_timeout(std::chrono::milliseconds timeout) {
+    if (inner_) inner_->set_read_timeout(timeout);
+}
+
+void TlsConnection::set_write_timeout(std::chrono::milliseconds timeout) {
+    if (inner_) inner_->set_write_timeout(timeout);
+}
+
 std::string TlsConnection::remote_address() const {
     return inner_ ? inner_->remote_address() : "";
 }
@@ -475,32 +1382,36 @@ void TlsConnection::set_cancellation_token(CancellationToken token) {
 }
 
 Task<expected<void, Error>> TlsConnection::flush_write_bio() {
-    char buf[16384];
-    int pending;
-    BIO* wbio = static_cast<BIO*>(wbio_);
-    
-    while ((pending = BIO_pending(wbio)) > 0) {
-        int to_read = std::min(pending, static_cast<int>(sizeof(buf)));
-        int read = BIO_read(wbio, buf, to_read);
-        
-        if (read > 0) {
-            auto result = co_await inner_->async_write_all(buf, read);
-            if (!result) co_return unexpected(result.error());
-        }
+    // Everything queued (several records after a gathered write) goes out
+    // in one write, straight from the buffer OpenSSL wrote into
+    auto& out = records_->out;
+    if (!out || out->empty()) {
+        co_return expected<void, Error>{};
     }
     
+    auto result = co_await inner_->async_write_all(out->data(), out->size());
+    release_record_buffer(std::move(out));
+    if (!result) co_return unexpected(result.error());
+    
     co_return expected<void, Error>{};
 }
 
 Task<expected<void, Error>> TlsConnection::fill_read_bio() {
-    char buf[16384];
-    BIO* rbio = static_cast<BIO*>(rbio_);
+    // Prefer a lease on the inner connection's receive buffer, which
+    // OpenSSL then reads from directly
+    if (inner_->supports_read_lease() && records_->in_size == 0) {
+        auto lease = co_await inner_->async_read_lease(MAX_RECORD_SIZE);
+        if (!lease) co_return unexpected(lease.error());
+        if (lease->empty()) co_return unexpected(Error::io(IoError::ConnectionReset, "Connection closed"));
+        records_->set_input(std::move(*lease));
+        co_return expected<void, Error>{};
+    }
     
-    auto result = co_await inner_->async_read(buf, sizeof(buf));
+    char* buf = records_->reserve_input(MAX_RECORD_SIZE);
+    auto result = co_await inner_->async_read(buf, MAX_RECORD_SIZE);
     if (!result) co_return unexpected(result.error());
     if (*result == 0) co_return unexpected(Error::io(IoError::ConnectionReset, "Connection closed"));
-    
-    BIO_write(rbio, buf, static_cast<int>(*result));
+    records_->commit_input(*result);
     
     co_return expected<void, Error>{};
 }
@@ -50,8 +50,8 @@ constexpr std::string_view WS_MAGIC_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11
 
 bool is_websocket_upgrade(const Request& req) {
     // Check for required headers
-    auto connection = req.header("Connection");
-    auto upgrade = req.header("Upgrade");
+    auto connection = req.header(KnownHeader::Connection);
+    auto upgrade = req.header(KnownHeader::Upgrade);
     auto ws_key = req.header("Sec-WebSocket-Key");
     auto ws_version = req.header("Sec-WebSocket-Version");
     
@@ -65,9 +65,7 @@ bool is_websocket_upgrade(const Request& req) {
     for (auto& c : conn_lower) c = static_cast<char>(std::tolower(c));
     has_upgrade = conn_lower.find("upgrade") != std::string::npos;
     
-    std::string upgrade_lower(*upgrade);
-    for (auto& c : upgrade_lower) c = static_cast<char>(std::tolower(c));
-    bool is_websocket = upgrade_lower == "websocket";
+    bool is_websocket = iequals(*upgrade, "websocket");
     
     // Version must be 13
     bool version_ok = *ws_version == "13";
@@ -396,15 +394,13 @@ private:
         
         auto header_bytes = serialize_frame_header(header);
         
-        // Send header
-        auto header_result = co_await conn_->async_write_all(header_bytes.data(), header_bytes.size());
-        if (!header_result) co_return unexpected(header_result.error());
-        
-        // Send payload
-        if (len > 0) {
-            auto payload_result = co_await conn_->async_write_all(data, len);
-            if (!payload_result) co_return unexpected(payload_result.error());
-        }
+        // Send header and payload in one gathered write
+        const IoVec buffers[] = {
+            {header_bytes.data(), header_bytes.size()},
+            {data, len},
+        };
+        auto result = co_await conn_->async_writev(buffers);
+        if (!result) co_return unexpected(result.error());
         
         co_return expected<void, Error>{};
     }
@@ -0,0 +1,258 @@
+#include <catch2/catch_test_macros.hpp>
+#include <coroute/core/body_stream.hpp>
+#include <coroute/core/request.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace coroute;
+
+namespace {
+
+// Serves `wire` to reads, at most `max_read` bytes at a time
+class ScriptedConnection : public net::Connection {
+public:
+    std::string wire;
+    size_t max_read;
+    size_t offset = 0;
+    int reads = 0;
+
+    explicit ScriptedConnection(std::string data, size_t max_read = 1 << 20)
+        : wire(std::move(data)), max_read(max_read) {}
+
+    Task<net::ReadResult> async_read(void* buffer, size_t len) override {
+        ++reads;
+        size_t n = std::min({len, max_read, wire.size() - offset});
+        std::memcpy(buffer, wire.data() + offset, n);
+        offset += n;
+        co_return n;
+    }
+    Task<net::ReadResult> async_read_until(void*, size_t, char) override { co_return size_t(0); }
+    Task<net::WriteResult> async_write(const void*, size_t len) override { co_return len; }
+    Task<net::WriteResult> async_write_all(const void*, size_t len) override { co_return len; }
+    Task<net::WriteResult> async_writev(std::span<const net::IoVec>) override { co_return size_t(0); }
+    Task<net::TransmitResult> async_transmit_file(net::FileHandle, size_t, size_t) override {
+        co_return size_t(0);
+    }
+    void close() override {}
+    bool is_open() const noexcept override { return true; }
+    void set_timeout(std::chrono::milliseconds) override {}
+    std::string remote_address() const override { return "127.0.0.1"; }
+    uint16_t remote_port() const noexcept override { return 0; }
+    void set_cancellation_token(CancellationToken) override {}
+};
+
+// Every piece next() hands out, joined
+Task<expected<std::string, Error>> drain(BodyStream& stream, size_t& pieces) {
+    std::string body;
+    while (true) {
+        auto piece = co_await stream.next();
+        if (!piece) {
+            co_return unexpected(piece.error());
+        }
+        if (piece->empty()) {
+            break;
+        }
+        CHECK(piece->size() <= BodyStream::PIECE_SIZE);
+        body.append(*piece);
+        ++pieces;
+    }
+    co_return body;
+}
+
+} // namespace
+
+TEST_CASE("BodyStream reads a Content-Length body", "[body_stream]") {
+    using Framing = BodyStream::Framing;
+
+    SECTION("Bytes read with the head come first, then the connection") {
+        ScriptedConnection conn("lo, World!GET / HTTP/1.1", 4);
+        BodyStream stream(conn, Framing::ContentLength, 13, "Hel");
+        REQUIRE(stream.content_length() == 13u);
+
+        size_t pieces = 0;
+        auto body = drain(stream, pieces).sync_wait();
+        REQUIRE(body);
+        CHECK(*body == "Hello, World!");
+        CHECK(stream.finished());
+        CHECK(stream.bytes_read() == 13);
+        // Never reads past the body
+        CHECK(conn.wire.substr(conn.offset) == "GET / HTTP/1.1");
+    }
+
+    SECTION("Large bodies arrive in bounded pieces") {
+        std::string data(100000, 'x');
+        ScriptedConnection conn(data);
+        BodyStream stream(conn, Framing::ContentLength, data.size(), {});
+
+        size_t pieces = 0;
+        auto body = drain(stream, pieces).sync_wait();
+        REQUIRE(body);
+        CHECK(body->size() == data.size());
+        CHECK(pieces == (data.size() + BodyStream::PIECE_SIZE - 1) / BodyStream::PIECE_SIZE);
+    }
+
+    SECTION("A declared size past the limit fails before reading") {
+        ScriptedConnection conn(std::string(100, 'x'));
+        BodyStream stream(conn, Framing::ContentLength, 100, {});
+        stream.set_limit(50);
+
+        auto body = stream.read_all().sync_wait();
+        REQUIRE_FALSE(body);
+        CHECK(body.error().http_error() == HttpError::PayloadTooLarge);
+        CHECK(conn.reads == 0);
+    }
+
+    SECTION("A short body is an error") {
+        ScriptedConnection conn("abc");
+        BodyStream stream(conn, Framing::ContentLength, 10, {});
+        auto body = stream.read_all().sync_wait();
+        REQUIRE_FALSE(body);
+        CHECK(body.error().http_error() == HttpError::BadRequest);
+    }
+
+    SECTION("discard skips what the handler left") {
+        ScriptedConnection conn("23456789");
+        BodyStream stream(conn, Framing::ContentLength, 10, "01");
+        CHECK(stream.discard(64).sync_wait());
+        CHECK(stream.finished());
+
+        ScriptedConnection big(std::string(1000, 'x'));
+        BodyStream too_big(big, Framing::ContentLength, 1000, {});
+        CHECK_FALSE(too_big.discard(64).sync_wait());
+        CHECK(big.reads == 0);
+    }
+}
+
+TEST_CASE("BodyStream decodes a chunked body", "[body_stream]") {
+    using Framing = BodyStream::Framing;
+
+    SECTION("Chunks, extensions and trailers, read a byte at a time") {
+        ScriptedConnection conn("llo\r\n7;ext=1\r\n, World\r\n1\r\n!\r\n0\r\nX-Sum: 1\r\n\r\nGET /", 1);
+        BodyStream stream(conn, Framing::Chunked, 0, "5\r\nHe");
+        CHECK_FALSE(stream.content_length());
+
+        size_t pieces = 0;
+        auto body = drain(stream, pieces).sync_wait();
+        REQUIRE(body);
+        CHECK(*body == "Hello, World!");
+        REQUIRE(stream.trailers().size() == 1);
+        CHECK(stream.trailers()[0].first == "X-Sum");
+        CHECK(stream.trailers()[0].second == "1");
+        CHECK(stream.take_unread() + conn.wire.substr(conn.offset) == "GET /");
+    }
+
+    SECTION("Everything buffered, with the next request behind it") {
+        ScriptedConnection conn("");
+        BodyStream stream(conn, Framing::Chunked, 0, "3\r\nabc\r\n0\r\n\r\nGET / HTTP/1.1\r\n\r\n");
+        auto body = stream.read_all().sync_wait();
+        REQUIRE(body);
+        CHECK(*body == "abc");
+        CHECK(conn.reads == 0);
+        CHECK(stream.take_unread() == "GET / HTTP/1.1\r\n\r\n");
+    }
+
+    SECTION("The limit applies to the decoded size") {
+        ScriptedConnection conn("a\r\n0123456789\r\na\r\n0123456789\r\n0\r\n\r\n");
+        BodyStream stream(conn, Framing::Chunked, 0, {});
+        stream.set_limit(15);
+        auto body = stream.read_all().sync_wait();
+        REQUIRE_FALSE(body);
+        CHECK(body.error().http_error() == HttpError::PayloadTooLarge);
+    }
+
+    SECTION("Malformed chunks are rejected") {
+        ScriptedConnection bad_size("zz\r\n");
+        BodyStream a(bad_size, Framing::Chunked, 0, {});
+        CHECK_FALSE(a.read_all().sync_wait());
+
+        ScriptedConnection no_crlf("3\r\nabcX\r\n0\r\n\r\n");
+        BodyStream b(no_crlf, Framing::Chunked, 0, {});
+        CHECK_FALSE(b.read_all().sync_wait());
+
+        ScriptedConnection huge("ffffffffffffffffff\r\n");
+        BodyStream c(huge, Framing::Chunked, 0, {});
+        CHECK_FALSE(c.read_all().sync_wait());
+    }
+
+    SECTION("Trailers are bounded in total, not just per line") {
+        std::string trailers;
+        while (trailers.size() <= ChunkedBodyReader::MAX_TRAILER_SIZE) {
+            trailers += "X-Pad: 0123456789\r\n";
+        }
+        ScriptedConnection conn("0\r\n" + trailers + "\r\n");
+        BodyStream stream(conn, Framing::Chunked, 0, {});
+        auto body = stream.read_all().sync_wait();
+        REQUIRE_FALSE(body);
+        CHECK(body.error().http_error() == HttpError::RequestHeaderFieldsTooLarge);
+        CHECK(body.error().http_status() == 431);
+    }
+}
+
+TEST_CASE("framing_of refuses ambiguous body framing", "[body_stream]") {
+    using Framing = BodyStream::Framing;
+    using Headers = BasicHeaderMap<std::string_view>;
+
+    auto status_of = [](const Headers& headers) {
+        auto framing = BodyStream::framing_of(headers);
+        REQUIRE_FALSE(framing);
+        return framing.error().http_status();
+    };
+
+    SECTION("Single framing headers") {
+        auto none = BodyStream::framing_of(Headers{{"Host", "x"}});
+        REQUIRE(none);
+        CHECK(none->framing == Framing::None);
+
+        auto length = BodyStream::framing_of(Headers{{"Content-Length", "42"}});
+        REQUIRE(length);
+        CHECK(length->framing == Framing::ContentLength);
+        CHECK(length->content_length == 42u);
+
+        auto empty = BodyStream::framing_of(Headers{{"Content-Length", "0"}});
+        REQUIRE(empty);
+        CHECK(empty->framing == Framing::None);
+
+        auto chunked = BodyStream::framing_of(Headers{{"Transfer-Encoding", "Chunked"}});
+        REQUIRE(chunked);
+        CHECK(chunked->framing == Framing::Chunked);
+
+        CHECK(status_of(Headers{{"Content-Length", "4x"}}) == 400);
+        CHECK(status_of(Headers{{"Transfer-Encoding", "gzip"}}) == 501);
+    }
+
+    SECTION("Conflicting Content-Length values") {
+        CHECK(status_of(Headers{{"Content-Length", "5"}, {"Content-Length", "6"}}) == 400);
+        CHECK(status_of(Headers{{"Content-Length", "5"}, {"content-length", "x"}}) == 400);
+
+        // Repeats of one value are the same framing
+        auto same = BodyStream::framing_of(
+            Headers{{"Content-Length", "5"}, {"Content-Length", "005"}});
+        REQUIRE(same);
+        CHECK(same->content_length == 5u);
+    }
+
+    SECTION("Transfer-Encoding more than once") {
+        CHECK(status_of(Headers{{"Transfer-Encoding", "chunked"},
+                                {"Transfer-Encoding", "chunked"}}) == 400);
+        CHECK(status_of(Headers{{"Transfer-Encoding", "gzip"},
+                                {"Transfer-Encoding", "chunked"}}) == 400);
+    }
+
+    SECTION("Transfer-Encoding with Content-Length") {
+        CHECK(status_of(Headers{{"Transfer-Encoding", "chunked"},
+                                {"Content-Length", "5"}}) == 400);
+        CHECK(status_of(Headers{{"Content-Length", "5"},
+                                {"Transfer-Encoding", "chunked"}}) == 400);
+    }
+}
+
+TEST_CASE("Requests without a body have a finished stream", "[body_stream]") {
+    Request req;
+    CHECK_FALSE(req.body_pending());
+    CHECK(req.body_stream().finished());
+    CHECK(req.body_stream().framing() == BodyStream::Framing::None);
+    auto piece = req.body_stream().next().sync_wait();
+    REQUIRE(piece);
+    CHECK(piece->empty());
+}
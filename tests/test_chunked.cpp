@@ -3,6 +3,46 @@
 
 using namespace coroute;
 
+namespace {
+
+// Records everything written, and how many gathered writes it took
+class CaptureConnection : public net::Connection {
+public:
+    std::string wire;
+    int writev_calls = 0;
+
+    Task<net::ReadResult> async_read(void*, size_t) override { co_return size_t(0); }
+    Task<net::ReadResult> async_read_until(void*, size_t, char) override { co_return size_t(0); }
+    Task<net::WriteResult> async_write(const void* data, size_t len) override {
+        wire.append(static_cast<const char*>(data), len);
+        co_return len;
+    }
+    Task<net::WriteResult> async_write_all(const void* data, size_t len) override {
+        wire.append(static_cast<const char*>(data), len);
+        co_return len;
+    }
+    Task<net::WriteResult> async_writev(std::span<const net::IoVec> buffers) override {
+        ++writev_calls;
+        size_t total = 0;
+        for (const auto& buf : buffers) {
+            wire.append(static_cast<const char*>(buf.data), buf.size);
+            total += buf.size;
+        }
+        co_return total;
+    }
+    Task<net::TransmitResult> async_transmit_file(net::FileHandle, size_t, size_t) override {
+        co_return size_t(0);
+    }
+    void close() override {}
+    bool is_open() const noexcept override { return true; }
+    void set_timeout(std::chrono::milliseconds) override {}
+    std::string remote_address() const override { return "127.0.0.1"; }
+    uint16_t remote_port() const noexcept override { return 0; }
+    void set_cancellation_token(CancellationToken) override {}
+};
+
+} // namespace
+
 TEST_CASE("Chunked encoding utilities", "[chunked]") {
     SECTION("encode_chunk creates valid chunk format") {
         auto chunk = chunked::encode_chunk("Hello");
@@ -84,3 +124,38 @@ TEST_CASE("ChunkedResponse configuration", "[chunked]") {
         CHECK_FALSE(resp.headers_sent());
     }
 }
+
+TEST_CASE("ChunkedResponse gathers headers and chunks", "[chunked]") {
+    CaptureConnection conn;
+    ChunkedResponse resp(&conn);
+    resp.content_type("text/plain");
+
+    SECTION("Headers ride along with the first chunk") {
+        REQUIRE(resp.write(std::string_view("Hello")).sync_wait());
+        REQUIRE(resp.write(std::string_view(", World!")).sync_wait());
+        REQUIRE(resp.finish().sync_wait());
+
+        CHECK(conn.wire ==
+              "HTTP/1.1 200 OK\r\n"
+              "Transfer-Encoding: chunked\r\n"
+              "Content-Type: text/plain\r\n"
+              "\r\n"
+              "5\r\nHello\r\n"
+              "8\r\n, World!\r\n"
+              "0\r\n\r\n");
+        CHECK(conn.writev_calls == 3);
+        CHECK(resp.headers_sent());
+        CHECK(resp.finished());
+    }
+
+    SECTION("Empty response sends headers and final chunk together") {
+        REQUIRE(resp.finish().sync_wait());
+        CHECK(conn.wire ==
+              "HTTP/1.1 200 OK\r\n"
+              "Transfer-Encoding: chunked\r\n"
+              "Content-Type: text/plain\r\n"
+              "\r\n"
+              "0\r\n\r\n");
+        CHECK(conn.writev_calls == 1);
+    }
+}
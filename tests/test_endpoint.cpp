@@ -0,0 +1,151 @@
+#include <catch2/catch_test_macros.hpp>
+#include <coroute/net/endpoint.hpp>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif
+
+#include <string>
+
+using namespace coroute::net;
+
+TEST_CASE("Endpoint parses ports and TCP addresses", "[endpoint]") {
+    auto port_only = Endpoint::parse("8080");
+    REQUIRE(port_only);
+    CHECK(port_only->family() == Endpoint::Family::Any);
+    CHECK(port_only->port() == 8080);
+
+    auto wildcard = Endpoint::parse("*:9000");
+    REQUIRE(wildcard);
+    CHECK(*wildcard == Endpoint::any(9000));
+
+    auto v4 = Endpoint::parse("127.0.0.1:80");
+    REQUIRE(v4);
+    CHECK(v4->family() == Endpoint::Family::IPv4);
+    CHECK(v4->address() == "127.0.0.1");
+    CHECK(v4->port() == 80);
+
+    auto v6 = Endpoint::parse("[::1]:443");
+    REQUIRE(v6);
+    CHECK(v6->family() == Endpoint::Family::IPv6);
+    CHECK(v6->address() == "::1");
+    CHECK(v6->port() == 443);
+}
+
+TEST_CASE("Endpoint parses Unix socket paths", "[endpoint]") {
+    auto path = Endpoint::parse("unix:/run/app.sock");
+    REQUIRE(path);
+    CHECK(path->is_unix());
+    CHECK_FALSE(path->is_abstract());
+    CHECK(path->address() == "/run/app.sock");
+    CHECK(path->port() == 0);
+
+#ifdef __linux__
+    auto abstract = Endpoint::parse("unix:@app");
+    REQUIRE(abstract);
+    CHECK(abstract->is_abstract());
+    CHECK(abstract->address() == "app");
+#endif
+}
+
+TEST_CASE("Endpoint rejects malformed text", "[endpoint]") {
+    CHECK_FALSE(Endpoint::parse(""));
+    CHECK_FALSE(Endpoint::parse("http"));
+    CHECK_FALSE(Endpoint::parse("70000"));
+    CHECK_FALSE(Endpoint::parse("1.2.3.4:"));
+    CHECK_FALSE(Endpoint::parse("1.2.3.999:80"));
+    CHECK_FALSE(Endpoint::parse("::1:80"));
+    CHECK_FALSE(Endpoint::parse("[::1]80"));
+    CHECK_FALSE(Endpoint::parse("unix:"));
+    CHECK_FALSE(Endpoint::parse("unix:/" + std::string(200, 'x')));
+}
+
+TEST_CASE("Endpoint text form round-trips", "[endpoint]") {
+    for (const char* text : {"*:8080", "10.0.0.1:1", "[fe80::1]:65535", "unix:/tmp/a.sock"}) {
+        auto ep = Endpoint::parse(text);
+        REQUIRE(ep);
+        CHECK(ep->to_string() == text);
+    }
+    CHECK(Endpoint::ipv4("127.0.0.1", 0).with_port(4321).to_string() == "127.0.0.1:4321");
+    CHECK(Endpoint::unix_socket("/x").with_port(4321).port() == 0);
+}
+
+#ifndef _WIN32
+TEST_CASE("Endpoint converts to and from sockaddr", "[endpoint]") {
+    SECTION("IPv4") {
+        auto addr = Endpoint::ipv4("192.168.1.2", 8080).to_sockaddr();
+        REQUIRE(addr);
+        CHECK(addr->domain == AF_INET);
+        CHECK(addr->size == sizeof(sockaddr_in));
+        CHECK(Endpoint::from_sockaddr(addr->data(), addr->size) == Endpoint::ipv4("192.168.1.2", 8080));
+    }
+
+    SECTION("wildcard binds IPv6 any") {
+        auto addr = Endpoint::any(80).to_sockaddr();
+        REQUIRE(addr);
+        CHECK(addr->domain == AF_INET6);
+        const auto* sin6 = static_cast<const sockaddr_in6*>(addr->data());
+        CHECK(IN6_IS_ADDR_UNSPECIFIED(&sin6->sin6_addr));
+        CHECK(ntohs(sin6->sin6_port) == 80);
+    }
+
+    SECTION("v4-mapped peers are reported as IPv4") {
+        sockaddr_in6 sin6{};
+        sin6.sin6_family = AF_INET6;
+        sin6.sin6_port = htons(5555);
+        inet_pton(AF_INET6, "::ffff:10.1.2.3", &sin6.sin6_addr);
+        auto ep = Endpoint::from_sockaddr(&sin6, sizeof(sin6));
+        CHECK(ep == Endpoint::ipv4("10.1.2.3", 5555));
+    }
+
+    SECTION("Unix path") {
+        auto addr = Endpoint::unix_socket("/tmp/x.sock").to_sockaddr();
+        REQUIRE(addr);
+        CHECK(addr->domain == AF_UNIX);
+        CHECK(Endpoint::from_sockaddr(addr->data(), addr->size) == Endpoint::unix_socket("/tmp/x.sock"));
+    }
+
+#ifdef __linux__
+    SECTION("abstract name has no terminator") {
+        auto addr = Endpoint::abstract_socket("svc").to_sockaddr();
+        REQUIRE(addr);
+        CHECK(addr->size == offsetof(sockaddr_un, sun_path) + 1 + 3);
+        CHECK(Endpoint::from_sockaddr(addr->data(), addr->size) == Endpoint::abstract_socket("svc"));
+    }
+#endif
+}
+
+TEST_CASE("open_listen_socket binds Unix sockets and replaces stale files", "[endpoint]") {
+    std::string path = "/tmp/coroute_test_" + std::to_string(::getpid()) + ".sock";
+    auto endpoint = Endpoint::unix_socket(path);
+
+    auto first = detail::open_listen_socket(endpoint, 16);
+    REQUIRE(first);
+    CHECK(detail::local_endpoint(*first) == endpoint);
+
+    // A live listener keeps its path
+    auto second = detail::open_listen_socket(endpoint, 16);
+    CHECK_FALSE(second);
+
+    // Once it is gone, the leftover socket file is reclaimed
+    ::close(*first);
+    auto third = detail::open_listen_socket(endpoint, 16);
+    REQUIRE(third);
+    ::close(*third);
+    ::unlink(path.c_str());
+}
+
+TEST_CASE("open_listen_socket resolves ephemeral TCP ports", "[endpoint]") {
+    auto fd = detail::open_listen_socket(Endpoint::ipv4("127.0.0.1", 0), 16);
+    REQUIRE(fd);
+    auto bound = detail::local_endpoint(*fd);
+    CHECK(bound.family() == Endpoint::Family::IPv4);
+    CHECK(bound.address() == "127.0.0.1");
+    CHECK(bound.port() != 0);
+    ::close(*fd);
+}
+#endif
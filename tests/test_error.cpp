@@ -84,5 +84,7 @@ TEST_CASE("Error http_status mapping", "[error]") {
         REQUIRE(Error(HttpError::BadRequest).http_status() == 400);
         REQUIRE(Error(HttpError::NotFound).http_status() == 404);
         REQUIRE(Error(HttpError::Internal).http_status() == 500);
+        REQUIRE(Error(HttpError::ExpectationFailed).http_status() == 417);
+        REQUIRE(Error(HttpError::RequestHeaderFieldsTooLarge).http_status() == 431);
     }
 }
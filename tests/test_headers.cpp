@@ -0,0 +1,131 @@
+#include <catch2/catch_test_macros.hpp>
+#include <coroute/core/headers.hpp>
+#include <coroute/core/request.hpp>
+#include <coroute/core/response.hpp>
+
+#include <string>
+#include <string_view>
+
+using namespace coroute;
+
+TEST_CASE("iequals compares ASCII case-insensitively", "[headers]") {
+    CHECK(iequals("Content-Length", "content-length"));
+    CHECK(iequals("X-A", "x-a"));
+    CHECK(iequals("", ""));
+    CHECK_FALSE(iequals("Host", "Hosts"));
+    CHECK_FALSE(iequals("X-A", "X_A"));
+    // Only ASCII letters fold
+    CHECK_FALSE(iequals("\xc3\xa9", "\xc3\x89"));
+}
+
+TEST_CASE("known_header maps every known name in any case", "[headers]") {
+    for (size_t i = 0; i < static_cast<size_t>(KnownHeader::Count); ++i) {
+        auto header = static_cast<KnownHeader>(i);
+        std::string name(known_header_name(header));
+        REQUIRE_FALSE(name.empty());
+        CHECK(known_header(name) == header);
+
+        for (auto& c : name) {
+            c = static_cast<char>(c >= 'a' && c <= 'z' ? c - 32 : c);
+        }
+        CHECK(known_header(name) == header);
+    }
+    CHECK(known_header("X-Custom") == KnownHeader::Count);
+    CHECK(known_header("Hos") == KnownHeader::Count);
+    CHECK(known_header("Content-Lengthy") == KnownHeader::Count);
+    CHECK(known_header_name(KnownHeader::Count).empty());
+}
+
+TEST_CASE("HeaderMap looks headers up case-insensitively", "[headers]") {
+    BasicHeaderMap<std::string_view> headers;
+    headers.append("host", "example.com");
+    headers.append("X-Trace", "abc");
+    headers.append("CONTENT-LENGTH", "12");
+
+    CHECK(headers.get("Host") == "example.com");
+    CHECK(headers.get(KnownHeader::Host) == "example.com");
+    CHECK(headers.get("x-trace") == "abc");
+    CHECK(headers.get(KnownHeader::ContentLength) == "12");
+    CHECK_FALSE(headers.get("Cookie"));
+    CHECK_FALSE(headers.get(KnownHeader::Cookie));
+    CHECK_FALSE(headers.get("X-Other"));
+
+    // Iteration keeps arrival order and spelling
+    REQUIRE(headers.size() == 3);
+    CHECK(headers[0].first == "host");
+    CHECK(headers[2].first == "CONTENT-LENGTH");
+
+    headers.clear();
+    CHECK(headers.empty());
+    CHECK_FALSE(headers.get(KnownHeader::Host));
+}
+
+TEST_CASE("HeaderMap keeps repeats and returns the last", "[headers]") {
+    BasicHeaderMap<std::string> headers;
+    headers.append("Set-Cookie", "a=1");
+    headers.append("Cookie", "x=1");
+    headers.append("set-cookie", "b=2");
+    headers.append("cookie", "y=2");
+
+    CHECK(headers.size() == 4);
+    CHECK(headers.get("Set-Cookie") == "b=2");
+    CHECK(headers.get(KnownHeader::Cookie) == "y=2");
+
+    SECTION("set replaces the first and drops the rest") {
+        headers.set("COOKIE", "z=3");
+        REQUIRE(headers.size() == 3);
+        CHECK(headers[1].first == "Cookie");
+        CHECK(headers[1].second == "z=3");
+        CHECK(headers.get(KnownHeader::Cookie) == "z=3");
+        CHECK(headers.get("Set-Cookie") == "b=2");
+    }
+
+    SECTION("remove drops every repeat and reindexes the slots") {
+        CHECK(headers.remove("set-cookie"));
+        CHECK_FALSE(headers.remove("Set-Cookie"));
+        REQUIRE(headers.size() == 2);
+        CHECK(headers.get(KnownHeader::Cookie) == "y=2");
+        CHECK(headers.remove("Cookie"));
+        CHECK(headers.empty());
+        CHECK_FALSE(headers.contains(KnownHeader::Cookie));
+    }
+}
+
+TEST_CASE("Request header helpers use the known slots", "[headers]") {
+    Request req;
+    req.set_http_version("HTTP/1.1");
+    req.add_header("connection", "Close");
+    req.add_header("content-type", "text/plain");
+    req.add_header("content-length", "42");
+
+    CHECK_FALSE(req.keep_alive());
+    CHECK(req.content_type() == "text/plain");
+    CHECK(req.content_length() == 42);
+    CHECK(req.header("Content-Type") == "text/plain");
+
+    // add_header replaces regardless of case
+    req.add_header("Connection", "keep-alive");
+    CHECK(req.headers().size() == 3);
+    CHECK(req.keep_alive());
+}
+
+TEST_CASE("Response set_header replaces regardless of case", "[headers]") {
+    auto resp = Response::ok("hello");
+    resp.set_header("content-type", "text/html");
+    resp.add_header("Set-Cookie", "a=1");
+    resp.add_header("Set-Cookie", "b=2");
+
+    CHECK(resp.header(KnownHeader::ContentType) == "text/html");
+    CHECK(resp.header("Content-Length") == "5");
+    size_t content_types = 0;
+    size_t cookies = 0;
+    for (const auto& [key, value] : resp.headers()) {
+        content_types += iequals(key, "Content-Type");
+        cookies += key == "Set-Cookie";
+    }
+    CHECK(content_types == 1);
+    CHECK(cookies == 2);
+
+    auto built = ResponseBuilder().header("content-length", "3").body("abc").build();
+    CHECK(built.headers().size() == 1);
+}
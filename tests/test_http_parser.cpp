@@ -0,0 +1,185 @@
+#include <catch2/catch_test_macros.hpp>
+#include <coroute/core/body_stream.hpp>
+#include <coroute/core/http_parser.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace coroute;
+
+namespace {
+
+const std::vector<http1::Isa> ALL_ISAS = {http1::Isa::Scalar, http1::Isa::SSE42, http1::Isa::AVX2};
+
+// Restores the default kernel when a test ends
+struct IsaGuard {
+    http1::Isa saved = http1::active_isa();
+    ~IsaGuard() { http1::set_isa(saved); }
+};
+
+} // namespace
+
+TEST_CASE("find_head_end locates the blank line", "[http_parser]") {
+    IsaGuard guard;
+    // Long enough that the vector kernels do full-width steps
+    std::string head = "GET / HTTP/1.1\r\nUser-Agent: " + std::string(100, 'a') + "\r\n\r\nbody";
+
+    for (auto isa : ALL_ISAS) {
+        http1::set_isa(isa);
+        CHECK(http1::find_head_end(head) == head.size() - 4);
+        CHECK(http1::find_head_end(head.substr(0, head.size() - 5)) == std::string::npos);
+
+        // Resuming after each byte still finds a terminator split across reads
+        size_t found = std::string::npos;
+        for (size_t size = 1; size <= head.size() && found == std::string::npos; ++size) {
+            found = http1::find_head_end(std::string_view(head).substr(0, size), size - 1);
+        }
+        CHECK(found == head.size() - 4);
+    }
+}
+
+TEST_CASE("parse_head fills the request with views into the buffer", "[http_parser]") {
+    std::string head =
+        "POST /api/items?limit=10&q=a%20b&flag HTTP/1.1\r\n"
+        "Host: example.com\r\n"
+        "Content-Type:application/json \t\r\n"
+        "X-Empty:\r\n"
+        "X-Utf8: caf\xc3\xa9\r\n"
+        "\r\n";
+
+    Request req;
+    REQUIRE(http1::parse_head(head, req));
+
+    CHECK(req.method() == HttpMethod::POST);
+    CHECK(req.path() == "/api/items");
+    CHECK(req.query_string() == "limit=10&q=a%20b&flag");
+    CHECK(req.http_version() == "HTTP/1.1");
+    CHECK(req.headers().size() == 4);
+    CHECK(req.header("Host") == "example.com");
+    CHECK(req.content_type() == "application/json");
+    CHECK(req.header("X-Empty") == "");
+    CHECK(req.header("X-Utf8") == "caf\xc3\xa9");
+    CHECK(req.query_opt<int>("limit") == 10);
+    CHECK(req.query_opt<std::string>("q") == "a b");
+    CHECK(req.query_params().count("flag") == 1);
+
+    // Nothing was copied
+    const char* begin = head.data();
+    const char* end = begin + head.size();
+    CHECK(req.path().data() >= begin);
+    CHECK(req.path().data() < end);
+    CHECK(req.header("Host")->data() > begin);
+    CHECK(req.header("Host")->data() < end);
+}
+
+TEST_CASE("parse_head decodes escaped paths into owned storage", "[http_parser]") {
+    Request req;
+    {
+        std::string head = "GET /files/my%20doc.txt HTTP/1.0\r\n\r\n";
+        REQUIRE(http1::parse_head(head, req));
+    }
+    // The source buffer is gone; the decoded path is owned by the request
+    Request copy = req;
+    req.reset();
+    CHECK(copy.path() == "/files/my doc.txt");
+}
+
+TEST_CASE("parse_head rejects malformed heads", "[http_parser]") {
+    IsaGuard guard;
+    const char* invalid[] = {
+        "G(T / HTTP/1.1\r\n\r\n",                  // Separator in method
+        " GET / HTTP/1.1\r\n\r\n",                 // Empty method
+        "GET  HTTP/1.1\r\n\r\n",                   // Empty target
+        "GET /\r\n\r\n",                           // No version
+        "GET / HTTP/1.1 \r\n\r\n",                 // Trailing space
+        "GET / HTTX/1.1\r\n\r\n",                  // Bad version
+        "GET /a\x01 HTTP/1.1\r\n\r\n",             // Control in target
+        "GET / HTTP/1.1\nHost: x\r\n\r\n",         // Bare LF
+        "GET / HTTP/1.1\r\nHo st: x\r\n\r\n",      // Space in name
+        "GET / HTTP/1.1\r\nHost : x\r\n\r\n",      // Space before colon
+        "GET / HTTP/1.1\r\n: x\r\n\r\n",           // Empty name
+        "GET / HTTP/1.1\r\nNoColon\r\n\r\n",       // Missing colon
+        "GET / HTTP/1.1\r\nA: b\r\n folded\r\n\r\n", // Obsolete line folding
+        "GET / HTTP/1.1\r\nA: b\x7f\r\n\r\n",      // DEL in value
+        "GET / HTTP/1.1\r\nA: b\rc\r\n\r\n",       // Bare CR in value
+    };
+    for (auto isa : ALL_ISAS) {
+        http1::set_isa(isa);
+        for (const char* head : invalid) {
+            Request req;
+            auto result = http1::parse_head(head, req);
+            INFO(head);
+            REQUIRE_FALSE(result);
+            CHECK(result.error().http_status() == 400);
+        }
+    }
+}
+
+TEST_CASE("Repeated framing headers reach the body framing check", "[http_parser]") {
+    // The header map's lookups return the last value, so each repeat must
+    // survive parsing for framing_of() to refuse the message
+    const char* ambiguous[] = {
+        "POST / HTTP/1.1\r\nContent-Length: 5\r\nContent-Length: 6\r\n\r\n",
+        "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\ntransfer-encoding: chunked\r\n\r\n",
+        "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\nContent-Length: 5\r\n\r\n",
+        "POST / HTTP/1.1\r\nContent-Length: 5\r\nTransfer-Encoding: chunked\r\n\r\n",
+    };
+    for (const char* head : ambiguous) {
+        Request req;
+        REQUIRE(http1::parse_head(head, req));
+        auto framing = BodyStream::framing_of(req.headers());
+        INFO(head);
+        REQUIRE_FALSE(framing);
+        CHECK(framing.error().http_status() == 400);
+    }
+
+    // The same length twice is one length
+    Request req;
+    REQUIRE(http1::parse_head("POST / HTTP/1.1\r\nContent-Length: 5\r\nContent-Length: 5\r\n\r\n", req));
+    auto framing = BodyStream::framing_of(req.headers());
+    REQUIRE(framing);
+    CHECK(framing->framing == BodyStream::Framing::ContentLength);
+    CHECK(framing->content_length == 5u);
+}
+
+TEST_CASE("Every kernel validates long fields the same way", "[http_parser]") {
+    IsaGuard guard;
+    std::string name(70, 'x');
+    std::string value(90, 'v');
+
+    // Place one byte at every offset of a long name and value, so each
+    // position of the 16/32-byte steps and the scalar tail is covered
+    const unsigned char probes[] = {'!', '~', '|', '{', '"', '@', '\t', 0x7f, 0x80, 0x00, '\n'};
+    for (unsigned char c : probes) {
+        for (size_t pos = 0; pos < 90; ++pos) {
+            std::string n = name;
+            std::string v = value;
+            if (pos < n.size()) {
+                n[pos] = static_cast<char>(c);
+            }
+            v[pos] = static_cast<char>(c);
+            std::string head = "GET / HTTP/1.1\r\n" + n + ": " + v + "\r\n\r\n";
+
+            std::vector<bool> accepted;
+            for (auto isa : ALL_ISAS) {
+                http1::set_isa(isa);
+                Request req;
+                accepted.push_back(static_cast<bool>(http1::parse_head(head, req)));
+            }
+            INFO("byte " << int(c) << " at " << pos);
+            CHECK(accepted[0] == accepted[1]);
+            CHECK(accepted[0] == accepted[2]);
+        }
+    }
+}
+
+TEST_CASE("set_isa never selects an unsupported kernel", "[http_parser]") {
+    IsaGuard guard;
+    for (auto isa : ALL_ISAS) {
+        auto chosen = http1::set_isa(isa);
+        CHECK(static_cast<int>(chosen) <= static_cast<int>(isa));
+        CHECK(http1::active_isa() == chosen);
+    }
+    CHECK(http1::set_isa(http1::Isa::Scalar) == http1::Isa::Scalar);
+    CHECK(http1::isa_name(http1::Isa::AVX2) == "avx2");
+}
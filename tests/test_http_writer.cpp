@@ -0,0 +1,162 @@
+#include <catch2/catch_test_macros.hpp>
+#include <coroute/core/http_writer.hpp>
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace coroute;
+
+// Count heap allocations made on this thread, to check the serializer
+// makes none
+namespace {
+thread_local size_t g_allocations = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++g_allocations;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    ++g_allocations;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+std::string write(const Response& resp, const http1::HeadOptions& options = {}) {
+    std::string out(http1::head_size(resp, options), '\0');
+    char* end = http1::write_head(out.data(), resp, options);
+    CHECK(end == out.data() + out.size());
+
+    // append_head produces the same bytes after what is already there
+    std::vector<char> appended = {'x'};
+    http1::append_head(appended, resp, options);
+    CHECK(std::string(appended.begin() + 1, appended.end()) == out);
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("status_line is precomputed for every status", "[http_writer]") {
+    CHECK(http1::status_line(200) == "HTTP/1.1 200 OK\r\n");
+    CHECK(http1::status_line(404) == "HTTP/1.1 404 Not Found\r\n");
+    CHECK(http1::status_line(503) == "HTTP/1.1 503 Service Unavailable\r\n");
+    CHECK(http1::status_line(299) == "HTTP/1.1 299 Unknown\r\n");
+    CHECK(http1::status_line(99).empty());
+    CHECK(http1::status_line(600).empty());
+}
+
+TEST_CASE("write_head matches the headers and options", "[http_writer]") {
+    auto resp = Response::ok("Hello, World!");
+    resp.add_header("Set-Cookie", "a=1");
+
+    CHECK(write(resp) ==
+          "HTTP/1.1 200 OK\r\n"
+          "Content-Type: text/plain\r\n"
+          "Content-Length: 13\r\n"
+          "Set-Cookie: a=1\r\n"
+          "\r\n");
+    CHECK(resp.serialize() == write(resp) + "Hello, World!");
+    CHECK(resp.serialize_headers() == write(resp));
+
+    http1::HeadOptions keep_alive;
+    keep_alive.connection = http1::HeadOptions::Connection::KeepAlive;
+    keep_alive.keep_alive = "timeout=5";
+    keep_alive.max_requests = 99;
+    CHECK(write(resp, keep_alive).ends_with(
+          "Connection: keep-alive\r\nKeep-Alive: timeout=5, max=99\r\n\r\n"));
+
+    keep_alive.max_requests = 0;
+    CHECK(write(resp, keep_alive).ends_with(
+          "Connection: keep-alive\r\nKeep-Alive: timeout=5\r\n\r\n"));
+
+    http1::HeadOptions close;
+    close.connection = http1::HeadOptions::Connection::Close;
+    CHECK(write(resp, close).ends_with("Set-Cookie: a=1\r\nConnection: close\r\n\r\n"));
+
+    Response custom;
+    custom.set_status(799);
+    CHECK(write(custom) == "HTTP/1.1 799 Unknown\r\n\r\n");
+}
+
+TEST_CASE("date_header is an IMF-fixdate", "[http_writer]") {
+    auto date = http1::date_header();
+    REQUIRE(date.size() == 37);
+    CHECK(date.starts_with("Date: "));
+    CHECK(date.ends_with(" GMT\r\n"));
+    CHECK(date[9] == ',');
+    CHECK(date[25] == ':');
+    CHECK(date[28] == ':');
+
+    // Added unless the response has its own
+    http1::HeadOptions options;
+    options.date = true;
+    auto resp = Response::ok("x");
+    CHECK(write(resp, options).find("\r\nDate: ") != std::string::npos);
+    resp.set_header("Date", "Thu, 01 Jan 1970 00:00:00 GMT");
+    auto head = write(resp, options);
+    CHECK(head.find("Date: ") == head.rfind("Date: "));
+}
+
+TEST_CASE("Serializing a plaintext response does not allocate", "[http_writer]") {
+    auto resp = Response::ok("Hello, World!");
+    http1::HeadOptions options;
+    options.connection = http1::HeadOptions::Connection::KeepAlive;
+    options.keep_alive = "timeout=30";
+    options.max_requests = 100;
+    options.date = true;
+
+    // Pooled buffers arrive with capacity reserved
+    std::vector<char> out;
+    out.reserve(4096);
+    http1::status_line(200);  // Build the table outside the measured section
+    http1::date_header();
+
+    size_t before = g_allocations;
+    for (int i = 0; i < 100; ++i) {
+        out.resize(http1::head_size(resp, options));
+        http1::write_head(out.data(), resp, options);
+        out.clear();
+        http1::append_head(out, resp, options);
+        out.clear();
+    }
+    CHECK(g_allocations == before);
+}
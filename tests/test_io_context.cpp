@@ -0,0 +1,151 @@
+#include <catch2/catch_test_macros.hpp>
+#include <coroute/net/io_context.hpp>
+#include <coroute/coro/task.hpp>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace coroute;
+using namespace coroute::net;
+
+namespace {
+
+int connect_client(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    timeval tv{5, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+} // namespace
+
+TEST_CASE("Listener spreads accepted connections over every ring", "[io_context]") {
+    constexpr size_t RINGS = 4;
+    constexpr size_t CLIENTS = 16;
+
+    auto ctx = IoContext::create(RINGS);
+    auto listener = Listener::create(*ctx);
+    REQUIRE(listener->listen(Endpoint::ipv4("127.0.0.1", 0)));
+
+    std::mutex mutex;
+    std::set<std::thread::id> serving_threads;
+
+    // Echo one byte, noting which worker thread did the I/O, then hold the
+    // connection until the client hangs up
+    auto serve = [&](std::unique_ptr<Connection> conn) -> Task<void> {
+        char byte;
+        auto got = co_await conn->async_read(&byte, 1);
+        if (got && *got == 1) {
+            {
+                std::lock_guard lock(mutex);
+                serving_threads.insert(std::this_thread::get_id());
+            }
+            co_await conn->async_write_all(&byte, 1);
+            co_await conn->async_read(&byte, 1);
+        }
+        conn->close();
+    };
+
+    auto accept_loop = [&]() -> Task<void> {
+        for (size_t i = 0; i < CLIENTS; ++i) {
+            auto conn = co_await listener->async_accept();
+            if (!conn) {
+                co_return;
+            }
+            serve(std::move(*conn)).start_detached();
+        }
+    };
+    accept_loop().start_detached();
+
+    std::thread runner([&] { ctx->run(); });
+
+    std::vector<int> clients;
+    for (size_t i = 0; i < CLIENTS; ++i) {
+        int fd = connect_client(listener->local_port());
+        REQUIRE(fd >= 0);
+        clients.push_back(fd);
+        char byte = static_cast<char>('a' + i);
+        REQUIRE(::write(fd, &byte, 1) == 1);
+        char echo = 0;
+        REQUIRE(::read(fd, &echo, 1) == 1);
+        CHECK(echo == byte);
+    }
+
+    // Every connection is still open, so least-loaded placement is exact
+    auto stats = ctx->ring_stats();
+    REQUIRE(stats.size() == RINGS);
+    for (const auto& ring : stats) {
+        CHECK(ring.connections == CLIENTS / RINGS);
+    }
+    {
+        std::lock_guard lock(mutex);
+        CHECK(serving_threads.size() == RINGS);
+    }
+
+    for (int fd : clients) {
+        ::close(fd);
+    }
+    ctx->stop();
+    runner.join();
+}
+
+TEST_CASE("Closing multi-accept refuses new clients and keeps accepted ones", "[io_context]") {
+    auto ctx = IoContext::create(2);
+
+    // Echo bytes until the client hangs up
+    auto serve = [](std::unique_ptr<Connection> conn) -> Task<void> {
+        char byte;
+        while (true) {
+            auto got = co_await conn->async_read(&byte, 1);
+            if (!got || *got == 0) {
+                break;
+            }
+            co_await conn->async_write_all(&byte, 1);
+        }
+        conn->close();
+    };
+    REQUIRE(ctx->enable_multi_accept(Endpoint::ipv4("127.0.0.1", 0),
+                                     [&](std::unique_ptr<Connection> conn) {
+                                         serve(std::move(conn)).start_detached();
+                                     }));
+    uint16_t port = ctx->multi_accept_endpoint().port();
+
+    std::thread runner([&] { ctx->run(); });
+
+    auto echo = [](int fd, char byte) {
+        char back = 0;
+        return ::write(fd, &byte, 1) == 1 && ::read(fd, &back, 1) == 1 && back == byte;
+    };
+
+    int before = connect_client(port);
+    REQUIRE(before >= 0);
+    CHECK(echo(before, 'a'));
+
+    ctx->close_multi_accept();
+    ctx->close_multi_accept();  // Idempotent
+
+    CHECK(connect_client(port) < 0);
+    CHECK(echo(before, 'b'));
+
+    ::close(before);
+    ctx->stop();
+    runner.join();
+}
@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+#include <coroute/util/mpsc_queue.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace coroute;
+
+namespace {
+
+struct Item : MpscNode {
+    int producer = 0;
+    int sequence = 0;
+};
+
+} // namespace
+
+TEST_CASE("MpscQueue single-threaded FIFO", "[mpsc]") {
+    MpscQueue<Item> queue;
+    Item items[3];
+
+    CHECK(queue.empty());
+    CHECK(queue.pop() == nullptr);
+
+    for (int i = 0; i < 3; ++i) {
+        items[i].sequence = i;
+        queue.push(items[i]);
+    }
+    CHECK_FALSE(queue.empty());
+
+    for (int i = 0; i < 3; ++i) {
+        Item* item = queue.pop();
+        REQUIRE(item != nullptr);
+        CHECK(item->sequence == i);
+    }
+    CHECK(queue.pop() == nullptr);
+    CHECK(queue.empty());
+
+    SECTION("Nodes can be re-queued after being popped") {
+        queue.push(items[1]);
+        CHECK(queue.pop() == &items[1]);
+        CHECK(queue.pop() == nullptr);
+    }
+}
+
+TEST_CASE("MpscQueue multiple producers", "[mpsc]") {
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 20000;
+
+    MpscQueue<Item> queue;
+    std::vector<std::unique_ptr<Item[]>> items;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        items.push_back(std::make_unique<Item[]>(PER_PRODUCER));
+    }
+    std::atomic<int> started{0};
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p] {
+            started.fetch_add(1);
+            while (started.load() < PRODUCERS) {}
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                items[p][i].producer = p;
+                items[p][i].sequence = i;
+                queue.push(items[p][i]);
+            }
+        });
+    }
+
+    // Each producer's items must arrive complete and in order
+    std::vector<int> next_expected(PRODUCERS, 0);
+    int received = 0;
+    bool ordered = true;
+    while (received < PRODUCERS * PER_PRODUCER) {
+        Item* item = queue.pop();
+        if (!item) {
+            continue;
+        }
+        if (item->sequence != next_expected[item->producer]) {
+            ordered = false;
+        }
+        next_expected[item->producer] = item->sequence + 1;
+        ++received;
+    }
+
+    for (auto& t : producers) {
+        t.join();
+    }
+
+    CHECK(ordered);
+    CHECK(queue.pop() == nullptr);
+    for (int p = 0; p < PRODUCERS; ++p) {
+        CHECK(next_expected[p] == PER_PRODUCER);
+    }
+}
@@ -41,6 +41,12 @@ TEST_CASE("Response factory methods", "[response]") {
         REQUIRE(resp.status() == 500);
     }
     
+    SECTION("service_unavailable") {
+        auto resp = Response::service_unavailable();
+        REQUIRE(resp.status() == 503);
+        REQUIRE(resp.status_text() == "Service Unavailable");
+    }
+    
     SECTION("redirect") {
         auto resp = Response::redirect("/new-location");
         REQUIRE(resp.status() == 302);
@@ -0,0 +1,151 @@
+#include <catch2/catch_test_macros.hpp>
+#include <coroute/util/timer_wheel.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace coroute;
+
+namespace {
+
+struct Recorder {
+    TimerWheel* wheel = nullptr;
+    std::vector<uint64_t> fired_at;
+    std::vector<TimerEntry> entries;
+
+    Recorder(TimerWheel& w, size_t count) : wheel(&w), fired_at(count, 0), entries(count) {
+        for (auto& e : entries) {
+            e.user_data = this;
+            e.on_expire = [](TimerEntry& entry) {
+                auto* self = static_cast<Recorder*>(entry.user_data);
+                self->fired_at[&entry - self->entries.data()] = self->wheel->now();
+            };
+        }
+    }
+};
+
+} // namespace
+
+TEST_CASE("TimerWheel fires entries at their deadline", "[timer]") {
+    TimerWheel wheel;
+    Recorder rec(wheel, 4);
+
+    wheel.schedule(rec.entries[0], 5);
+    wheel.schedule(rec.entries[1], 300);       // level 1
+    wheel.schedule(rec.entries[2], 70000);     // level 2
+    wheel.schedule(rec.entries[3], 20000000);  // level 3
+    CHECK(wheel.size() == 4);
+
+    SECTION("Nothing fires early") {
+        CHECK(wheel.advance(4) == 0);
+        CHECK(rec.fired_at[0] == 0);
+    }
+
+    SECTION("Each entry fires exactly at its tick") {
+        while (!wheel.empty()) {
+            auto next = wheel.next_expiry();
+            REQUIRE(next);
+            REQUIRE(*next > wheel.now());
+            wheel.advance(*next);
+        }
+        CHECK(rec.fired_at[0] == 5);
+        CHECK(rec.fired_at[1] == 300);
+        CHECK(rec.fired_at[2] == 70000);
+        CHECK(rec.fired_at[3] == 20000000);
+    }
+
+    SECTION("Large advance fires everything due") {
+        CHECK(wheel.advance(100000) == 3);
+        CHECK(rec.fired_at[2] == 70000);
+        CHECK(wheel.size() == 1);
+    }
+}
+
+TEST_CASE("TimerWheel cancel", "[timer]") {
+    TimerWheel wheel;
+    Recorder rec(wheel, 2);
+
+    wheel.schedule(rec.entries[0], 10);
+    wheel.schedule(rec.entries[1], 10);
+    wheel.cancel(rec.entries[0]);
+
+    CHECK_FALSE(rec.entries[0].armed());
+    CHECK(wheel.size() == 1);
+    CHECK(wheel.advance(20) == 1);
+    CHECK(rec.fired_at[0] == 0);
+    CHECK(rec.fired_at[1] == 10);
+}
+
+TEST_CASE("TimerWheel past deadlines fire on next tick", "[timer]") {
+    TimerWheel wheel(100);
+    Recorder rec(wheel, 1);
+
+    wheel.schedule(rec.entries[0], 50);
+    CHECK(wheel.next_expiry() == 101);
+    wheel.advance(101);
+    CHECK(rec.fired_at[0] == 101);
+}
+
+TEST_CASE("TimerWheel rescheduling moves an entry", "[timer]") {
+    TimerWheel wheel;
+    Recorder rec(wheel, 1);
+
+    wheel.schedule(rec.entries[0], 1000);
+    wheel.schedule(rec.entries[0], 20);
+    CHECK(wheel.size() == 1);
+    wheel.advance(2000);
+    CHECK(rec.fired_at[0] == 20);
+}
+
+TEST_CASE("TimerWheel destroyed entries unlink themselves", "[timer]") {
+    TimerWheel wheel;
+    TimerEntry kept;
+    wheel.schedule(kept, 5);
+    {
+        TimerEntry entry;
+        wheel.schedule(entry, 10);
+        CHECK(wheel.size() == 2);
+    }
+    CHECK(wheel.size() == 1);
+    {
+        TimerEntry far;
+        wheel.schedule(far, 100000);
+    }
+    CHECK(wheel.size() == 1);
+    wheel.cancel(kept);
+    CHECK(wheel.empty());
+    CHECK_FALSE(wheel.next_expiry());
+
+    // With nothing armed, advance() jumps straight to the target
+    CHECK(wheel.advance(1000000) == 0);
+    CHECK(wheel.now() == 1000000);
+}
+
+TEST_CASE("TimerWheel randomized deadlines", "[timer]") {
+    TimerWheel wheel;
+    constexpr size_t N = 20000;
+    Recorder rec(wheel, N);
+    std::mt19937_64 rng(42);
+
+    for (size_t i = 0; i < N; ++i) {
+        uint64_t range = (i % 3 == 0) ? 300 : (i % 3 == 1) ? 70000 : 5000000;
+        wheel.schedule(rec.entries[i], 1 + rng() % range);
+    }
+    for (size_t i = 0; i < N; i += 5) {
+        wheel.cancel(rec.entries[i]);
+    }
+
+    while (!wheel.empty()) {
+        auto next = wheel.next_expiry();
+        REQUIRE(next);
+        wheel.advance(*next);
+    }
+
+    for (size_t i = 0; i < N; ++i) {
+        if (i % 5 == 0) {
+            CHECK(rec.fired_at[i] == 0);
+        } else {
+            CHECK(rec.fired_at[i] == rec.entries[i].expiry());
+        }
+    }
+}
@@ -0,0 +1,334 @@
+#include <catch2/catch_test_macros.hpp>
+#include <coroute/net/tls.hpp>
+
+#ifndef _WIN32
+#include <coroute/core/app.hpp>
+#include <coroute/net/endpoint.hpp>
+
+#include <openssl/ssl.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <thread>
+#endif
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+using namespace coroute;
+using namespace coroute::net;
+
+namespace {
+
+std::filesystem::path temp_path(const std::string& name) {
+    return std::filesystem::temp_directory_path() / ("coroute_test_" + name);
+}
+
+} // namespace
+
+TEST_CASE("StripedMemorySessionCache stores, loads and removes sessions", "[tls]") {
+    StripedMemorySessionCache cache(64, 4);
+
+    cache.store("id-1", "session-1");
+    cache.store("id-2", "session-2");
+    CHECK(cache.size() == 2);
+    CHECK(cache.load("id-1") == "session-1");
+    CHECK(cache.load("id-2") == "session-2");
+    CHECK_FALSE(cache.load("id-3"));
+
+    // Storing an existing ID replaces it
+    cache.store("id-1", "session-1b");
+    CHECK(cache.size() == 2);
+    CHECK(cache.load("id-1") == "session-1b");
+
+    cache.remove("id-1");
+    CHECK_FALSE(cache.load("id-1"));
+    CHECK(cache.size() == 1);
+}
+
+TEST_CASE("StripedMemorySessionCache evicts the oldest entry of a full stripe", "[tls]") {
+    StripedMemorySessionCache cache(2, 1);
+
+    cache.store("a", "1");
+    cache.store("b", "2");
+    cache.store("c", "3");
+    CHECK(cache.size() == 2);
+    CHECK_FALSE(cache.load("a"));
+    CHECK(cache.load("b") == "2");
+    CHECK(cache.load("c") == "3");
+}
+
+TEST_CASE("StripedMemorySessionCache drops expired sessions", "[tls]") {
+    StripedMemorySessionCache cache(16, 2, std::chrono::seconds(0));
+
+    cache.store("id", "session");
+    CHECK_FALSE(cache.load("id"));
+    CHECK(cache.size() == 0);
+}
+
+TEST_CASE("TicketKey files round-trip in both sizes", "[tls]") {
+    auto path = temp_path("ticket.key");
+
+    SECTION("80-byte AES-256 key") {
+        auto key = TicketKey::generate();
+        CHECK(key.hmac_secret.size() == 32);
+        CHECK(key.aes_key.size() == 32);
+        REQUIRE(key.save(path));
+        CHECK(std::filesystem::file_size(path) == 80);
+
+        auto loaded = TicketKey::load(path);
+        REQUIRE(loaded);
+        CHECK(loaded->name == key.name);
+        CHECK(loaded->hmac_secret == key.hmac_secret);
+        CHECK(loaded->aes_key == key.aes_key);
+    }
+
+    SECTION("48-byte AES-128 key") {
+        std::string bytes(48, '\0');
+        for (size_t i = 0; i < bytes.size(); ++i) {
+            bytes[i] = static_cast<char>(i);
+        }
+        std::ofstream(path, std::ios::binary) << bytes;
+
+        auto loaded = TicketKey::load(path);
+        REQUIRE(loaded);
+        CHECK(loaded->name[0] == 0);
+        CHECK(loaded->hmac_secret.size() == 16);
+        CHECK(loaded->hmac_secret[0] == 16);
+        CHECK(loaded->aes_key.size() == 16);
+        CHECK(loaded->aes_key[0] == 32);
+    }
+
+    SECTION("other sizes are rejected") {
+        std::ofstream(path, std::ios::binary) << std::string(32, 'x');
+        CHECK_FALSE(TicketKey::load(path));
+    }
+
+    std::filesystem::remove(path);
+}
+
+#ifndef _WIN32
+namespace {
+
+// Write a throwaway self-signed P-256 certificate and key
+bool write_self_signed(const std::filesystem::path& cert_path,
+                       const std::filesystem::path& key_path) {
+    EVP_PKEY* key = nullptr;
+    EVP_PKEY_CTX* kctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+    if (!kctx || EVP_PKEY_keygen_init(kctx) <= 0 ||
+        EVP_PKEY_CTX_set_ec_paramgen_curve_nid(kctx, NID_X9_62_prime256v1) <= 0 ||
+        EVP_PKEY_keygen(kctx, &key) <= 0) {
+        EVP_PKEY_CTX_free(kctx);
+        return false;
+    }
+    EVP_PKEY_CTX_free(kctx);
+    X509* cert = X509_new();
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+    X509_set_pubkey(cert, key);
+    X509_NAME* name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                               reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    bool ok = X509_sign(cert, key, EVP_sha256()) > 0;
+
+    FILE* f = ok ? std::fopen(cert_path.c_str(), "w") : nullptr;
+    ok = f && PEM_write_X509(f, cert) == 1;
+    if (f) {
+        std::fclose(f);
+    }
+    f = ok ? std::fopen(key_path.c_str(), "w") : nullptr;
+    ok = f && PEM_write_PrivateKey(f, key, nullptr, nullptr, 0, nullptr, nullptr) == 1;
+    if (f) {
+        std::fclose(f);
+    }
+
+    X509_free(cert);
+    EVP_PKEY_free(key);
+    return ok;
+}
+
+uint16_t free_port() {
+    auto fd = net::detail::open_listen_socket(Endpoint::ipv4("127.0.0.1", 0), 1);
+    if (!fd) {
+        return 0;
+    }
+    uint16_t port = net::detail::local_endpoint(*fd).port();
+    ::close(*fd);
+    return port;
+}
+
+int connect_client(uint16_t port) {
+    // The server thread may not be listening yet
+    for (int attempt = 0; attempt < 200; ++attempt) {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+            return fd;
+        }
+        ::close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return -1;
+}
+
+// One GET over TLS, offering `session` for resumption. Returns the session
+// to resume next time (owned by the caller) and whether this one resumed.
+SSL_SESSION* fetch(SSL_CTX* client_ctx, uint16_t port, SSL_SESSION* session, bool& reused) {
+    reused = false;
+    int fd = connect_client(port);
+    if (fd < 0) {
+        return nullptr;
+    }
+    SSL* ssl = SSL_new(client_ctx);
+    SSL_set_fd(ssl, fd);
+    if (session) {
+        SSL_set_session(ssl, session);
+    }
+
+    SSL_SESSION* next = nullptr;
+    const char request[] = "GET / HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n";
+    char response[512];
+    if (SSL_connect(ssl) == 1 && SSL_write(ssl, request, sizeof(request) - 1) > 0 &&
+        SSL_read(ssl, response, sizeof(response)) > 0) {
+        // TLS 1.3 tickets arrive after the handshake, so take the session
+        // once the response has been read
+        reused = SSL_session_reused(ssl) == 1;
+        next = SSL_get1_session(ssl);
+    }
+    // A clean close_notify keeps the session resumable
+    SSL_shutdown(ssl);
+    SSL_free(ssl);
+    ::close(fd);
+    return next;
+}
+
+// Runs an App over TLS on a fresh port until destroyed
+struct TlsServer {
+    App app;
+    uint16_t port = free_port();
+    std::thread thread;
+
+    explicit TlsServer(const AppTlsConfig& config) {
+        app.enable_tls(config);
+        app.get("/", [](Request&) -> Task<Response> { co_return Response::ok("ok"); });
+        thread = std::thread([this] { app.run(Endpoint::ipv4("127.0.0.1", port)); });
+    }
+
+    ~TlsServer() {
+        app.stop();
+        thread.join();
+    }
+};
+
+} // namespace
+
+TEST_CASE("TLS sessions resume on another App instance", "[tls]") {
+    auto cert = temp_path("cert.pem");
+    auto key = temp_path("key.pem");
+    auto ticket_key = temp_path("ticket.key");
+    REQUIRE(write_self_signed(cert, key));
+    REQUIRE(TicketKey::generate().save(ticket_key));
+
+    AppTlsConfig config;
+    config.cert_file = cert;
+    config.key_file = key;
+    config.alpn_protocols = {"http/1.1"};
+    SSL_CTX* client_ctx = SSL_CTX_new(TLS_client_method());
+
+    SECTION("shared ticket key file") {
+        config.ticket_key_files = {ticket_key};
+        auto first = std::make_unique<TlsServer>(config);
+        TlsServer second(config);
+
+        bool reused = false;
+        SSL_SESSION* session = fetch(client_ctx, first->port, nullptr, reused);
+        REQUIRE(session);
+        CHECK_FALSE(reused);
+        first.reset();  // The issuing instance is gone, as after a restart
+
+        SSL_SESSION* again = fetch(client_ctx, second.port, session, reused);
+        CHECK(reused);
+        CHECK(second.app.tls_stats().resumed == 1);
+        CHECK(second.app.tls_stats().resumption_rate() == 1.0);
+        SSL_SESSION_free(again);
+        SSL_SESSION_free(session);
+    }
+
+    SECTION("without a shared key, tickets do not carry over") {
+        TlsServer first(config);
+        TlsServer second(config);
+
+        bool reused = false;
+        SSL_SESSION* session = fetch(client_ctx, first.port, nullptr, reused);
+        REQUIRE(session);
+        SSL_SESSION* again = fetch(client_ctx, second.port, session, reused);
+        CHECK_FALSE(reused);
+        CHECK(second.app.tls_stats().handshakes == 1);
+        CHECK(second.app.tls_stats().resumed == 0);
+        SSL_SESSION_free(again);
+        SSL_SESSION_free(session);
+    }
+
+    SECTION("a differently configured server does not resume") {
+        auto other_cert = temp_path("other_cert.pem");
+        auto other_key = temp_path("other_key.pem");
+        REQUIRE(write_self_signed(other_cert, other_key));
+
+        config.ticket_key_files = {ticket_key};
+        TlsServer first(config);
+        AppTlsConfig other = config;
+        other.cert_file = other_cert;
+        other.key_file = other_key;
+        TlsServer second(other);
+
+        bool reused = false;
+        SSL_SESSION* session = fetch(client_ctx, first.port, nullptr, reused);
+        REQUIRE(session);
+        SSL_SESSION* again = fetch(client_ctx, second.port, session, reused);
+        CHECK_FALSE(reused);
+        CHECK(second.app.tls_stats().resumed == 0);
+        SSL_SESSION_free(again);
+        SSL_SESSION_free(session);
+        std::filesystem::remove(other_cert);
+        std::filesystem::remove(other_key);
+    }
+
+    SECTION("shared session cache") {
+        config.session_tickets = false;
+        config.session_cache = std::make_shared<StripedMemorySessionCache>();
+        TlsServer first(config);
+        TlsServer second(config);
+
+        bool reused = false;
+        SSL_SESSION* session = fetch(client_ctx, first.port, nullptr, reused);
+        REQUIRE(session);
+        CHECK_FALSE(reused);
+
+        SSL_SESSION* again = fetch(client_ctx, second.port, session, reused);
+        CHECK(reused);
+        CHECK(second.app.tls_stats().cache_hits == 1);
+        SSL_SESSION_free(again);
+        SSL_SESSION_free(session);
+    }
+
+    SSL_CTX_free(client_ctx);
+    std::filesystem::remove(cert);
+    std::filesystem::remove(key);
+    std::filesystem::remove(ticket_key);
+}
+#endif